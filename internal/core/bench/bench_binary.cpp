@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+#include <faiss/FaissHook.h>
+#include "query/SearchBruteForce.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+static constexpr int64_t N = 256 * 1024;
+static constexpr int64_t num_queries = 10;
+static constexpr int64_t topk = 10;
+
+static std::vector<uint8_t>
+GenCodes(int64_t count, int64_t dim, int seed) {
+    std::default_random_engine e(seed);
+    std::vector<uint8_t> codes(count * dim / 8);
+    for (auto& code : codes) {
+        // sparse like chemical fingerprints
+        code = e() & e() & e();
+    }
+    return codes;
+}
+
+static void
+BinarySearch(benchmark::State& state, MetricType metric_type) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+
+    auto dim = state.range(0);
+    auto base = GenCodes(N, dim, 42);
+    auto queries = GenCodes(num_queries, dim, 43);
+    dataset::QueryDataset query_dataset{metric_type, num_queries, topk, dim, queries.data()};
+    for (auto _ : state) {
+        auto result = BinarySearchBruteForce(query_dataset, base.data(), N, nullptr);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * N * num_queries);
+    state.SetLabel(cpu_flag);
+}
+
+static void
+Binary_Hamming(benchmark::State& state) {
+    BinarySearch(state, MetricType::METRIC_Hamming);
+}
+BENCHMARK(Binary_Hamming)->RangeMultiplier(2)->Range(512, 2048);
+
+static void
+Binary_Jaccard(benchmark::State& state) {
+    BinarySearch(state, MetricType::METRIC_Jaccard);
+}
+BENCHMARK(Binary_Jaccard)->RangeMultiplier(2)->Range(512, 2048);
+
+static void
+Binary_Tanimoto(benchmark::State& state) {
+    BinarySearch(state, MetricType::METRIC_Tanimoto);
+}
+BENCHMARK(Binary_Tanimoto)->RangeMultiplier(2)->Range(512, 2048);
+
+static void
+Binary_Substructure(benchmark::State& state) {
+    BinarySearch(state, MetricType::METRIC_Substructure);
+}
+BENCHMARK(Binary_Substructure)->RangeMultiplier(2)->Range(512, 2048);
+
+static void
+Binary_Superstructure(benchmark::State& state) {
+    BinarySearch(state, MetricType::METRIC_Superstructure);
+}
+BENCHMARK(Binary_Superstructure)->RangeMultiplier(2)->Range(512, 2048);
@@ -0,0 +1,67 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include "segcore/ConcurrentVector.h"
+
+using namespace milvus::segcore;
+
+// N reader threads doing random point reads while one thread keeps inserting
+static void
+ConcurrentVector_ReadWhileInsert(benchmark::State& state) {
+    auto num_readers = state.range(0);
+    constexpr int64_t size_per_chunk = 1024;
+    constexpr int64_t batch_size = 1000;
+    constexpr int64_t reads_per_reader = 1000000;
+    std::vector<int64_t> batch(batch_size);
+    std::iota(batch.begin(), batch.end(), 0);
+
+    for (auto _ : state) {
+        ConcurrentVector<int64_t> vec(size_per_chunk);
+        vec.set_data(0, batch.data(), batch_size);
+        std::atomic<int64_t> inserted = batch_size;
+        std::atomic<bool> stop = false;
+
+        std::thread writer([&] {
+            while (!stop) {
+                auto offset = inserted.load();
+                vec.set_data(offset, batch.data(), batch_size);
+                inserted.store(offset + batch_size);
+            }
+        });
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < num_readers; ++i) {
+            readers.emplace_back([&, i] {
+                std::default_random_engine e(42 + i);
+                int64_t sum = 0;
+                for (int64_t n = 0; n < reads_per_reader; ++n) {
+                    sum += vec[e() % inserted.load(std::memory_order_relaxed)];
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        stop = true;
+        writer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * num_readers * reads_per_reader);
+}
+
+BENCHMARK(ConcurrentVector_ReadWhileInsert)->UseRealTime()->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
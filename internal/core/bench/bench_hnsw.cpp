@@ -0,0 +1,139 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+using namespace milvus;
+
+static constexpr int64_t N = 100 * 1000;
+static constexpr int64_t dim = 128;
+static constexpr int64_t num_queries = 100;
+static constexpr int64_t topk = 10;
+
+static std::vector<float>
+GenVectors(int64_t count, int seed) {
+    std::default_random_engine e(seed);
+    std::normal_distribution<float> dist;
+    std::vector<float> vectors(count * dim);
+    for (auto& x : vectors) {
+        x = dist(e);
+    }
+    return vectors;
+}
+
+const auto base = GenVectors(N, 42);
+const auto queries = GenVectors(num_queries, 43);
+
+const auto conf = knowhere::Config{
+    {knowhere::meta::DIM, dim},          {knowhere::meta::TOPK, topk},
+    {knowhere::IndexParams::M, 16},      {knowhere::IndexParams::efConstruction, 200},
+    {knowhere::IndexParams::ef, 64},     {knowhere::Metric::TYPE, knowhere::Metric::L2},
+};
+
+const auto hnsw = [] {
+    auto index = std::make_shared<knowhere::IndexHNSW>();
+    auto dataset = knowhere::GenDataset(N, dim, base.data());
+    index->Train(dataset, conf);
+    index->AddWithoutIds(dataset, conf);
+    return index;
+}();
+
+// exact top k of every query over the rows that pass the bitset
+static std::vector<std::unordered_set<int64_t>>
+GroundTruth(const faiss::BitsetView bitset) {
+    std::vector<std::unordered_set<int64_t>> truth(num_queries);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::vector<std::pair<float, int64_t>> dists;
+        for (int64_t row = 0; row < N; ++row) {
+            if (bitset.test(row)) {
+                continue;
+            }
+            float dist = 0;
+            for (int64_t d = 0; d < dim; ++d) {
+                auto diff = queries[q * dim + d] - base[row * dim + d];
+                dist += diff * diff;
+            }
+            dists.emplace_back(dist, row);
+        }
+        auto count = std::min<int64_t>(topk, dists.size());
+        std::partial_sort(dists.begin(), dists.begin() + count, dists.end());
+        for (int64_t i = 0; i < count; ++i) {
+            truth[q].insert(dists[i].second);
+        }
+    }
+    return truth;
+}
+
+// filtered HNSW search, the argument is the pass rate in per mille
+static void
+HNSW_FilteredSearch(benchmark::State& state) {
+    auto pass_per_mille = state.range(0);
+    auto survivors = N * pass_per_mille / 1000;
+    faiss::ConcurrentBitset bitset(N);
+    std::vector<int64_t> rows(N);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::shuffle(rows.begin(), rows.end(), std::default_random_engine(44));
+    for (auto i = survivors; i < N; ++i) {
+        bitset.set(rows[i]);
+    }
+    auto truth = GroundTruth(faiss::BitsetView(bitset));
+    auto query_dataset = knowhere::GenDataset(num_queries, dim, queries.data());
+
+    int64_t hits = 0;
+    int64_t expected = 0;
+    for (auto _ : state) {
+        auto result = hnsw->Query(query_dataset, conf, faiss::BitsetView(bitset));
+        auto ids = result->Get<int64_t*>(knowhere::meta::IDS);
+        for (int64_t q = 0; q < num_queries; ++q) {
+            for (int64_t j = 0; j < topk; ++j) {
+                hits += truth[q].count(ids[q * topk + j]);
+            }
+            expected += truth[q].size();
+        }
+        free(ids);
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+    }
+
+    auto strategy = knowhere::IndexHNSW::ChooseFilterStrategy(N, survivors, 64, 32);
+    state.counters["recall"] = expected == 0 ? 1.0 : double(hits) / expected;
+    state.counters["strategy"] = static_cast<int>(strategy);
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+BENCHMARK(HNSW_FilteredSearch)->Arg(1)->Arg(10)->Arg(50)->Arg(100)->Arg(300)->Arg(500)->Arg(900)->Arg(1000);
+
+// small unfiltered batches, the second argument passes a bitset without set bits to force one walk per query
+static void
+HNSW_SmallBatchSearch(benchmark::State& state) {
+    auto nq = state.range(0);
+    auto one_by_one = state.range(1);
+    faiss::ConcurrentBitset no_filter(N);
+    auto bitset = one_by_one ? faiss::BitsetView(no_filter) : faiss::BitsetView();
+    auto query_dataset = knowhere::GenDataset(nq, dim, queries.data());
+    for (auto _ : state) {
+        auto result = hnsw->Query(query_dataset, conf, bitset);
+        free(result->Get<int64_t*>(knowhere::meta::IDS));
+        free(result->Get<float*>(knowhere::meta::DISTANCE));
+    }
+    state.SetItemsProcessed(state.iterations() * nq);
+}
+
+BENCHMARK(HNSW_SmallBatchSearch)->ArgsProduct({{1, 2, 4, 8}, {0, 1}});
@@ -0,0 +1,129 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <tbb/concurrent_unordered_map.h>
+#include "segcore/PkOffsetIndex.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+static constexpr int64_t batch_size = 50000;
+static constexpr int64_t num_queries = 10000;
+
+static std::vector<int64_t>
+GenPks(int64_t size) {
+    std::default_random_engine e(42);
+    std::vector<int64_t> pks(size);
+    for (auto& pk : pks) {
+        pk = e();
+    }
+    return pks;
+}
+
+static std::vector<int64_t>
+GenQueries(const std::vector<int64_t>& pks) {
+    std::default_random_engine e(67);
+    std::vector<int64_t> queries(num_queries);
+    for (auto& query : queries) {
+        query = pks[e() % pks.size()];
+    }
+    return queries;
+}
+
+static std::atomic<int64_t> allocated_bytes = 0;
+
+// counts the bytes held by the tbb map
+template <typename T>
+struct CountingAllocator : std::allocator<T> {
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U>;
+    };
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {
+    }
+    T*
+    allocate(size_t n) {
+        allocated_bytes += n * sizeof(T);
+        return std::allocator<T>::allocate(n);
+    }
+    void
+    deallocate(T* p, size_t n) {
+        allocated_bytes -= n * sizeof(T);
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+static void
+PkIndex_TbbMultimap(benchmark::State& state) {
+    auto N = state.range(0);
+    auto pks = GenPks(N);
+    std::vector<Timestamp> timestamps(N);
+    std::iota(timestamps.begin(), timestamps.end(), 0);
+    auto queries = GenQueries(pks);
+
+    auto mem_begin = allocated_bytes.load();
+    tbb::concurrent_unordered_multimap<idx_t, int64_t, std::hash<idx_t>, std::equal_to<idx_t>,
+                                       CountingAllocator<std::pair<const idx_t, int64_t>>>
+        uid2offset;
+    for (int64_t i = 0; i < N; ++i) {
+        uid2offset.insert(std::make_pair(pks[i], i));
+    }
+    state.counters["bytes_per_row"] = double(allocated_bytes - mem_begin) / N;
+
+    for (auto _ : state) {
+        for (auto query : queries) {
+            int64_t the_offset = -1;
+            auto [iter_b, iter_e] = uid2offset.equal_range(query);
+            for (auto iter = iter_b; iter != iter_e; ++iter) {
+                if (timestamps[iter->second] < MAX_TIMESTAMP) {
+                    the_offset = std::max(the_offset, iter->second);
+                }
+            }
+            benchmark::DoNotOptimize(the_offset);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+static void
+PkIndex_PkOffsetIndex(benchmark::State& state) {
+    auto N = state.range(0);
+    auto pks = GenPks(N);
+    std::vector<Timestamp> timestamps(N);
+    std::iota(timestamps.begin(), timestamps.end(), 0);
+    auto queries = GenQueries(pks);
+
+    PkOffsetIndex uid2offset;
+    for (int64_t beg = 0; beg < N; beg += batch_size) {
+        auto size = std::min(batch_size, N - beg);
+        uid2offset.insert(beg, size, pks.data() + beg, timestamps.data() + beg);
+    }
+    state.counters["bytes_per_row"] = double(uid2offset.memory_usage_in_bytes()) / N;
+
+    std::vector<int64_t> offsets(num_queries);
+    for (auto _ : state) {
+        uid2offset.find_latest(num_queries, queries.data(), MAX_TIMESTAMP, N, offsets.data());
+        benchmark::DoNotOptimize(offsets.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_queries);
+}
+
+BENCHMARK(PkIndex_TbbMultimap)->Arg(1 << 20)->Arg(10 << 20);
+BENCHMARK(PkIndex_PkOffsetIndex)->Arg(1 << 20)->Arg(10 << 20);
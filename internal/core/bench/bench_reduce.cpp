@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+#include "common/Types.h"
+#include "segcore/reduce_c.h"
+
+using namespace milvus;
+
+static int64_t num_queries = 16;
+
+static std::vector<QueryResult>
+GenQueryResults(int64_t num_segments, int64_t topk) {
+    std::default_random_engine e(42);
+    std::vector<QueryResult> query_results;
+    for (int64_t seg = 0; seg < num_segments; ++seg) {
+        QueryResult query_result(num_queries, topk);
+        query_result.metric_type_ = MetricType::METRIC_L2;
+        for (int64_t n = 0; n < num_queries; ++n) {
+            auto begin = query_result.result_distances_.begin() + n * topk;
+            for (int64_t k = 0; k < topk; ++k) {
+                begin[k] = e() % 1000000;
+                query_result.internal_seg_offsets_[n * topk + k] = n * topk + k;
+            }
+            // L2 hits as Search in segment_c.cpp hands them to the reduce: negated, larger first
+            std::sort(begin, begin + topk);
+            std::transform(begin, begin + topk, begin, std::negate<float>());
+        }
+        query_results.emplace_back(std::move(query_result));
+    }
+    return query_results;
+}
+
+static void
+Reduce_QueryResults(benchmark::State& state) {
+    auto num_segments = state.range(0);
+    auto topk = state.range(1);
+    auto origin_results = GenQueryResults(num_segments, topk);
+    std::vector<char> is_selected(num_segments);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto query_results = origin_results;
+        std::vector<CQueryResult> c_query_results;
+        for (auto& query_result : query_results) {
+            c_query_results.push_back(&query_result);
+        }
+        std::fill(is_selected.begin(), is_selected.end(), false);
+        state.ResumeTiming();
+
+        auto status = ReduceQueryResults(c_query_results.data(), num_segments, (bool*)is_selected.data());
+        benchmark::DoNotOptimize(status);
+    }
+}
+
+BENCHMARK(Reduce_QueryResults)->ArgsProduct({{8, 64, 512}, {10, 100, 1000}});
@@ -0,0 +1,191 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/Bitmap.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus {
+// the word loops below are plain enough for the compiler to vectorize them
+Bitmap::Bitmap(int64_t size, bool value) : size_(size), words_((size + 63) / 64, value ? ~uint64_t(0) : 0) {
+    clear_tail();
+}
+
+void
+Bitmap::clear_tail() {
+    if (size_ % 64 != 0) {
+        words_.back() &= (uint64_t(1) << (size_ % 64)) - 1;
+    }
+}
+
+void
+Bitmap::fill(int64_t begin, int64_t end, bool value) {
+    Assert(0 <= begin && begin <= end && end <= size_);
+    if (begin == end) {
+        return;
+    }
+    auto fill_word = value ? ~uint64_t(0) : 0;
+    auto begin_word = begin / 64;
+    auto end_word = (end - 1) / 64;
+    auto head_mask = ~uint64_t(0) << (begin % 64);
+    auto tail_mask = ~uint64_t(0) >> (63 - (end - 1) % 64);
+    if (begin_word == end_word) {
+        auto mask = head_mask & tail_mask;
+        words_[begin_word] = (words_[begin_word] & ~mask) | (fill_word & mask);
+        return;
+    }
+    words_[begin_word] = (words_[begin_word] & ~head_mask) | (fill_word & head_mask);
+    for (auto w = begin_word + 1; w < end_word; ++w) {
+        words_[w] = fill_word;
+    }
+    words_[end_word] = (words_[end_word] & ~tail_mask) | (fill_word & tail_mask);
+}
+
+bool
+Bitmap::any(int64_t begin, int64_t end) const {
+    Assert(0 <= begin && begin <= end && end <= size_);
+    if (begin == end) {
+        return false;
+    }
+    auto begin_word = begin / 64;
+    auto end_word = (end - 1) / 64;
+    auto head_mask = ~uint64_t(0) << (begin % 64);
+    auto tail_mask = ~uint64_t(0) >> (63 - (end - 1) % 64);
+    if (begin_word == end_word) {
+        return (words_[begin_word] & head_mask & tail_mask) != 0;
+    }
+    if ((words_[begin_word] & head_mask) != 0 || (words_[end_word] & tail_mask) != 0) {
+        return true;
+    }
+    for (auto w = begin_word + 1; w < end_word; ++w) {
+        if (words_[w] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+Bitmap::all(int64_t begin, int64_t end) const {
+    Assert(0 <= begin && begin <= end && end <= size_);
+    if (begin == end) {
+        return true;
+    }
+    auto begin_word = begin / 64;
+    auto end_word = (end - 1) / 64;
+    auto head_mask = ~uint64_t(0) << (begin % 64);
+    auto tail_mask = ~uint64_t(0) >> (63 - (end - 1) % 64);
+    if (begin_word == end_word) {
+        auto mask = head_mask & tail_mask;
+        return (words_[begin_word] & mask) == mask;
+    }
+    if ((words_[begin_word] & head_mask) != head_mask || (words_[end_word] & tail_mask) != tail_mask) {
+        return false;
+    }
+    for (auto w = begin_word + 1; w < end_word; ++w) {
+        if (words_[w] != ~uint64_t(0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+Bitmap::copy_from(int64_t offset, const uint64_t* src, int64_t size) {
+    Assert(0 <= offset && offset + size <= size_);
+    if (size == 0) {
+        return;
+    }
+    auto shift = offset % 64;
+    auto dst = words_.data() + offset / 64;
+    auto num_full_words = size / 64;
+    auto remain = size % 64;
+    if (shift == 0) {
+        std::copy_n(src, num_full_words, dst);
+        if (remain != 0) {
+            auto mask = (uint64_t(1) << remain) - 1;
+            dst[num_full_words] = (dst[num_full_words] & ~mask) | (src[num_full_words] & mask);
+        }
+        return;
+    }
+    // every source word straddles two destination words
+    auto low_mask = (uint64_t(1) << shift) - 1;
+    for (int64_t w = 0; w < num_full_words; ++w) {
+        dst[w] = (dst[w] & low_mask) | (src[w] << shift);
+        dst[w + 1] = (dst[w + 1] & ~low_mask) | (src[w] >> (64 - shift));
+    }
+    for (int64_t i = num_full_words * 64; i < size; ++i) {
+        set(offset + i, (src[i / 64] >> (i % 64)) & 1);
+    }
+}
+
+int64_t
+Bitmap::count() const {
+    int64_t ret = 0;
+    for (auto word : words_) {
+        ret += __builtin_popcountll(word);
+    }
+    return ret;
+}
+
+Bitmap&
+Bitmap::operator&=(const Bitmap& other) {
+    Assert(size_ == other.size_);
+    auto dst = words_.data();
+    auto src = other.words_.data();
+    for (int64_t w = 0; w < words_.size(); ++w) {
+        dst[w] &= src[w];
+    }
+    return *this;
+}
+
+Bitmap&
+Bitmap::operator|=(const Bitmap& other) {
+    Assert(size_ == other.size_);
+    auto dst = words_.data();
+    auto src = other.words_.data();
+    for (int64_t w = 0; w < words_.size(); ++w) {
+        dst[w] |= src[w];
+    }
+    return *this;
+}
+
+Bitmap&
+Bitmap::operator^=(const Bitmap& other) {
+    Assert(size_ == other.size_);
+    auto dst = words_.data();
+    auto src = other.words_.data();
+    for (int64_t w = 0; w < words_.size(); ++w) {
+        dst[w] ^= src[w];
+    }
+    return *this;
+}
+
+Bitmap&
+Bitmap::operator-=(const Bitmap& other) {
+    Assert(size_ == other.size_);
+    auto dst = words_.data();
+    auto src = other.words_.data();
+    for (int64_t w = 0; w < words_.size(); ++w) {
+        dst[w] &= ~src[w];
+    }
+    return *this;
+}
+
+void
+Bitmap::flip() {
+    auto dst = words_.data();
+    for (int64_t w = 0; w < words_.size(); ++w) {
+        dst[w] = ~dst[w];
+    }
+    clear_tail();
+}
+
+}  // namespace milvus
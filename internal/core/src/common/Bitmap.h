@@ -0,0 +1,115 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <cstdint>
+#include "common/Types.h"
+
+namespace milvus {
+// Packed bitmap over 64-byte aligned 64-bit words, bit i lives in words()[i / 64].
+// Bits past size() are always kept zero, so the word-level operations never see garbage
+// and view() can be handed to the vector search without copying.
+class Bitmap {
+ public:
+    Bitmap() = default;
+
+    explicit Bitmap(int64_t size, bool value = false);
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
+    int64_t
+    num_words() const {
+        return words_.size();
+    }
+
+    uint64_t*
+    words() {
+        return words_.data();
+    }
+
+    const uint64_t*
+    words() const {
+        return words_.data();
+    }
+
+    bool
+    test(int64_t index) const {
+        return (words_[index / 64] >> (index % 64)) & 1;
+    }
+
+    bool
+    operator[](int64_t index) const {
+        return test(index);
+    }
+
+    void
+    set(int64_t index, bool value = true) {
+        auto bit = uint64_t(1) << (index % 64);
+        if (value) {
+            words_[index / 64] |= bit;
+        } else {
+            words_[index / 64] &= ~bit;
+        }
+    }
+
+    // set bits [begin, end) to value
+    void
+    fill(int64_t begin, int64_t end, bool value);
+
+    // whether any / every bit of [begin, end) is set
+    bool
+    any(int64_t begin, int64_t end) const;
+
+    bool
+    all(int64_t begin, int64_t end) const;
+
+    // copy size bits of src into [offset, offset + size), offset needs no alignment
+    void
+    copy_from(int64_t offset, const uint64_t* src, int64_t size);
+
+    int64_t
+    count() const;
+
+    Bitmap&
+    operator&=(const Bitmap& other);
+
+    Bitmap&
+    operator|=(const Bitmap& other);
+
+    Bitmap&
+    operator^=(const Bitmap& other);
+
+    // and-not, same as boost::dynamic_bitset
+    Bitmap&
+    operator-=(const Bitmap& other);
+
+    void
+    flip();
+
+    // set bit means filtered out for faiss, so views usually follow a flip()
+    BitsetView
+    view() const {
+        return BitsetView(reinterpret_cast<const uint8_t*>(words_.data()), size_);
+    }
+
+ private:
+    void
+    clear_tail();
+
+ private:
+    int64_t size_ = 0;
+    aligned_vector<uint64_t> words_;
+};
+
+}  // namespace milvus
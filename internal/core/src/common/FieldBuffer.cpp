@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "common/FieldBuffer.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus {
+
+FieldBuffer
+FieldBuffer::Map(const std::string& path, int64_t offset, int64_t length, AccessPattern pattern) {
+    AssertInfo(offset >= 0 && length > 0, "invalid region of " + path);
+    auto fd = open(path.c_str(), O_RDONLY);
+    AssertInfo(fd != -1, "failed to open " + path + ": " + strerror(errno));
+    struct stat st;
+    auto stat_ret = fstat(fd, &st);
+    if (stat_ret == -1 || st.st_size < offset + length) {
+        close(fd);
+        PanicInfo("file " + path + " is shorter than the mapped region");
+    }
+
+    // mmap wants a page aligned offset, a misaligned layout still loads with the leading bytes mapped as well
+    int64_t page_size = sysconf(_SC_PAGESIZE);
+    auto map_offset = offset / page_size * page_size;
+    auto map_length = static_cast<size_t>(offset - map_offset + length);
+    auto addr = mmap(nullptr, map_length, PROT_READ, MAP_PRIVATE, fd, map_offset);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    AssertInfo(addr != MAP_FAILED, "failed to mmap " + path + ": " + strerror(errno));
+
+    int advice = MADV_NORMAL;
+    if (pattern == AccessPattern::SEQUENTIAL) {
+        advice = MADV_SEQUENTIAL;
+    } else if (pattern == AccessPattern::RANDOM) {
+        advice = MADV_RANDOM;
+    }
+    // only a hint, a failure is not worth failing the load for
+    madvise(addr, map_length, advice);
+
+    FieldBuffer buffer;
+    buffer.map_addr_ = addr;
+    buffer.map_length_ = map_length;
+    buffer.data_ = static_cast<const char*>(addr) + (offset - map_offset);
+    buffer.size_ = length;
+    return buffer;
+}
+
+FieldBuffer&
+FieldBuffer::operator=(FieldBuffer&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    clear();
+    // moving an aligned_vector keeps its storage, so data_ stays valid
+    heap_ = std::move(other.heap_);
+    map_addr_ = other.map_addr_;
+    map_length_ = other.map_length_;
+    data_ = other.data_;
+    size_ = other.size_;
+    other.map_addr_ = nullptr;
+    other.map_length_ = 0;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    return *this;
+}
+
+void
+FieldBuffer::clear() {
+    if (map_addr_ != nullptr) {
+        munmap(map_addr_, map_length_);
+        map_addr_ = nullptr;
+        map_length_ = 0;
+    }
+    heap_ = aligned_vector<char>();
+    data_ = nullptr;
+    size_ = 0;
+}
+
+}  // namespace milvus
@@ -0,0 +1,89 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include "common/Types.h"
+
+namespace milvus {
+
+// madvise hint for a mapped field
+enum class AccessPattern {
+    NORMAL = 0,
+    // scanned front to back, e.g. brute force search or filters: aggressive read-ahead
+    SEQUENTIAL = 1,
+    // point reads, e.g. fetching target entries: no read-ahead
+    RANDOM = 2,
+};
+
+// bytes of one sealed field, either owned on the heap or a read-only mapping of a region of a file.
+// a mapped field lives in the page cache, so a cold segment costs no heap and reloads without copies
+class FieldBuffer {
+ public:
+    FieldBuffer() = default;
+
+    explicit FieldBuffer(aligned_vector<char>&& heap) : heap_(std::move(heap)) {
+        data_ = heap_.data();
+        size_ = heap_.size();
+    }
+
+    // maps [offset, offset + length) of the file at path, offset should be page aligned
+    static FieldBuffer
+    Map(const std::string& path, int64_t offset, int64_t length, AccessPattern pattern);
+
+    FieldBuffer(FieldBuffer&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    FieldBuffer&
+    operator=(FieldBuffer&& other) noexcept;
+
+    FieldBuffer(const FieldBuffer&) = delete;
+    FieldBuffer&
+    operator=(const FieldBuffer&) = delete;
+
+    ~FieldBuffer() {
+        clear();
+    }
+
+    const char*
+    data() const {
+        return data_;
+    }
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
+    bool
+    empty() const {
+        return size_ == 0;
+    }
+
+    bool
+    is_mapped() const {
+        return map_addr_ != nullptr;
+    }
+
+    void
+    clear();
+
+ private:
+    aligned_vector<char> heap_;
+    void* map_addr_ = nullptr;
+    size_t map_length_ = 0;
+    const char* data_ = nullptr;
+    int64_t size_ = 0;
+};
+
+}  // namespace milvus
@@ -11,6 +11,7 @@
 
 #pragma once
 #include "common/Types.h"
+#include "common/VectorPrecision.h"
 #include "utils/Status.h"
 #include "exceptions/EasyAssert.h"
 #include <string>
@@ -121,9 +122,16 @@ class FieldMeta {
         Assert(!is_vector());
     }
 
-    FieldMeta(const FieldName& name, FieldId id, DataType type, int64_t dim, std::optional<MetricType> metric_type)
-        : name_(name), id_(id), type_(type), vector_info_(VectorInfo{dim, metric_type}) {
+    FieldMeta(const FieldName& name,
+              FieldId id,
+              DataType type,
+              int64_t dim,
+              std::optional<MetricType> metric_type,
+              VectorPrecision precision = VectorPrecision::FP32)
+        : name_(name), id_(id), type_(type), vector_info_(VectorInfo{dim, metric_type, precision}) {
         Assert(is_vector());
+        AssertInfo(type == DataType::VECTOR_FLOAT || precision == VectorPrecision::FP32,
+                   "storage precision is only supported by float vectors");
     }
 
     bool
@@ -146,6 +154,13 @@ class FieldMeta {
         return vector_info_->metric_type_;
     }
 
+    VectorPrecision
+    get_vector_precision() const {
+        Assert(is_vector());
+        Assert(vector_info_.has_value());
+        return vector_info_->precision_;
+    }
+
     const FieldName&
     get_name() const {
         return name_;
@@ -170,10 +185,21 @@ class FieldMeta {
         }
     }
 
+    // bytes one row takes in segment memory, differs from get_sizeof() only for reduced-precision float vectors
+    int
+    get_storage_sizeof() const {
+        if (type_ == DataType::VECTOR_FLOAT) {
+            return vector_code_sizeof(get_vector_precision(), get_dim());
+        } else {
+            return get_sizeof();
+        }
+    }
+
  private:
     struct VectorInfo {
         int64_t dim_;
         std::optional<MetricType> metric_type_;
+        VectorPrecision precision_;
     };
     FieldName name_;
     FieldId id_;
@@ -13,6 +13,7 @@
 #include <string>
 #include <map>
 
+#include "common/FieldBuffer.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 
 struct LoadIndexInfo {
@@ -27,4 +28,9 @@ struct LoadFieldDataInfo {
     int64_t field_id;
     const void* blob = nullptr;
     int64_t row_count = -1;
+    // instead of blob: the column sits in file_path from file_offset on (page aligned), row_count fixed-width
+    // values back to back. user fields keep the mapping as their storage instead of copying it
+    std::string file_path;
+    int64_t file_offset = 0;
+    milvus::AccessPattern access_pattern = milvus::AccessPattern::NORMAL;
 };
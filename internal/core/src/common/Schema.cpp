@@ -57,11 +57,15 @@ Schema::ParseFrom(const milvus::proto::schema::CollectionSchema& schema_proto) {
 
             AssertInfo(type_map.count("dim"), "dim not found");
             auto dim = boost::lexical_cast<int64_t>(type_map.at("dim"));
+            auto precision = VectorPrecision::FP32;
+            if (type_map.count("precision")) {
+                precision = GetVectorPrecision(type_map.at("precision"));
+            }
             if (!index_map.count("metric_type")) {
-                schema->AddField(name, field_id, data_type, dim, std::nullopt);
+                schema->AddField(name, field_id, data_type, dim, std::nullopt, precision);
             } else {
                 auto metric_type = GetMetricType(index_map.at("metric_type"));
-                schema->AddField(name, field_id, data_type, dim, metric_type);
+                schema->AddField(name, field_id, data_type, dim, metric_type, precision);
             }
         } else {
             schema->AddField(name, field_id, data_type);
@@ -34,11 +34,15 @@ class Schema {
 
     // auto gen field_id for convenience
     FieldId
-    AddDebugField(const std::string& name, DataType data_type, int64_t dim, std::optional<MetricType> metric_type) {
+    AddDebugField(const std::string& name,
+                  DataType data_type,
+                  int64_t dim,
+                  std::optional<MetricType> metric_type,
+                  VectorPrecision precision = VectorPrecision::FP32) {
         static int64_t debug_id = 2001;
         auto field_id = FieldId(debug_id);
         debug_id += 2;
-        auto field_meta = FieldMeta(FieldName(name), field_id, data_type, dim, metric_type);
+        auto field_meta = FieldMeta(FieldName(name), field_id, data_type, dim, metric_type, precision);
         this->AddField(std::move(field_meta));
         return field_id;
     }
@@ -56,8 +60,9 @@ class Schema {
              const FieldId id,
              DataType data_type,
              int64_t dim,
-             std::optional<MetricType> metric_type) {
-        auto field_meta = FieldMeta(name, id, data_type, dim, metric_type);
+             std::optional<MetricType> metric_type,
+             VectorPrecision precision = VectorPrecision::FP32) {
+        auto field_meta = FieldMeta(name, id, data_type, dim, metric_type, precision);
         this->AddField(std::move(field_meta));
     }
 
@@ -104,6 +109,12 @@ class Schema {
         return total_sizeof_;
     }
 
+    // per-row bytes held in segment memory, see FieldMeta::get_storage_sizeof
+    auto
+    get_total_storage_sizeof() const {
+        return total_storage_sizeof_;
+    }
+
     const std::vector<int64_t>&
     get_sizeof_infos() const {
         return sizeof_infos_;
@@ -162,8 +173,9 @@ class Schema {
 
         auto field_sizeof = field_meta.get_sizeof();
         sizeof_infos_.push_back(std::move(field_sizeof));
-        fields_.emplace_back(std::move(field_meta));
         total_sizeof_ += field_sizeof;
+        total_storage_sizeof_ += field_meta.get_storage_sizeof();
+        fields_.emplace_back(std::move(field_meta));
     }
 
  private:
@@ -175,6 +187,7 @@ class Schema {
     std::unordered_map<FieldId, FieldOffset> id_offsets_;      // field_id -> offset
     std::vector<int64_t> sizeof_infos_;
     int total_sizeof_ = 0;
+    int total_storage_sizeof_ = 0;
     bool is_auto_id_ = true;
     std::optional<FieldOffset> primary_key_offset_opt_;
 };
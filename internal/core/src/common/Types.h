@@ -66,20 +66,43 @@ struct QueryResult {
 
     [[nodiscard]] uint64_t
     get_row_count() const {
+        if (!result_lims_.empty()) {
+            return result_lims_.back();
+        }
         return topK_ * num_queries_;
     }
 
+    // hits of query i sit at [get_query_offset(i), get_query_offset(i + 1))
+    [[nodiscard]] int64_t
+    get_query_offset(int64_t query_index) const {
+        if (!result_lims_.empty()) {
+            return result_lims_[query_index];
+        }
+        return query_index * topK_;
+    }
+
+    // target entry of hit i, row_data_sizeof_ bytes starting with the primary key
+    [[nodiscard]] const char*
+    get_row_data(int64_t index) const {
+        return row_data_.data() + index * row_data_sizeof_;
+    }
+
  public:
     uint64_t num_queries_;
     uint64_t topK_;
     uint64_t seg_id_;
     std::vector<float> result_distances_;
+    // range search only: num_queries_ + 1 offsets, every query holds at most topK_ hits.
+    // empty for knn searches, where every query holds exactly topK_
+    std::vector<int64_t> result_lims_;
 
  public:
     // TODO(gexi): utilize these field
     std::vector<int64_t> internal_seg_offsets_;
     std::vector<int64_t> result_offsets_;
-    std::vector<std::vector<char>> row_data_;
+    // target entries of all hits back to back, filled by FillTargetEntry
+    std::vector<char> row_data_;
+    int64_t row_data_sizeof_ = 0;
 };
 
 using QueryResultPtr = std::shared_ptr<QueryResult>;
@@ -0,0 +1,218 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/VectorPrecision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <boost/algorithm/string/case_conv.hpp>
+#include "exceptions/EasyAssert.h"
+
+namespace milvus {
+namespace {
+inline uint32_t
+float_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float
+bits_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// round to nearest even, overflow saturates to inf, NaN stays NaN
+inline uint16_t
+float_to_half(float value) {
+    constexpr uint32_t f32_infinity = 255u << 23;
+    constexpr uint32_t f16_overflow = (127u + 16) << 23;
+    constexpr uint32_t denorm_magic = ((127u - 15) + (23 - 10) + 1) << 23;
+    auto bits = float_bits(value);
+    auto sign = bits & 0x80000000u;
+    bits ^= sign;
+    uint32_t half;
+    if (bits >= f16_overflow) {
+        half = bits > f32_infinity ? 0x7e00 : 0x7c00;
+    } else if (bits < (113u << 23)) {
+        // the result is a half denormal or zero, let the fp adder do the rounding
+        half = float_bits(bits_float(bits) + bits_float(denorm_magic)) - denorm_magic;
+    } else {
+        auto mantissa_odd = (bits >> 13) & 1;
+        bits += ((15u - 127) << 23) + 0xfff;
+        bits += mantissa_odd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+inline float
+half_to_float(uint16_t half) {
+    constexpr uint32_t shifted_exponent = 0x7c00u << 13;
+    uint32_t bits = (half & 0x7fffu) << 13;
+    auto exponent = bits & shifted_exponent;
+    bits += (127u - 15) << 23;
+    if (exponent == shifted_exponent) {
+        // inf / NaN
+        bits += (128u - 16) << 23;
+    } else if (exponent == 0) {
+        // zero / denormal, renormalize
+        bits += 1u << 23;
+        bits = float_bits(bits_float(bits) - bits_float(113u << 23));
+    }
+    return bits_float(bits | (uint32_t(half & 0x8000u) << 16));
+}
+
+inline uint16_t
+float_to_bfloat(float value) {
+    auto bits = float_bits(value);
+    if (std::isnan(value)) {
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+    // round to nearest even
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float
+bfloat_to_float(uint16_t bfloat) {
+    return bits_float(uint32_t(bfloat) << 16);
+}
+
+void
+encode_int8(const float* src, int64_t dim, uint8_t* code) {
+    float max_abs = 0;
+    for (int64_t d = 0; d < dim; ++d) {
+        max_abs = std::max(max_abs, std::abs(src[d]));
+    }
+    float scale = max_abs / 127;
+    float inverse = scale == 0 ? 0 : 1 / scale;
+    memcpy(code, &scale, sizeof(scale));
+    auto dst = reinterpret_cast<int8_t*>(code + sizeof(scale));
+    for (int64_t d = 0; d < dim; ++d) {
+        auto value = std::nearbyint(src[d] * inverse);
+        dst[d] = static_cast<int8_t>(std::clamp(value, -127.0f, 127.0f));
+    }
+}
+
+void
+decode_int8(const uint8_t* code, int64_t dim, float* dst) {
+    float scale;
+    memcpy(&scale, code, sizeof(scale));
+    auto src = reinterpret_cast<const int8_t*>(code + sizeof(scale));
+    for (int64_t d = 0; d < dim; ++d) {
+        dst[d] = scale * src[d];
+    }
+}
+}  // namespace
+
+VectorPrecision
+GetVectorPrecision(const std::string& name) {
+    auto real_name = boost::algorithm::to_lower_copy(name);
+    if (real_name == "fp32") {
+        return VectorPrecision::FP32;
+    } else if (real_name == "fp16") {
+        return VectorPrecision::FP16;
+    } else if (real_name == "bf16") {
+        return VectorPrecision::BF16;
+    } else if (real_name == "int8") {
+        return VectorPrecision::INT8;
+    }
+    PanicInfo("vector precision not found: (" + name + ")");
+}
+
+std::string
+VectorPrecisionToName(VectorPrecision precision) {
+    switch (precision) {
+        case VectorPrecision::FP32:
+            return "fp32";
+        case VectorPrecision::FP16:
+            return "fp16";
+        case VectorPrecision::BF16:
+            return "bf16";
+        case VectorPrecision::INT8:
+            return "int8";
+        default:
+            PanicInfo("vector precision enum(" + std::to_string((int)precision) + ") not found");
+    }
+}
+
+void
+EncodeVectors(VectorPrecision precision, const float* src, int64_t count, int64_t dim, uint8_t* codes) {
+    switch (precision) {
+        case VectorPrecision::FP32: {
+            memcpy(codes, src, sizeof(float) * count * dim);
+            break;
+        }
+        case VectorPrecision::FP16: {
+            for (int64_t i = 0; i < count * dim; ++i) {
+                auto half = float_to_half(src[i]);
+                memcpy(codes + 2 * i, &half, sizeof(half));
+            }
+            break;
+        }
+        case VectorPrecision::BF16: {
+            for (int64_t i = 0; i < count * dim; ++i) {
+                auto bfloat = float_to_bfloat(src[i]);
+                memcpy(codes + 2 * i, &bfloat, sizeof(bfloat));
+            }
+            break;
+        }
+        case VectorPrecision::INT8: {
+            auto code_size = vector_code_sizeof(precision, dim);
+            for (int64_t i = 0; i < count; ++i) {
+                encode_int8(src + i * dim, dim, codes + i * code_size);
+            }
+            break;
+        }
+        default:
+            PanicInfo("unsupported vector precision");
+    }
+}
+
+void
+DecodeVectors(VectorPrecision precision, const uint8_t* codes, int64_t count, int64_t dim, float* dst) {
+    switch (precision) {
+        case VectorPrecision::FP32: {
+            memcpy(dst, codes, sizeof(float) * count * dim);
+            break;
+        }
+        case VectorPrecision::FP16: {
+            for (int64_t i = 0; i < count * dim; ++i) {
+                uint16_t half;
+                memcpy(&half, codes + 2 * i, sizeof(half));
+                dst[i] = half_to_float(half);
+            }
+            break;
+        }
+        case VectorPrecision::BF16: {
+            for (int64_t i = 0; i < count * dim; ++i) {
+                uint16_t bfloat;
+                memcpy(&bfloat, codes + 2 * i, sizeof(bfloat));
+                dst[i] = bfloat_to_float(bfloat);
+            }
+            break;
+        }
+        case VectorPrecision::INT8: {
+            auto code_size = vector_code_sizeof(precision, dim);
+            for (int64_t i = 0; i < count; ++i) {
+                decode_int8(codes + i * code_size, dim, dst + i * dim);
+            }
+            break;
+        }
+        default:
+            PanicInfo("unsupported vector precision");
+    }
+}
+
+}  // namespace milvus
@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace milvus {
+// how the raw rows of a float vector field are kept in memory.
+// the wire format (insert / load / retrieve) is always fp32, rows are encoded into codes when they are stored
+// and decoded on the fly when they are scored or read back.
+enum class VectorPrecision {
+    FP32,
+    // IEEE half, 2 bytes per component
+    FP16,
+    // upper half of the fp32 bits, 2 bytes per component, same range as fp32
+    BF16,
+    // symmetric per-row quantization: a float scale followed by dim signed bytes, x ~= scale * code
+    INT8,
+};
+
+// accepts "fp32", "fp16", "bf16", "int8" in any case
+VectorPrecision
+GetVectorPrecision(const std::string& name);
+
+std::string
+VectorPrecisionToName(VectorPrecision precision);
+
+// bytes of one encoded row
+inline int64_t
+vector_code_sizeof(VectorPrecision precision, int64_t dim) {
+    switch (precision) {
+        case VectorPrecision::FP16:
+        case VectorPrecision::BF16:
+            return 2 * dim;
+        case VectorPrecision::INT8:
+            return sizeof(float) + dim;
+        default:
+            return sizeof(float) * dim;
+    }
+}
+
+// count rows of dim components, rows are packed back to back on both sides
+void
+EncodeVectors(VectorPrecision precision, const float* src, int64_t count, int64_t dim, uint8_t* codes);
+
+void
+DecodeVectors(VectorPrecision precision, const uint8_t* codes, int64_t count, int64_t dim, float* dst);
+
+}  // namespace milvus
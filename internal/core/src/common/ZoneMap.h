@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+namespace milvus {
+// min / max / null count of one chunk of a scalar field, lets a filter decide a whole chunk without reading it.
+// there are no nullable fields yet, so float NaNs are counted as nulls: they fail every compare,
+// and a chunk holding one is never decided from its bounds.
+template <typename T>
+struct ZoneMap {
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    int64_t null_count = 0;
+
+    // bounds are exact and cover every row
+    bool
+    usable() const {
+        return null_count == 0 && !(max < min);
+    }
+
+    void
+    update(const T* data, int64_t count) {
+        auto min_value = min;
+        auto max_value = max;
+        int64_t nulls = 0;
+        for (int64_t i = 0; i < count; ++i) {
+            auto value = data[i];
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(value)) {
+                    ++nulls;
+                    continue;
+                }
+            }
+            min_value = value < min_value ? value : min_value;
+            max_value = max_value < value ? value : max_value;
+        }
+        min = min_value;
+        max = max_value;
+        null_count += nulls;
+    }
+};
+
+// type-erased zone map, monostate when the chunk has none
+using ZoneMapVariant = std::variant<std::monostate,
+                                    ZoneMap<bool>,
+                                    ZoneMap<int8_t>,
+                                    ZoneMap<int16_t>,
+                                    ZoneMap<int32_t>,
+                                    ZoneMap<int64_t>,
+                                    ZoneMap<float>,
+                                    ZoneMap<double>>;
+
+template <typename T>
+constexpr bool HasZoneMap = std::is_constructible_v<ZoneMapVariant, ZoneMap<T>>;
+}  // namespace milvus
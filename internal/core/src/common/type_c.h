@@ -45,6 +45,11 @@ typedef struct CLoadFieldDataInfo {
     int64_t field_id;
     void* blob;
     int64_t row_count;
+    // optional, mmap the column from this file instead of copying blob, see LoadFieldDataInfo
+    const char* file_path;
+    int64_t file_offset;
+    // 0: normal, 1: sequential, 2: random
+    int32_t access_pattern;
 } CLoadFieldDataInfo;
 
 typedef struct CProtoResult {
@@ -24,6 +24,9 @@ namespace knowhere {
 struct Binary {
     std::shared_ptr<uint8_t[]> data;
     int64_t size = 0;
+    // data lives as long as the shared_ptr, so an index loaded from it may keep it and point into it instead of
+    // copying. false for views of a caller's buffer that is released once loading returns
+    bool owned = false;
 };
 using BinaryPtr = std::shared_ptr<Binary>;
 
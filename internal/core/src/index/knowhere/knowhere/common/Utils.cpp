@@ -64,14 +64,41 @@ Assemble(BinarySet& binarySet) {
         std::string prefix = item[NAME];
         int slice_num = item[SLICE_NUM];
         auto total_len = static_cast<size_t>(item[TOTAL_LEN]);
-        auto p_data = std::shared_ptr<uint8_t[]>(new uint8_t[total_len]);
-        int64_t pos = 0;
+        auto binary = std::make_shared<Binary>();
+        binary->size = total_len;
+
+        // slices laid out back to back, e.g. views of one buffer or mapping, are stitched without a copy
+        std::vector<BinaryPtr> slices;
+        bool contiguous = slice_num > 0;
+        bool owned = true;
         for (auto i = 0; i < slice_num; ++i) {
-            auto slice_i_sp = binarySet.Erase(prefix + "_" + std::to_string(i));
-            memcpy(p_data.get() + pos, slice_i_sp->data.get(), static_cast<size_t>(slice_i_sp->size));
-            pos += slice_i_sp->size;
+            auto slice_i_sp = binarySet.GetByName(prefix + "_" + std::to_string(i));
+            if (i > 0 && slice_i_sp->data.get() != slices.back()->data.get() + slices.back()->size) {
+                contiguous = false;
+            }
+            owned = owned && slice_i_sp->owned;
+            slices.push_back(std::move(slice_i_sp));
+        }
+        if (contiguous) {
+            auto head = slices.front()->data.get();
+            binary->data = std::shared_ptr<uint8_t[]>(std::make_shared<std::vector<BinaryPtr>>(std::move(slices)), head);
+            binary->owned = owned;
+            for (auto i = 0; i < slice_num; ++i) {
+                binarySet.Erase(prefix + "_" + std::to_string(i));
+            }
+        } else {
+            slices.clear();
+            binary->data = std::shared_ptr<uint8_t[]>(new uint8_t[total_len]);
+            binary->owned = true;
+            int64_t pos = 0;
+            for (auto i = 0; i < slice_num; ++i) {
+                // every slice is released as soon as it is copied
+                auto slice_i_sp = binarySet.Erase(prefix + "_" + std::to_string(i));
+                memcpy(binary->data.get() + pos, slice_i_sp->data.get(), static_cast<size_t>(slice_i_sp->size));
+                pos += slice_i_sp->size;
+            }
         }
-        binarySet.Append(prefix, p_data, total_len);
+        binarySet.Append(prefix, binary);
     }
 }
 
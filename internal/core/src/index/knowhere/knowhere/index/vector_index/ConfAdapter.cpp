@@ -42,6 +42,8 @@ static const int64_t HNSW_MIN_M = 4;
 static const int64_t HNSW_MAX_M = 64;
 static const int64_t HNSW_MAX_EF = 32768;
 static const std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
+static const std::vector<std::string> HNSW_QUANTIZERS{knowhere::Quantizer::FLAT, knowhere::Quantizer::FP16,
+                                                      knowhere::Quantizer::SQ8};
 
 #define CheckIntByRange(key, min, max)                                                                   \
     if (!oricfg.contains(key) || !oricfg[key].is_number_integer() || oricfg[key].get<int64_t>() > max || \
@@ -278,6 +280,9 @@ bool
 HNSWConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::IndexParams::efConstruction, HNSW_MIN_EFCONSTRUCTION, HNSW_MAX_EFCONSTRUCTION);
     CheckIntByRange(knowhere::IndexParams::M, HNSW_MIN_M, HNSW_MAX_M);
+    if (oricfg.contains(knowhere::IndexParams::quantizer)) {
+        CheckStrByValues(knowhere::IndexParams::quantizer, HNSW_QUANTIZERS);
+    }
 
     return ConfAdapter::CheckTrain(oricfg, mode);
 }
@@ -285,6 +290,9 @@ HNSWConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
 bool
 HNSWConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) {
     CheckIntByRange(knowhere::IndexParams::ef, oricfg[knowhere::meta::TOPK], HNSW_MAX_EF);
+    if (oricfg.contains(knowhere::IndexParams::refine_k)) {
+        CheckIntByRange(knowhere::IndexParams::refine_k, oricfg[knowhere::meta::TOPK], HNSW_MAX_EF);
+    }
 
     return ConfAdapter::CheckSearch(oricfg, type, mode);
 }
@@ -43,12 +43,22 @@ void
 FaissBaseIndex::LoadImpl(const BinarySet& binary_set, const IndexType& type) {
     auto binary = binary_set.GetByName("IVF");
 
+#ifdef MILVUS_GPU_VERSION
+    // copies to gpu expect array inverted lists, see SealImpl
+    bool zero_copy = false;
+#else
+    bool zero_copy = binary->owned;
+#endif
+
     MemoryIOReader reader;
     reader.total = binary->size;
     reader.data_ = binary->data.get();
+    reader.borrowable = zero_copy;
 
-    faiss::Index* index = faiss::read_index(&reader);
+    // an owned buffer is kept, inverted lists point into it instead of copying their codes
+    faiss::Index* index = faiss::read_index(&reader, zero_copy ? faiss::IO_FLAG_ZERO_COPY : 0);
     index_.reset(index);
+    index_buffer_ = zero_copy ? binary : nullptr;
 
     SealImpl();
 }
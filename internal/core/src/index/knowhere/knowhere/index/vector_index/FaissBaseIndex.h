@@ -38,6 +38,10 @@ class FaissBaseIndex {
 
  public:
     std::shared_ptr<faiss::Index> index_ = nullptr;
+
+ protected:
+    // serialized index that index_ points into when it was loaded without copying
+    BinaryPtr index_buffer_ = nullptr;
 };
 
 }  // namespace knowhere
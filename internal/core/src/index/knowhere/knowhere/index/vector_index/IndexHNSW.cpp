@@ -11,9 +11,11 @@
 
 #include "knowhere/index/vector_index/IndexHNSW.h"
 
+#include <omp.h>
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <utility>
@@ -24,6 +26,7 @@
 #include "hnswlib/hnswlib.h"
 #include "hnswlib/space_ip.h"
 #include "hnswlib/space_l2.h"
+#include "hnswlib/space_sq.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Log.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -71,11 +74,27 @@ IndexHNSW::Load(const BinarySet& index_binary) {
         MemoryIOReader reader;
         reader.total = binary->size;
         reader.data_ = binary->data.get();
+        reader.borrowable = binary->owned;
 
         hnswlib::SpaceInterface<float>* space = nullptr;
         index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space);
         index_->stats_enable = (STATISTICS_LEVEL >= 3);
         index_->loadIndex(reader);
+        // the level 0 graph and vectors point into an owned buffer, which is kept as long as the index
+        index_buffer_ = index_->borrowed_level0_ ? binary : nullptr;
+        raw_data_ = nullptr;
+        if (dynamic_cast<hnswlib::QuantizedSpace*>(index_->space) != nullptr && index_binary.Contains(RAW_DATA)) {
+            auto raw = index_binary.GetByName(RAW_DATA);
+            if (raw->size != index_->cur_element_count * Dim() * sizeof(float)) {
+                KNOWHERE_THROW_MSG("raw data size doesn't match the index");
+            }
+            if (raw->owned) {
+                raw_data_ = raw->data;
+            } else {
+                raw_data_ = std::shared_ptr<uint8_t[]>(new uint8_t[raw->size]);
+                memcpy(raw_data_.get(), raw->data.get(), raw->size);
+            }
+        }
         auto hnsw_stats = std::static_pointer_cast<LibHNSWStatistics>(stats);
         if (STATISTICS_LEVEL >= 3) {
             auto lock = hnsw_stats->Lock();
@@ -96,16 +115,28 @@ IndexHNSW::Train(const DatasetPtr& dataset_ptr, const Config& config) {
 
         hnswlib::SpaceInterface<float>* space;
         std::string metric_type = config[Metric::TYPE];
-        if (metric_type == Metric::L2) {
+        if (metric_type != Metric::L2 && metric_type != Metric::IP) {
+            KNOWHERE_THROW_MSG("Metric type not supported: " + metric_type);
+        }
+        std::string quantizer = config.contains(IndexParams::quantizer)
+                                    ? config[IndexParams::quantizer].get<std::string>()
+                                    : std::string(Quantizer::FLAT);
+        if (quantizer == Quantizer::FP16 || quantizer == Quantizer::SQ8) {
+            auto type = quantizer == Quantizer::FP16 ? hnswlib::QuantizerType::FP16 : hnswlib::QuantizerType::SQ8;
+            auto quantized = new hnswlib::QuantizedSpace(dim, metric_type == Metric::IP, type);
+            quantized->train(static_cast<const float*>(dataset_ptr->Get<const void*>(meta::TENSOR)), rows);
+            space = quantized;
+        } else if (quantizer != Quantizer::FLAT) {
+            KNOWHERE_THROW_MSG("Quantizer not supported: " + quantizer);
+        } else if (metric_type == Metric::L2) {
             space = new hnswlib::L2Space(dim);
-        } else if (metric_type == Metric::IP) {
-            space = new hnswlib::InnerProductSpace(dim);
         } else {
-            KNOWHERE_THROW_MSG("Metric type not supported: " + metric_type);
+            space = new hnswlib::InnerProductSpace(dim);
         }
         index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space, rows, config[IndexParams::M].get<int64_t>(),
                                                                    config[IndexParams::efConstruction].get<int64_t>());
         index_->stats_enable = (STATISTICS_LEVEL >= 3);
+        raw_data_ = nullptr;
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
     }
@@ -119,14 +150,33 @@ IndexHNSW::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
 
     GET_TENSOR_DATA(dataset_ptr)
 
-    index_->addPoint(p_data, 0);
+    auto dim = Dim();
+    auto quantized = dynamic_cast<hnswlib::QuantizedSpace*>(index_->space);
+    std::vector<uint8_t> codes;
+    if (quantized != nullptr) {
+        codes.resize(rows * index_->data_size_);
 #pragma omp parallel for
-    for (int i = 1; i < rows; ++i) {
-        faiss::BuilderSuspend::check_wait();
-        index_->addPoint((reinterpret_cast<const float*>(p_data) + Dim() * i), i);
+        for (int64_t i = 0; i < rows; ++i) {
+            quantized->encode(reinterpret_cast<const float*>(p_data) + dim * i, codes.data() + i * index_->data_size_);
+        }
     }
+
+    bool deterministic = config.contains(IndexParams::deterministic) && config[IndexParams::deterministic].get<bool>();
+    auto hnsw_stats = std::static_pointer_cast<LibHNSWStatistics>(stats);
+    auto base = index_->cur_element_count;
+    auto build_start = std::chrono::high_resolution_clock::now();
+    auto progress = [&](size_t inserted) {
+        faiss::BuilderSuspend::check_wait();
+        if (STATISTICS_LEVEL >= 1) {
+            auto build_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::high_resolution_clock::now() - build_start)
+                                  .count();
+            auto lock = hnsw_stats->Lock();
+            hnsw_stats->update_build_progress(rows, inserted - base, build_time);
+        }
+    };
+    index_->addPoints(quantized != nullptr ? codes.data() : p_data, rows, deterministic, progress);
     if (STATISTICS_LEVEL >= 3) {
-        auto hnsw_stats = std::static_pointer_cast<LibHNSWStatistics>(stats);
         auto lock = hnsw_stats->Lock();
         hnsw_stats->update_level_distribution(index_->maxlevel_, index_->level_stats_);
     }
@@ -134,6 +184,24 @@ IndexHNSW::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
     //     LOG_KNOWHERE_DEBUG_ << GetStatistics()->ToString();
 }
 
+// a graph walk visits about ef * maxM0 / pass_rate rows before it holds ef valid ones, brute force
+// visits the survivors once; the graph is kept while it is the cheaper of the two.
+// once most rows are filtered, walking through them wastes the ef budget and two hops are used instead,
+// measured to win below a pass rate of about 1/4
+IndexHNSW::FilterStrategy
+IndexHNSW::ChooseFilterStrategy(size_t total, size_t survivors, size_t ef, size_t max_m0) {
+    if (survivors == total) {
+        return FilterStrategy::GRAPH;
+    }
+    if (static_cast<double>(survivors) * survivors <= static_cast<double>(ef) * max_m0 * total) {
+        return FilterStrategy::BRUTE_FORCE;
+    }
+    if (survivors * 4 < total) {
+        return FilterStrategy::TWO_HOP;
+    }
+    return FilterStrategy::GRAPH;
+}
+
 DatasetPtr
 IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const faiss::BitsetView bitset) {
     if (!index_) {
@@ -146,6 +214,29 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const fais
     size_t dist_size = sizeof(float) * k;
     auto p_id = static_cast<int64_t*>(malloc(id_size * rows));
     auto p_dist = static_cast<float*>(malloc(dist_size * rows));
+
+    // a quantized index walks the graph with encoded queries, and with raw rows at hand it fetches
+    // search_k candidates and re-ranks them by their exact distances
+    auto quantized = dynamic_cast<hnswlib::QuantizedSpace*>(index_->space);
+    auto data_size = index_->data_size_;
+    std::vector<uint8_t> query_codes;
+    if (quantized != nullptr) {
+        query_codes.resize(rows * data_size);
+#pragma omp parallel for
+        for (int64_t i = 0; i < rows; ++i) {
+            quantized->encode((const float*)p_data + i * dim, query_codes.data() + i * data_size);
+        }
+    }
+    auto query_at = [&](int64_t i) -> const void* {
+        return quantized != nullptr ? (const void*)(query_codes.data() + i * data_size) : (const float*)p_data + i * dim;
+    };
+    bool refine = quantized != nullptr && raw_data_ != nullptr;
+    size_t search_k = k;
+    if (refine && config.contains(IndexParams::refine_k)) {
+        search_k = std::max<size_t>(k, config[IndexParams::refine_k].get<int64_t>());
+    }
+    auto s_id = refine ? static_cast<int64_t*>(malloc(sizeof(int64_t) * search_k * rows)) : p_id;
+    auto s_dist = refine ? static_cast<float*>(malloc(sizeof(float) * search_k * rows)) : p_dist;
     std::vector<hnswlib::StatisticsInfo> query_stats;
     auto hnsw_stats = std::dynamic_pointer_cast<LibHNSWStatistics>(stats);
     if (STATISTICS_LEVEL >= 3) {
@@ -157,40 +248,120 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config, const fais
 
     index_->setEf(config[IndexParams::ef].get<int64_t>());
     bool transform = (index_->metric_type_ == 1);  // InnerProduct: 1
+    auto ef = std::max<size_t>(index_->ef_, search_k);
+    auto total = index_->cur_element_count;
+    size_t survivors = bitset.empty() ? total : total - std::min<size_t>(bitset.count_1(), total);
+    auto strategy = ChooseFilterStrategy(total, survivors, ef, index_->maxM0_);
 
     std::chrono::high_resolution_clock::time_point query_start, query_end;
     query_start = std::chrono::high_resolution_clock::now();
 
-#pragma omp parallel for
-    for (unsigned int i = 0; i < rows; ++i) {
-        auto single_query = (float*)p_data + i * dim;
-        std::priority_queue<std::pair<float, hnswlib::labeltype>> rst;
-        if (STATISTICS_LEVEL >= 3) {
-            rst = index_->searchKnn(single_query, k, bitset, query_stats[i]);
-        } else {
-            auto dummy_stat = hnswlib::StatisticsInfo();
-            rst = index_->searchKnn(single_query, k, bitset, dummy_stat);
+    auto write_result = [&](int64_t i, std::priority_queue<std::pair<float, hnswlib::labeltype>>& rst) {
+        auto p_single_dis = s_dist + i * search_k;
+        auto p_single_id = s_id + i * search_k;
+        for (auto idx = rst.size(); idx > 0; idx--) {
+            auto& it = rst.top();
+            p_single_dis[idx - 1] = it.first;
+            p_single_id[idx - 1] = it.second;
+            rst.pop();
+        }
+    };
+    auto refine_result = [&](int64_t i, size_t rst_size) {
+        auto s_single_dis = s_dist + i * search_k;
+        auto s_single_id = s_id + i * search_k;
+        auto raw_query = (const float*)p_data + i * dim;
+        auto raw_rows = reinterpret_cast<const float*>(raw_data_.get());
+        std::vector<std::pair<float, int64_t>> candidates(rst_size);
+        for (size_t idx = 0; idx < rst_size; idx++) {
+            auto row = raw_rows + s_single_id[idx] * dim;
+            // the same distance hnswlib reports, IP is turned into a similarity by finish_result
+            auto dis = transform ? 1 - faiss::fvec_inner_product(raw_query, row, dim)
+                                 : faiss::fvec_L2sqr(raw_query, row, dim);
+            candidates[idx] = {dis, s_single_id[idx]};
+        }
+        rst_size = std::min(rst_size, k);
+        std::partial_sort(candidates.begin(), candidates.begin() + rst_size, candidates.end());
+        for (size_t idx = 0; idx < rst_size; idx++) {
+            p_dist[i * k + idx] = candidates[idx].first;
+            p_id[i * k + idx] = candidates[idx].second;
+        }
+        return rst_size;
+    };
+    auto finish_result = [&](int64_t i, size_t rst_size) {
+        if (refine) {
+            rst_size = refine_result(i, rst_size);
         }
-        size_t rst_size = rst.size();
-
         auto p_single_dis = p_dist + i * k;
         auto p_single_id = p_id + i * k;
-        size_t idx = rst_size - 1;
-        while (!rst.empty()) {
-            auto& it = rst.top();
-            p_single_dis[idx] = transform ? (1 - it.first) : it.first;
-            p_single_id[idx] = it.second;
-            rst.pop();
-            idx--;
+        if (transform) {
+            for (size_t idx = 0; idx < rst_size; idx++) {
+                p_single_dis[idx] = 1 - p_single_dis[idx];
+            }
         }
         MapOffsetToUid(p_single_id, rst_size);
 
-        for (idx = rst_size; idx < k; idx++) {
+        for (auto idx = rst_size; idx < k; idx++) {
             p_single_dis[idx] = float(1.0 / 0.0);
             p_single_id[idx] = -1;
         }
+    };
+
+    if (bitset.empty() && STATISTICS_LEVEL < 3) {
+        // unfiltered queries are walked in interleaved batches, split so every thread still gets one
+        int64_t batch = std::min<int64_t>((rows + omp_get_max_threads() - 1) / omp_get_max_threads(), kMaxQueryBatch);
+        int64_t num_batches = (rows + batch - 1) / batch;
+#pragma omp parallel for
+        for (int64_t b = 0; b < num_batches; ++b) {
+            auto begin = b * batch;
+            auto nq = std::min(batch, rows - begin);
+            size_t counts[kMaxQueryBatch];
+            auto dummy_stat = hnswlib::StatisticsInfo();
+            index_->searchKnnBatch(query_at(begin), nq, search_k, ef, s_dist + begin * search_k,
+                                   s_id + begin * search_k, counts, dummy_stat);
+            for (int64_t i = begin; i < begin + nq; ++i) {
+                auto rst_size = counts[i - begin];
+                if (rst_size < std::min(search_k, total)) {
+                    auto rst = index_->searchKnnBF(query_at(i), search_k, bitset);
+                    rst_size = rst.size();
+                    write_result(i, rst);
+                }
+                finish_result(i, rst_size);
+            }
+        }
+    } else {
+#pragma omp parallel for
+        for (unsigned int i = 0; i < rows; ++i) {
+            auto single_query = query_at(i);
+            auto dummy_stat = hnswlib::StatisticsInfo();
+            auto& query_stat = STATISTICS_LEVEL >= 3 ? query_stats[i] : dummy_stat;
+            std::priority_queue<std::pair<float, hnswlib::labeltype>> rst;
+            auto expected = std::min(search_k, survivors);
+            if (strategy == FilterStrategy::BRUTE_FORCE) {
+                rst = index_->searchKnnBF(single_query, search_k, bitset);
+            } else if (strategy == FilterStrategy::TWO_HOP) {
+                // the walk only stops early once ef valid rows are found, so a short result means
+                // the valid rows reachable by two hops ran out
+                rst = index_->searchKnnFiltered(single_query, search_k, ef, bitset, query_stat);
+            } else {
+                rst = index_->searchKnn(single_query, search_k, ef, bitset, query_stat);
+                // filtered rows don't count towards ef, widen it until k valid rows are found
+                for (auto search_ef = ef * 2; rst.size() < expected && search_ef / 2 < survivors; search_ef *= 2) {
+                    rst = index_->searchKnn(single_query, search_k, search_ef, bitset, query_stat);
+                }
+            }
+            if (rst.size() < expected) {
+                rst = index_->searchKnnBF(single_query, search_k, bitset);
+            }
+            size_t rst_size = rst.size();
+            write_result(i, rst);
+            finish_result(i, rst_size);
+        }
     }
     query_end = std::chrono::high_resolution_clock::now();
+    if (refine) {
+        free(s_id);
+        free(s_dist);
+    }
 
     if (STATISTICS_LEVEL) {
         auto lock = hnsw_stats->Lock();
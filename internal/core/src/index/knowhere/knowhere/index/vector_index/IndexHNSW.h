@@ -55,8 +55,25 @@ class IndexHNSW : public VecIndex {
     void
     ClearStatistics() override;
 
+    // how a query walks the index under a bitset
+    enum class FilterStrategy {
+        GRAPH,
+        TWO_HOP,
+        BRUTE_FORCE,
+    };
+
+    static FilterStrategy
+    ChooseFilterStrategy(size_t total, size_t survivors, size_t ef, size_t max_m0);
+
+    // unfiltered queries one thread walks side by side
+    static constexpr int64_t kMaxQueryBatch = 8;
+
  private:
     std::shared_ptr<hnswlib::HierarchicalNSW<float>> index_;
+    // serialized index that index_ points into when it was loaded without copying
+    BinaryPtr index_buffer_ = nullptr;
+    // raw rows of a quantized index, RAW_DATA when it was loaded with one, results are re-ranked against them
+    std::shared_ptr<uint8_t[]> raw_data_ = nullptr;
 };
 
 }  // namespace knowhere
@@ -134,6 +134,38 @@ IDMAP::QueryByDistance(const milvus::knowhere::DatasetPtr& dataset,
     return result;
 }
 
+DatasetPtr
+IDMAP::QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GET_TENSOR_DATA(dataset)
+
+    auto real_idx = dynamic_cast<faiss::IndexFlat*>(index_.get());
+    if (real_idx == nullptr) {
+        KNOWHERE_THROW_MSG("Cannot dynamic_cast the index to faiss::IndexFlat type!");
+    }
+    auto default_type = index_->metric_type;
+    if (config.contains(Metric::TYPE)) {
+        index_->metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    }
+    auto radius = config[IndexParams::range_search_radius].get<float>();
+    auto buffer_size = config.contains(IndexParams::range_search_buffer_size)
+                           ? config[IndexParams::range_search_buffer_size].get<size_t>()
+                           : 16384;
+    if (index_->metric_type == faiss::MetricType::METRIC_L2) {
+        radius *= radius;
+    }
+    std::vector<faiss::RangeSearchPartialResult*> res;
+    real_idx->range_search(rows, reinterpret_cast<const float*>(p_data), radius, res, buffer_size, bitset);
+    index_->metric_type = default_type;
+
+    faiss::RangeSearchResult result(rows);
+    MergeRangeSearchResults(res, result);
+    MapOffsetToUid(result.labels, result.lims[rows]);
+    return GenRangeResultDataset(result);
+}
+
 int64_t
 IDMAP::Count() {
     if (!index_) {
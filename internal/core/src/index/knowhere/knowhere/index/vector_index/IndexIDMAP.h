@@ -49,6 +49,9 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     DynamicResultSegment
     QueryByDistance(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset);
 
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) override;
+
     int64_t
     Count() override;
 
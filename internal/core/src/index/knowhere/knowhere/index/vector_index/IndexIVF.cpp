@@ -139,6 +139,37 @@ IVF::Query(const DatasetPtr& dataset_ptr, const Config& config, const faiss::Bit
     }
 }
 
+DatasetPtr
+IVF::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config, const faiss::BitsetView bitset) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr) {
+        KNOWHERE_THROW_MSG("Cannot dynamic_cast the index to faiss::IndexIVF type!");
+    }
+
+    GET_TENSOR_DATA(dataset_ptr)
+
+    try {
+        auto params = GenParams(config);
+        ivf_index->nprobe = std::min(params->nprobe, ivf_index->invlists->nlist);
+        auto radius = config[IndexParams::range_search_radius].get<float>();
+        if (ivf_index->metric_type == faiss::MetricType::METRIC_L2) {
+            radius *= radius;
+        }
+
+        faiss::RangeSearchResult result(rows);
+        ivf_index->range_search(rows, reinterpret_cast<const float*>(p_data), radius, &result, bitset);
+        MapOffsetToUid(result.labels, result.lims[rows]);
+        return GenRangeResultDataset(result);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 #if 0
 DatasetPtr
 IVF::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
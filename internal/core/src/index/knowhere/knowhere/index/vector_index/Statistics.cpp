@@ -67,6 +67,8 @@ HNSWStatistics::ToString() {
 
     if (STATISTICS_LEVEL >= 1) {
         ret << "Avg Ef: " << AvgSearchEf() << std::endl;
+        ret << "Build progress: " << build_inserted << " / " << build_rows << " rows, " << BuildThroughput()
+            << " rows/s" << std::endl;
     }
     if (STATISTICS_LEVEL >= 3) {
         std::vector<size_t> axis_x = {5, 10, 20, 40};
@@ -178,7 +178,14 @@ using StatisticsPtr = std::shared_ptr<Statistics>;
 class HNSWStatistics : public Statistics {
  public:
     explicit HNSWStatistics(std::string& idx_t)
-        : Statistics(idx_t), distribution(), target_level(1), access_total(0), ef_sum(0) {
+        : Statistics(idx_t),
+          distribution(),
+          target_level(1),
+          access_total(0),
+          ef_sum(0),
+          build_rows(0),
+          build_inserted(0),
+          build_time(0.0) {
     }
 
     ~HNSWStatistics() override = default;
@@ -208,6 +215,25 @@ class HNSWStatistics : public Statistics {
         return nq_cnt ? ef_sum / nq_cnt : 0;
     }
 
+    /*
+     * Get the share of rows the running or last build has inserted (Level 1)
+     * @retval: build progress in [0, 1]
+     */
+    double
+    BuildProgress() {
+        return build_rows ? static_cast<double>(build_inserted) / build_rows : 0.0;
+    }
+
+    /*
+     * Get rows inserted per-second by the running or last build (Level 1)
+     * @retval: build throughput
+     */
+    double
+    BuildThroughput() {
+        // ms -> s
+        return build_time ? (build_inserted * 1000.0 / build_time) : 0.0;
+    }
+
     /*
      * Cumulative distribution function of nodes access (Level 3)
      * @param: none (axis_x = {5,10,15,20,...100} by default)
@@ -248,6 +274,13 @@ class HNSWStatistics : public Statistics {
         }
     }
 
+    void
+    update_build_progress(const size_t rows, const size_t inserted, const double time) {
+        build_rows = rows;
+        build_inserted = inserted;
+        build_time = time;
+    }
+
     void
     clear() override {
         Statistics::clear();
@@ -258,8 +291,11 @@ class HNSWStatistics : public Statistics {
  public:
     std::vector<size_t> distribution;
     size_t target_level;
-    size_t access_total;  // depend on subclass type
-    size_t ef_sum;        // updated in query
+    size_t access_total;    // depend on subclass type
+    size_t ef_sum;          // updated in query
+    size_t build_rows;      // updated in build
+    size_t build_inserted;  // updated in build
+    double build_time;      // updated in build (unit: ms)
 };
 
 /*
@@ -49,6 +49,13 @@ class VecIndex : public Index {
     virtual DatasetPtr
     Query(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) = 0;
 
+    // every row within config[IndexParams::range_search_radius] of each query, unsorted.
+    // hits of query i sit at [lims[i], lims[i + 1]) of meta::IDS / meta::DISTANCE, the nq + 1 lims at meta::LIMS
+    virtual DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config, const faiss::BitsetView bitset) {
+        KNOWHERE_THROW_MSG("range search is not supported by " + index_type_);
+    }
+
     virtual int64_t
     Dim() = 0;
 
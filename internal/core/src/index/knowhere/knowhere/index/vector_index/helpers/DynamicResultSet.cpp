@@ -9,14 +9,18 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "faiss/impl/AuxIndexStructures.h"
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/helpers/DynamicResultSet.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus {
 namespace knowhere {
@@ -192,5 +196,52 @@ ExchangeDataset(DynamicResultSegment& milvus_dataset, std::vector<faiss::RangeSe
     }
 }
 
+void
+MergeRangeSearchResults(std::vector<faiss::RangeSearchPartialResult*>& partial_results,
+                        faiss::RangeSearchResult& result) {
+    auto nq = result.nq;
+    std::fill_n(result.lims, nq + 1, 0);
+    for (auto prspr : partial_results) {
+        for (auto& qres : prspr->queries) {
+            result.lims[qres.qno] += qres.nres;
+        }
+    }
+    // turns the counts into offsets
+    result.do_allocation();
+
+    // one query may be split over several partial results, e.g. one per block of the base
+    std::vector<size_t> cursor(result.lims, result.lims + nq);
+    for (auto prspr : partial_results) {
+        size_t ofs = 0;
+        for (auto& qres : prspr->queries) {
+            auto& dst = cursor[qres.qno];
+            prspr->copy_range(ofs, qres.nres, result.labels + dst, result.distances + dst);
+            dst += qres.nres;
+            ofs += qres.nres;
+        }
+        delete prspr->res;
+        delete prspr;
+    }
+    partial_results.clear();
+}
+
+DatasetPtr
+GenRangeResultDataset(const faiss::RangeSearchResult& result) {
+    auto nq = result.nq;
+    auto total = result.lims[nq];
+    auto p_lims = static_cast<size_t*>(malloc(sizeof(size_t) * (nq + 1)));
+    auto p_id = static_cast<int64_t*>(malloc(sizeof(int64_t) * total));
+    auto p_dist = static_cast<float*>(malloc(sizeof(float) * total));
+    memcpy(p_lims, result.lims, sizeof(size_t) * (nq + 1));
+    memcpy(p_id, result.labels, sizeof(int64_t) * total);
+    memcpy(p_dist, result.distances, sizeof(float) * total);
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::LIMS, p_lims);
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 #include "faiss/impl/AuxIndexStructures.h"
+#include "knowhere/common/Dataset.h"
 #include "knowhere/common/Typedef.h"
 
 namespace milvus {
@@ -81,5 +82,19 @@ struct DynamicResultCollector {
 void
 ExchangeDataset(DynamicResultSegment& milvus_dataset, std::vector<faiss::RangeSearchPartialResult*>& faiss_dataset);
 
+/*
+ * Gather the per-thread partial results of a multi-query range search into result,
+ * whose lims must be allocated for result.nq queries. The partial results are released.
+ */
+void
+MergeRangeSearchResults(std::vector<faiss::RangeSearchPartialResult*>& partial_results,
+                        faiss::RangeSearchResult& result);
+
+/*
+ * Copy result into a dataset of meta::LIMS, meta::IDS and meta::DISTANCE, allocated by malloc like Query does
+ */
+DatasetPtr
+GenRangeResultDataset(const faiss::RangeSearchResult& result);
+
 }  // namespace knowhere
 }  // namespace milvus
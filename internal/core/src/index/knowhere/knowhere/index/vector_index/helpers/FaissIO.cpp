@@ -63,5 +63,15 @@ MemoryIOReader::operator()(void* ptr, size_t size, size_t nitems) {
     return nitems;
 }
 
+const uint8_t*
+MemoryIOReader::borrow(size_t size, size_t nitems) {
+    if (!borrowable || rp > total || size * nitems > total - rp) {
+        return nullptr;
+    }
+    auto ptr = data_ + rp;
+    rp += size * nitems;
+    return ptr;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -35,10 +35,15 @@ struct MemoryIOReader : public faiss::IOReader {
     uint8_t* data_;
     size_t rp = 0;
     size_t total = 0;
+    // data_ outlives whatever is read from it, see Binary::owned
+    bool borrowable = false;
 
     size_t
     operator()(void* ptr, size_t size, size_t nitems) override;
 
+    const uint8_t*
+    borrow(size_t size, size_t nitems) override;
+
     template <typename T>
     size_t
     read(T* ptr, size_t size, size_t nitems = 1) {
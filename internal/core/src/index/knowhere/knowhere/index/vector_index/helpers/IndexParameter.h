@@ -23,6 +23,7 @@ constexpr const char* TENSOR = "tensor";
 constexpr const char* ROWS = "rows";
 constexpr const char* IDS = "ids";
 constexpr const char* DISTANCE = "distance";
+constexpr const char* LIMS = "lims";
 constexpr const char* TOPK = "k";
 constexpr const char* DEVICEID = "gpu_id";
 };  // namespace meta
@@ -48,6 +49,9 @@ constexpr const char* candidate = "candidate_pool_size";
 constexpr const char* efConstruction = "efConstruction";
 constexpr const char* M = "M";
 constexpr const char* ef = "ef";
+constexpr const char* quantizer = "quantizer";  // FLAT, FP16 or SQ8
+constexpr const char* refine_k = "refine_k";    // candidates re-ranked against the raw rows
+constexpr const char* deterministic = "deterministic";  // same graph on every build
 
 // Annoy Params
 constexpr const char* n_trees = "n_trees";
@@ -80,6 +84,12 @@ constexpr const char* SUBSTRUCTURE = "SUBSTRUCTURE";
 constexpr const char* SUPERSTRUCTURE = "SUPERSTRUCTURE";
 }  // namespace Metric
 
+namespace Quantizer {
+constexpr const char* FLAT = "FLAT";
+constexpr const char* FP16 = "FP16";
+constexpr const char* SQ8 = "SQ8";
+}  // namespace Quantizer
+
 extern faiss::MetricType
 GetMetricType(const std::string& type);
 
@@ -11,6 +11,8 @@
 
 #include "knowhere/index/vector_index/impl/nsg/NSG.h"
 
+#include <faiss/FaissHook.h>
+#include <immintrin.h>
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
@@ -38,16 +40,22 @@ NsgIndex::NsgIndex(const size_t& dimension, const size_t& n, Metric_Type metric)
     } else if (metric == Metric_Type::Metric_Type_IP) {
         distance_ = new DistanceIP;
     }
+    visited_list_pool_ = new hnswlib::VisitedListPool(1, ntotal);
 }
 
 NsgIndex::~NsgIndex() {
     // delete[] ori_data_;
     delete[] ids_;
     delete distance_;
+    delete visited_list_pool_;
 }
 
 void
 NsgIndex::Build(size_t nb, float* data, const int64_t* ids, const BuildParams& parameters) {
+    if (visited_list_pool_ == nullptr || nb != ntotal) {
+        delete visited_list_pool_;
+        visited_list_pool_ = new hnswlib::VisitedListPool(1, nb);
+    }
     ntotal = nb;
     // ori_data_ = new float[ntotal * dimension];
     // memcpy((void*)ori_data_, (void*)data, sizeof(float) * ntotal * dimension);
@@ -350,9 +358,19 @@ NsgIndex::GetNeighbors(
         KNOWHERE_THROW_MSG("Build Error, search_length > ntotal");
     }
 
+    // the hooks are picked for the cpu once, IP distances are negated so that smaller is closer everywhere
+    bool is_ip = (metric_type == Metric_Type::Metric_Type_IP);
+    auto compare = is_ip ? faiss::fvec_inner_product : faiss::fvec_L2sqr;
+    auto distance = [&](const float* a, const float* b) {
+        float dist = compare(a, b, dimension);
+        return is_ip ? -dist : dist;
+    };
+
     std::vector<node_t> init_ids(buffer_size);
     resset.resize(buffer_size);
-    boost::dynamic_bitset<> has_calculated_dist{ntotal, 0};
+    hnswlib::VisitedList* vl = visited_list_pool_->getFreeVisitedList();
+    hnswlib::vl_type* visited = vl->mass;
+    hnswlib::vl_type visited_tag = vl->curV;
 
     {
         /*
@@ -363,17 +381,17 @@ NsgIndex::GetNeighbors(
         // Get all neighbors
         for (size_t i = 0; i < init_ids.size() && i < graph[navigation_point].size(); ++i) {
             init_ids[i] = graph[navigation_point][i];
-            has_calculated_dist[init_ids[i]] = true;
+            visited[init_ids[i]] = visited_tag;
             ++count;
         }
         while (count < buffer_size) {
             node_t id = rand_r(&seed) % ntotal;
-            if (has_calculated_dist[id]) {
+            if (visited[id] == visited_tag) {
                 continue;  // duplicate id
             }
             init_ids[count] = id;
             ++count;
-            has_calculated_dist[id] = true;
+            visited[id] = visited_tag;
         }
     }
 
@@ -385,14 +403,22 @@ NsgIndex::GetNeighbors(
             node_t id = init_ids[i];
 
             if (id >= static_cast<node_t>(ntotal)) {
+                visited_list_pool_->releaseVisitedList(vl);
                 KNOWHERE_THROW_MSG("Build Index Error, id > ntotal");
             }
+            if (i + 1 < init_ids.size()) {
+                _mm_prefetch(reinterpret_cast<const char*>(data + dimension * init_ids[i + 1]), _MM_HINT_T0);
+            }
 
-            float dist = distance_->Compare(data + id * dimension, query, dimension);
+            float dist = distance(data + id * dimension, query);
             resset[i] = Neighbor(id, dist, false);
         }
         std::sort(resset.begin(), resset.end());  // sort by distance
 
+        // unvisited neighbors of the expanded node, their vectors are prefetched before any distance is computed
+        std::vector<node_t> batch_ids;
+        std::vector<float> batch_dist;
+
         // search nearest neighbor
         size_t cursor = 0;
         while (cursor < buffer_size) {
@@ -403,20 +429,29 @@ NsgIndex::GetNeighbors(
 
                 node_t start_pos = resset[cursor].id;
                 auto& wait_for_search_node_vec = graph[start_pos];
+                batch_ids.clear();
                 for (node_t id : wait_for_search_node_vec) {
-                    if (has_calculated_dist[id]) {
+                    if (visited[id] == visited_tag) {
                         continue;
                     }
-                    has_calculated_dist[id] = true;
+                    visited[id] = visited_tag;
+                    _mm_prefetch(reinterpret_cast<const char*>(data + dimension * id), _MM_HINT_T0);
+                    batch_ids.push_back(id);
+                }
+                batch_dist.resize(batch_ids.size());
+                for (size_t j = 0; j < batch_ids.size(); ++j) {
+                    batch_dist[j] = distance(query, data + dimension * batch_ids[j]);
+                }
 
-                    float dist = distance_->Compare(query, data + dimension * id, dimension);
+                for (size_t j = 0; j < batch_ids.size(); ++j) {
+                    float dist = batch_dist[j];
 
                     if (dist >= resset[buffer_size - 1].distance) {
                         continue;
                     }
 
                     //// difference from other GetNeighbors
-                    Neighbor nn(id, dist, false);
+                    Neighbor nn(batch_ids[j], dist, false);
                     ///////////////////////////////////////
 
                     size_t pos = InsertIntoPool(resset.data(), buffer_size, nn);  // replace with a closer node
@@ -442,6 +477,7 @@ NsgIndex::GetNeighbors(
             }
         }
     }
+    visited_list_pool_->releaseVisitedList(vl);
 }
 
 void
@@ -921,6 +957,7 @@ NsgIndex::GetSize() {
     ret += ntotal * dimension * sizeof(float);
     ret += ntotal * sizeof(int64_t);
     ret += sizeof(*distance_);
+    ret += visited_list_pool_ ? visited_list_pool_->GetSize() : 0;
     for (auto& v : nsg) {
         ret += v.size() * sizeof(node_t);
     }
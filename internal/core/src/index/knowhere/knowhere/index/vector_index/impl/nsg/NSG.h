@@ -19,6 +19,7 @@
 
 #include "Distance.h"
 #include "Neighbor.h"
+#include "hnswlib/visited_list_pool.h"
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
@@ -52,6 +53,8 @@ class NsgIndex {
     size_t ntotal;        // totabl nb of indexed vectors
     int32_t metric_type;  // enum Metric_Type
     Distance* distance_;
+    // visited marks of the graph searches, one list per concurrent search
+    hnswlib::VisitedListPool* visited_list_pool_ = nullptr;
 
     // float* ori_data_;
     int64_t* ids_;
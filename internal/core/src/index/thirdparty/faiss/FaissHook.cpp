@@ -9,6 +9,7 @@
 #include <faiss/impl/ScalarQuantizerDC.h>
 #include <faiss/impl/ScalarQuantizerDC_avx.h>
 #include <faiss/impl/ScalarQuantizerDC_avx512.h>
+#include <faiss/utils/BinaryDistance.h>
 #include <faiss/utils/distances.h>
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
@@ -26,6 +27,17 @@ fvec_func_ptr fvec_L2sqr = fvec_L2sqr_avx;
 fvec_func_ptr fvec_L1 = fvec_L1_avx;
 fvec_func_ptr fvec_Linf = fvec_Linf_avx;
 
+/* binary distances start portable, hook_init upgrades them */
+bvec_hamming_func_ptr bvec_hamming = xor_popcnt;
+bvec_jaccard_func_ptr bvec_jaccard_dis = bvec_jaccard;
+bvec_subset_func_ptr bvec_is_subset = is_subset;
+
+/* quantized distances start portable, hook_init upgrades them */
+fp16vec_func_ptr fp16vec_L2sqr = fp16vec_L2sqr_ref;
+fp16vec_func_ptr fp16vec_inner_product = fp16vec_inner_product_ref;
+sq8vec_func_ptr sq8vec_L2sqr = sq8vec_L2sqr_ref;
+sq8vec_func_ptr sq8vec_inner_product = sq8vec_inner_product_ref;
+
 sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_computer_avx;
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
@@ -41,6 +53,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return instruction_set_inst.AVX512VPOPCNTDQ();
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -71,6 +90,22 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_avx512;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx512;
 
+        /* for binary, lookup popcount is no faster than AVX2 without VPOPCNTDQ */
+        if (support_avx512_vpopcntdq()) {
+            bvec_hamming = xor_popcnt_AVX512VPOPCNTDQ;
+            bvec_jaccard_dis = jaccard_AVX512VPOPCNTDQ;
+        } else {
+            bvec_hamming = xor_popcnt_AVX2_lookup;
+            bvec_jaccard_dis = jaccard_AVX2_lookup;
+        }
+        bvec_is_subset = is_subset_AVX512;
+
+        /* for quantized HNSW */
+        fp16vec_L2sqr = fp16vec_L2sqr_avx512;
+        fp16vec_inner_product = fp16vec_inner_product_avx512;
+        sq8vec_L2sqr = sq8vec_L2sqr_avx512;
+        sq8vec_inner_product = sq8vec_inner_product_avx512;
+
         cpu_flag = "AVX512";
     } else if (support_avx2()) {
         /* for IVFFLAT */
@@ -84,6 +119,17 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_avx;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+        /* for binary */
+        bvec_hamming = xor_popcnt_AVX2_lookup;
+        bvec_jaccard_dis = jaccard_AVX2_lookup;
+        bvec_is_subset = is_subset_AVX2;
+
+        /* for quantized HNSW */
+        fp16vec_L2sqr = fp16vec_L2sqr_avx;
+        fp16vec_inner_product = fp16vec_inner_product_avx;
+        sq8vec_L2sqr = sq8vec_L2sqr_avx;
+        sq8vec_inner_product = sq8vec_inner_product_avx;
+
         cpu_flag = "AVX2";
     } else if (support_sse()) {
         /* for IVFFLAT */
@@ -97,6 +143,17 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_ref;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_ref;
 
+        /* for binary */
+        bvec_hamming = xor_popcnt;
+        bvec_jaccard_dis = bvec_jaccard;
+        bvec_is_subset = is_subset;
+
+        /* for quantized HNSW */
+        fp16vec_L2sqr = fp16vec_L2sqr_ref;
+        fp16vec_inner_product = fp16vec_inner_product_ref;
+        sq8vec_L2sqr = sq8vec_L2sqr_ref;
+        sq8vec_inner_product = sq8vec_inner_product_ref;
+
         cpu_flag = "SSE42";
     } else {
         cpu_flag = "UNSUPPORTED";
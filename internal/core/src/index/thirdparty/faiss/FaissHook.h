@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <faiss/impl/ScalarQuantizer.h>
 #include <faiss/impl/ScalarQuantizerOp.h>
@@ -14,6 +15,13 @@ namespace faiss {
 
 typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
 
+typedef int (*bvec_hamming_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+typedef float (*bvec_jaccard_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+typedef bool (*bvec_subset_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+
+typedef float (*fp16vec_func_ptr)(const uint16_t*, const uint16_t*, size_t);
+typedef float (*sq8vec_func_ptr)(const uint8_t*, const uint8_t*, const float*, const float*, size_t);
+
 typedef SQDistanceComputer* (*sq_get_distance_computer_func_ptr)(MetricType, QuantizerType, size_t, const std::vector<float>&);
 typedef Quantizer* (*sq_sel_quantizer_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
 typedef InvertedListScanner* (*sq_sel_inv_list_scanner_func_ptr)(MetricType, const ScalarQuantizer*, const Index*, size_t, bool, bool);
@@ -27,11 +35,24 @@ extern fvec_func_ptr fvec_L2sqr;
 extern fvec_func_ptr fvec_L1;
 extern fvec_func_ptr fvec_Linf;
 
+/* binary distances for codes of any size, Tanimoto derives from Jaccard,
+ * superstructure is subset with the arguments swapped */
+extern bvec_hamming_func_ptr bvec_hamming;
+extern bvec_jaccard_func_ptr bvec_jaccard_dis;
+extern bvec_subset_func_ptr bvec_is_subset;
+
+/* distances between two quantized vectors, see utils/distances.h */
+extern fp16vec_func_ptr fp16vec_L2sqr;
+extern fp16vec_func_ptr fp16vec_inner_product;
+extern sq8vec_func_ptr sq8vec_L2sqr;
+extern sq8vec_func_ptr sq8vec_inner_product;
+
 extern sq_get_distance_computer_func_ptr sq_get_distance_computer;
 extern sq_sel_quantizer_func_ptr sq_sel_quantizer;
 extern sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner;
 
 extern bool support_avx512();
+extern bool support_avx512_vpopcntdq();
 extern bool support_avx2();
 extern bool support_sse();
 
@@ -515,6 +515,35 @@ void ReadOnlyInvertedLists::resize (size_t , size_t )
 }
 
 
+/*****************************************
+ * BorrowedInvertedLists implementation
+ ******************************************/
+
+BorrowedInvertedLists::BorrowedInvertedLists (size_t nlist, size_t code_size):
+    ReadOnlyInvertedLists (nlist, code_size),
+    codes (nlist, nullptr),
+    offsets (nlist + 1, 0)
+{}
+
+size_t BorrowedInvertedLists::list_size(size_t list_no) const
+{
+    FAISS_ASSERT(list_no < nlist);
+    return offsets[list_no + 1] - offsets[list_no];
+}
+
+const uint8_t * BorrowedInvertedLists::get_codes (size_t list_no) const
+{
+    FAISS_ASSERT(list_no < nlist);
+    return codes[list_no];
+}
+
+const InvertedLists::idx_t * BorrowedInvertedLists::get_ids (size_t list_no) const
+{
+    FAISS_ASSERT(list_no < nlist);
+    return ids.data() + offsets[list_no];
+}
+
+
 
 /*****************************************
  * HStackInvertedLists implementation
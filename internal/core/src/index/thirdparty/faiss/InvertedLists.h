@@ -328,6 +328,22 @@ struct ReadOnlyInvertedLists: InvertedLists {
 };
 
 
+/// inverted lists read with IO_FLAG_ZERO_COPY: the codes point into the
+/// serialized index, which must outlive them. The ids are copied, they are
+/// small next to the codes and not aligned in the buffer
+struct BorrowedInvertedLists: ReadOnlyInvertedLists {
+    std::vector<const uint8_t *> codes;
+    std::vector<size_t> offsets;  ///< start of each list in ids, size nlist + 1
+    std::vector<idx_t> ids;
+
+    BorrowedInvertedLists (size_t nlist, size_t code_size);
+
+    size_t list_size(size_t list_no) const override;
+    const uint8_t * get_codes (size_t list_no) const override;
+    const idx_t * get_ids (size_t list_no) const override;
+};
+
+
 /// Horizontal stack of inverted lists
 struct HStackInvertedLists: ReadOnlyInvertedLists {
 
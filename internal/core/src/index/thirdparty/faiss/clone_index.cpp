@@ -106,6 +106,14 @@ Index *Cloner::clone_Index (const Index *index)
         } else if (auto *ails = dynamic_cast<const ReadOnlyArrayInvertedLists*>(ivf->invlists)) {
             res->invlists = new ReadOnlyArrayInvertedLists(*ails);
             res->own_invlists = true;
+        } else if (auto *bils = dynamic_cast<const BorrowedInvertedLists*>(ivf->invlists)) {
+            // the clone must not depend on the buffer of the original
+            auto ails = new ArrayInvertedLists(bils->nlist, bils->code_size);
+            for (size_t i = 0; i < bils->nlist; i++) {
+                ails->add_entries(i, bils->list_size(i), bils->get_ids(i), bils->get_codes(i));
+            }
+            res->invlists = ails;
+            res->own_invlists = true;
         } else {
             FAISS_THROW_MSG( "clone not supported for this type of inverted lists");
         }
@@ -11,6 +11,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -226,6 +227,29 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
         READANDCHECK((uint8_t *) ails->pin_readonly_codes->data, n * code_size);
 #endif
         return ails;
+    } else if (h == fourcc ("ilar") && (io_flags & IO_FLAG_ZERO_COPY) &&
+               f->borrow (1, 0) != nullptr) {
+        size_t nlist, code_size;
+        READ1 (nlist);
+        READ1 (code_size);
+        std::vector<size_t> sizes (nlist);
+        read_ArrayInvertedLists_sizes (f, sizes);
+        std::unique_ptr<BorrowedInvertedLists> ails (
+              new BorrowedInvertedLists (nlist, code_size));
+        for (size_t i = 0; i < nlist; i++) {
+            ails->offsets[i + 1] = ails->offsets[i] + sizes[i];
+        }
+        ails->ids.resize (ails->offsets[nlist]);
+        for (size_t i = 0; i < nlist; i++) {
+            size_t n = sizes[i];
+            if (n > 0) {
+                ails->codes[i] = f->borrow (code_size, n);
+                FAISS_THROW_IF_NOT_MSG (ails->codes[i],
+                                        "inverted lists truncated");
+                READANDCHECK (ails->ids.data() + ails->offsets[i], n);
+            }
+        }
+        return ails.release();
     } else if (h == fourcc ("ilar") && !(io_flags & IO_FLAG_MMAP)) {
         auto ails = new ArrayInvertedLists (0, 0);
         READ1 (ails->nlist);
@@ -200,8 +200,10 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
     if (ils == nullptr) {
         uint32_t h = fourcc ("il00");
         WRITE1 (h);
-    } else if (const auto & ails =
-               dynamic_cast<const ArrayInvertedLists *>(ils)) {
+    } else if (dynamic_cast<const ArrayInvertedLists *>(ils) ||
+               dynamic_cast<const BorrowedInvertedLists *>(ils)) {
+        // borrowed lists were read from this layout and are written back in it
+        const InvertedLists *ails = ils;
         uint32_t h = fourcc ("ilar");
         WRITE1 (h);
         WRITE1 (ails->nlist);
@@ -209,7 +211,7 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
         // here we store either as a full or a sparse data buffer
         size_t n_non0 = 0;
         for (size_t i = 0; i < ails->nlist; i++) {
-            if (ails->ids[i].size() > 0)
+            if (ails->list_size(i) > 0)
                 n_non0++;
         }
         if (n_non0 > ails->nlist / 2) {
@@ -217,7 +219,7 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
             WRITE1 (list_type);
             std::vector<size_t> sizes;
             for (size_t i = 0; i < ails->nlist; i++) {
-                sizes.push_back (ails->ids[i].size());
+                sizes.push_back (ails->list_size(i));
             }
             WRITEVECTOR (sizes);
         } else {
@@ -225,7 +227,7 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
             WRITE1 (list_type);
             std::vector<size_t> sizes;
             for (size_t i = 0; i < ails->nlist; i++) {
-                size_t n = ails->ids[i].size();
+                size_t n = ails->list_size(i);
                 if (n > 0) {
                     sizes.push_back (i);
                     sizes.push_back (n);
@@ -235,10 +237,10 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
         }
         // make a single contiguous data buffer (useful for mmapping)
         for (size_t i = 0; i < ails->nlist; i++) {
-            size_t n = ails->ids[i].size();
+            size_t n = ails->list_size(i);
             if (n > 0) {
-                WRITEANDCHECK (ails->codes[i].data(), n * ails->code_size);
-                WRITEANDCHECK (ails->ids[i].data(), n);
+                WRITEANDCHECK (ails->get_codes(i), n * ails->code_size);
+                WRITEANDCHECK (ails->get_ids(i), n);
             }
         }
     } else if (const auto & oa =
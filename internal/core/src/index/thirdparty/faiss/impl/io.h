@@ -36,6 +36,11 @@ struct IOReader {
     // return a file number that can be memory-mapped
     virtual int fileno ();
 
+    // return a pointer to the next size * nitems bytes and skip them,
+    // without copying. nullptr if the reader does not keep its data in a
+    // buffer that outlives the objects read from it
+    virtual const uint8_t *borrow (size_t size, size_t nitems);
+
     virtual ~IOReader() {}
 };
 
@@ -51,6 +51,9 @@ const int IO_FLAG_READ_ONLY = 2;
 // strip directory component from ondisk filename, and assume it's in
 // the same directory as the index file
 const int IO_FLAG_ONDISK_SAME_DIR = 4;
+// point the inverted list codes into the reader's buffer instead of copying
+// them (see IOReader::borrow), the buffer must outlive the index
+const int IO_FLAG_ZERO_COPY = 8;
 
 Index *read_index (const char *fname, int io_flags = 0);
 Index *read_index (FILE * f, int io_flags = 0);
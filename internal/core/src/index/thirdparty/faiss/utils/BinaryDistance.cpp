@@ -123,6 +123,38 @@ float bvec_jaccard (const uint8_t* data1, const uint8_t* data2, const size_t cod
 #undef fun_u8
 }
 
+/*
+ * Computer over a hooked kernel, taken for codes longer than the
+ * fixed-size unrolled computers cover. The hook is read on every call,
+ * so it follows whatever hook_init picked; swap_args passes the stored
+ * code second.
+ */
+template <class R, R (**hook)(const uint8_t *, const uint8_t *, size_t), bool swap_args = false>
+struct ComputerHook {
+    const uint8_t *a;
+    int n;
+
+    ComputerHook () {}
+
+    ComputerHook (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    R compute (const uint8_t *b8) const {
+        return swap_args ? (*hook)(b8, a, n) : (*hook)(a, b8, n);
+    }
+};
+
+using HammingComputerHook = ComputerHook<int, &bvec_hamming>;
+using JaccardComputerHook = ComputerHook<float, &bvec_jaccard_dis>;
+using SubstructureComputerHook = ComputerHook<bool, &bvec_is_subset>;
+using SuperstructureComputerHook = ComputerHook<bool, &bvec_is_subset, true>;
+
 template <class T>
 static
 void binary_distance_knn_mc(
@@ -264,12 +296,9 @@ void binary_distance_knn_mc (
         binary_distance_knn_mc_Substructure(16);
         binary_distance_knn_mc_Substructure(32);
         binary_distance_knn_mc_Substructure(64);
-        binary_distance_knn_mc_Substructure(128);
-        binary_distance_knn_mc_Substructure(256);
-        binary_distance_knn_mc_Substructure(512);
 #undef binary_distance_knn_mc_Substructure
         default:
-            binary_distance_knn_mc<faiss::SubstructureComputerDefault>
+            binary_distance_knn_mc<SubstructureComputerHook>
                     (ncodes, a, b, na, nb, k, distances, labels, bitset);
             break;
         }
@@ -286,12 +315,9 @@ void binary_distance_knn_mc (
         binary_distance_knn_mc_Superstructure(16);
         binary_distance_knn_mc_Superstructure(32);
         binary_distance_knn_mc_Superstructure(64);
-        binary_distance_knn_mc_Superstructure(128);
-        binary_distance_knn_mc_Superstructure(256);
-        binary_distance_knn_mc_Superstructure(512);
 #undef binary_distance_knn_mc_Superstructure
         default:
-            binary_distance_knn_mc<faiss::SuperstructureComputerDefault>
+            binary_distance_knn_mc<SuperstructureComputerHook>
                     (ncodes, a, b, na, nb, k, distances, labels, bitset);
             break;
         }
@@ -421,56 +447,43 @@ void binary_distance_knn_hc (
 {
     switch (metric_type) {
     case METRIC_Jaccard: {
-        if (support_avx2() && ncodes > 64) {
-            binary_distance_knn_hc<C, faiss::JaccardComputerAVX2>
-                    (ncodes, ha, a, b, nb, bitset);
-        } else {
-            switch (ncodes) {
+        switch (ncodes) {
 #define binary_distance_knn_hc_jaccard(ncodes) \
-            case ncodes: \
-                binary_distance_knn_hc<C, faiss::JaccardComputer ## ncodes> \
-                    (ncodes, ha, a, b, nb, bitset); \
-                break;
-            binary_distance_knn_hc_jaccard(8);
-            binary_distance_knn_hc_jaccard(16);
-            binary_distance_knn_hc_jaccard(32);
-            binary_distance_knn_hc_jaccard(64);
-            binary_distance_knn_hc_jaccard(128);
-            binary_distance_knn_hc_jaccard(256);
-            binary_distance_knn_hc_jaccard(512);
+        case ncodes: \
+            binary_distance_knn_hc<C, faiss::JaccardComputer ## ncodes> \
+                (ncodes, ha, a, b, nb, bitset); \
+            break;
+        binary_distance_knn_hc_jaccard(8);
+        binary_distance_knn_hc_jaccard(16);
+        binary_distance_knn_hc_jaccard(32);
+        binary_distance_knn_hc_jaccard(64);
 #undef binary_distance_knn_hc_jaccard
-            default:
-                binary_distance_knn_hc<C, faiss::JaccardComputerDefault>
-                        (ncodes, ha, a, b, nb, bitset);
-                break;
-            }
+        default:
+            binary_distance_knn_hc<C, JaccardComputerHook>
+                    (ncodes, ha, a, b, nb, bitset);
+            break;
         }
         break;
     }
 
     case METRIC_Hamming: {
-        if (support_avx2() && ncodes > 64) {
-            binary_distance_knn_hc<C, faiss::HammingComputerAVX2>
-                    (ncodes, ha, a, b, nb, bitset);
-        } else {
-            switch (ncodes) {
+        switch (ncodes) {
 #define binary_distance_knn_hc_hamming(ncodes) \
-            case ncodes: \
-                binary_distance_knn_hc<C, faiss::HammingComputer ## ncodes> \
-                    (ncodes, ha, a, b, nb, bitset); \
-                break;
-            binary_distance_knn_hc_hamming(4);
-            binary_distance_knn_hc_hamming(8);
-            binary_distance_knn_hc_hamming(16);
-            binary_distance_knn_hc_hamming(20);
-            binary_distance_knn_hc_hamming(32);
-            binary_distance_knn_hc_hamming(64);
+        case ncodes: \
+            binary_distance_knn_hc<C, faiss::HammingComputer ## ncodes> \
+                (ncodes, ha, a, b, nb, bitset); \
+            break;
+        binary_distance_knn_hc_hamming(4);
+        binary_distance_knn_hc_hamming(8);
+        binary_distance_knn_hc_hamming(16);
+        binary_distance_knn_hc_hamming(20);
+        binary_distance_knn_hc_hamming(32);
+        binary_distance_knn_hc_hamming(64);
 #undef binary_distance_knn_hc_hamming
-            default:
-                binary_distance_knn_hc<C, faiss::HammingComputerDefault>
-                        (ncodes, ha, a, b, nb, bitset);
-                break;
-            }
+        default:
+            binary_distance_knn_hc<C, HammingComputerHook>
+                    (ncodes, ha, a, b, nb, bitset);
+            break;
         }
         break;
     }
@@ -554,29 +567,21 @@ void binary_range_search(
     case METRIC_Tanimoto:
         radius = Tanimoto_2_Jaccard(radius);
     case METRIC_Jaccard: {
-        if (support_avx2() && ncodes > 64) {
-            binary_range_search<C, T, faiss::JaccardComputerAVX2>
-                    (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
-        } else {
-            switch (ncodes) {
+        switch (ncodes) {
 #define binary_range_search_jaccard(ncodes) \
-            case ncodes: \
-                binary_range_search<C, T, faiss::JaccardComputer ## ncodes> \
-                    (a, b, na, nb, ncodes, radius, result, buffer_size, bitset); \
-                break;
-            binary_range_search_jaccard(8);
-            binary_range_search_jaccard(16);
-            binary_range_search_jaccard(32);
-            binary_range_search_jaccard(64);
-            binary_range_search_jaccard(128);
-            binary_range_search_jaccard(256);
-            binary_range_search_jaccard(512);
+        case ncodes: \
+            binary_range_search<C, T, faiss::JaccardComputer ## ncodes> \
+                (a, b, na, nb, ncodes, radius, result, buffer_size, bitset); \
+            break;
+        binary_range_search_jaccard(8);
+        binary_range_search_jaccard(16);
+        binary_range_search_jaccard(32);
+        binary_range_search_jaccard(64);
 #undef binary_range_search_jaccard
-            default:
-                binary_range_search<C, T, faiss::JaccardComputerDefault>
-                        (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
-                break;
-            }
+        default:
+            binary_range_search<C, T, JaccardComputerHook>
+                    (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
+            break;
         }
         if (METRIC_Tanimoto == metric_type) {
             for (auto &prspr: result) {
@@ -592,28 +597,23 @@ void binary_range_search(
     }
 
     case METRIC_Hamming: {
-        if (support_avx2() && ncodes > 64) {
-            binary_range_search<C, T, faiss::HammingComputerAVX2>
-                    (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
-        } else {
-            switch (ncodes) {
+        switch (ncodes) {
 #define binary_range_search_hamming(ncodes) \
-            case ncodes: \
-                binary_range_search<C, T, faiss::HammingComputer ## ncodes> \
-                    (a, b, na, nb, ncodes, radius, result, buffer_size, bitset); \
-                break;
-            binary_range_search_hamming(4);
-            binary_range_search_hamming(8);
-            binary_range_search_hamming(16);
-            binary_range_search_hamming(20);
-            binary_range_search_hamming(32);
-            binary_range_search_hamming(64);
+        case ncodes: \
+            binary_range_search<C, T, faiss::HammingComputer ## ncodes> \
+                (a, b, na, nb, ncodes, radius, result, buffer_size, bitset); \
+            break;
+        binary_range_search_hamming(4);
+        binary_range_search_hamming(8);
+        binary_range_search_hamming(16);
+        binary_range_search_hamming(20);
+        binary_range_search_hamming(32);
+        binary_range_search_hamming(64);
 #undef binary_range_search_hamming
-            default:
-                binary_range_search<C, T, faiss::HammingComputerDefault>
-                        (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
-                break;
-            }
+        default:
+            binary_range_search<C, T, HammingComputerHook>
+                    (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
+            break;
         }
         break;
     }
@@ -629,12 +629,9 @@ void binary_range_search(
         binary_range_search_superstructure(16);
         binary_range_search_superstructure(32);
         binary_range_search_superstructure(64);
-        binary_range_search_superstructure(128);
-        binary_range_search_superstructure(256);
-        binary_range_search_superstructure(512);
 #undef binary_range_search_superstructure
         default:
-            binary_range_search<C, T, faiss::SuperstructureComputerDefault>
+            binary_range_search<C, T, SuperstructureComputerHook>
                     (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
             break;
         }
@@ -652,12 +649,9 @@ void binary_range_search(
         binary_range_search_substructure(16);
         binary_range_search_substructure(32);
         binary_range_search_substructure(64);
-        binary_range_search_substructure(128);
-        binary_range_search_substructure(256);
-        binary_range_search_substructure(512);
 #undef binary_range_search_substructure
         default:
-            binary_range_search<C, T, faiss::SubstructureComputerDefault>
+            binary_range_search<C, T, SubstructureComputerHook>
                     (a, b, na, nb, ncodes, radius, result, buffer_size, bitset);
             break;
         }
@@ -48,6 +48,32 @@ float fvec_Linf_sse (
         size_t d);
 #endif
 
+/* distances between two quantized vectors, fp16 codes or one byte per
+ * component that decodes to vmin[i] + (code + 0.5) * scale[i] */
+float fp16vec_L2sqr_ref (
+        const uint16_t * x,
+        const uint16_t * y,
+        size_t d);
+
+float fp16vec_inner_product_ref (
+        const uint16_t * x,
+        const uint16_t * y,
+        size_t d);
+
+float sq8vec_L2sqr_ref (
+        const uint8_t * x,
+        const uint8_t * y,
+        const float * vmin,
+        const float * scale,
+        size_t d);
+
+float sq8vec_inner_product_ref (
+        const uint8_t * x,
+        const uint8_t * y,
+        const float * vmin,
+        const float * scale,
+        size_t d);
+
 /** Compute pairwise distances between sets of vectors
  *
  * @param d     dimension of the vectors
@@ -31,6 +31,19 @@ fvec_L1_avx(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx(const float* x, const float* y, size_t d);
 
+/// distances between quantized vectors, see distances.h
+float
+fp16vec_L2sqr_avx(const uint16_t* x, const uint16_t* y, size_t d);
+
+float
+fp16vec_inner_product_avx(const uint16_t* x, const uint16_t* y, size_t d);
+
+float
+sq8vec_L2sqr_avx(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d);
+
+float
+sq8vec_inner_product_avx(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d);
+
 /// binary distance
 int
 xor_popcnt_AVX2_lookup(const uint8_t* data1, const uint8_t* data2, const size_t n);
@@ -48,4 +61,12 @@ popcnt_AVX2_lookup(const uint8_t* data, const size_t n);
 float
 jaccard__AVX2(const uint8_t * a, const uint8_t * b, size_t n);
 
+/// jaccard in a single pass over the codes
+float
+jaccard_AVX2_lookup(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+/// whether data1 is a subset of data2
+bool
+is_subset_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
 } // namespace faiss
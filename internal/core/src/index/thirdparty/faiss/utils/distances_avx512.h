@@ -30,6 +30,19 @@ fvec_L1_avx512(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx512(const float* x, const float* y, size_t d);
 
+/// distances between quantized vectors, see distances.h
+float
+fp16vec_L2sqr_avx512(const uint16_t* x, const uint16_t* y, size_t d);
+
+float
+fp16vec_inner_product_avx512(const uint16_t* x, const uint16_t* y, size_t d);
+
+float
+sq8vec_L2sqr_avx512(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d);
+
+float
+sq8vec_inner_product_avx512(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d);
+
 /// popcnt
 int
 popcnt_AVX512VBMI_lookup(const uint8_t* data, const size_t n);
@@ -47,4 +60,15 @@ and_popcnt_AVX512VBMI_lookup(const uint8_t* data1, const uint8_t* data2, const s
 float
 jaccard__AVX512(const uint8_t * a, const uint8_t * b, size_t n);
 
+/// binary distances for arbitrary code sizes, need AVX512_VPOPCNTDQ on top of AVX512F/BW
+int
+xor_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+float
+jaccard_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
+/// whether data1 is a subset of data2
+bool
+is_subset_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n);
+
 } // namespace faiss
@@ -124,6 +124,59 @@ void fvec_L2sqr_ny_ref (float * dis,
 }
 
 
+float fp16vec_L2sqr_ref (const uint16_t * x,
+                         const uint16_t * y,
+                         size_t d)
+{
+    float res = 0;
+    for (size_t i = 0; i < d; i++) {
+        const float tmp = decode_fp16 (x[i]) - decode_fp16 (y[i]);
+        res += tmp * tmp;
+    }
+    return res;
+}
+
+float fp16vec_inner_product_ref (const uint16_t * x,
+                                 const uint16_t * y,
+                                 size_t d)
+{
+    float res = 0;
+    for (size_t i = 0; i < d; i++)
+        res += decode_fp16 (x[i]) * decode_fp16 (y[i]);
+    return res;
+}
+
+float sq8vec_L2sqr_ref (const uint8_t * x,
+                        const uint8_t * y,
+                        const float * vmin,
+                        const float * scale,
+                        size_t d)
+{
+    // the offsets cancel out
+    float res = 0;
+    for (size_t i = 0; i < d; i++) {
+        const float tmp = ((int)x[i] - (int)y[i]) * scale[i];
+        res += tmp * tmp;
+    }
+    return res;
+}
+
+float sq8vec_inner_product_ref (const uint8_t * x,
+                                const uint8_t * y,
+                                const float * vmin,
+                                const float * scale,
+                                size_t d)
+{
+    float res = 0;
+    for (size_t i = 0; i < d; i++) {
+        const float xi = vmin[i] + (x[i] + 0.5f) * scale[i];
+        const float yi = vmin[i] + (y[i] + 0.5f) * scale[i];
+        res += xi * yi;
+    }
+    return res;
+}
+
+
 
 
 /*********************************************************
@@ -253,6 +253,94 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+static inline float hsum256_ps (__m256 v) {
+    __m128 msum = _mm256_extractf128_ps(v, 1);
+    msum +=       _mm256_extractf128_ps(v, 0);
+    msum = _mm_hadd_ps (msum, msum);
+    msum = _mm_hadd_ps (msum, msum);
+    return  _mm_cvtss_f32 (msum);
+}
+
+/* quantized vectors: the last d % 8 components are copied into zero
+ * padded buffers, zero codes with zero scale decode to 0 on both sides */
+
+static inline __m256 load_fp16_8 (const uint16_t* x) {
+    return _mm256_cvtph_ps (_mm_loadu_si128 ((const __m128i*)x));
+}
+
+static inline __m256 load_sq8_8 (const uint8_t* x) {
+    return _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((const __m128i*)x)));
+}
+
+float fp16vec_L2sqr_avx (const uint16_t* x, const uint16_t* y, size_t d) {
+    __m256 msum = _mm256_setzero_ps();
+    for (; d >= 8; d -= 8, x += 8, y += 8) {
+        const __m256 a_m_b = load_fp16_8 (x) - load_fp16_8 (y);
+        msum += a_m_b * a_m_b;
+    }
+    if (d > 0) {
+        uint16_t bx[8] = {0}, by[8] = {0};
+        memcpy (bx, x, d * sizeof(uint16_t));
+        memcpy (by, y, d * sizeof(uint16_t));
+        const __m256 a_m_b = load_fp16_8 (bx) - load_fp16_8 (by);
+        msum += a_m_b * a_m_b;
+    }
+    return hsum256_ps (msum);
+}
+
+float fp16vec_inner_product_avx (const uint16_t* x, const uint16_t* y, size_t d) {
+    __m256 msum = _mm256_setzero_ps();
+    for (; d >= 8; d -= 8, x += 8, y += 8) {
+        msum += load_fp16_8 (x) * load_fp16_8 (y);
+    }
+    if (d > 0) {
+        uint16_t bx[8] = {0}, by[8] = {0};
+        memcpy (bx, x, d * sizeof(uint16_t));
+        memcpy (by, y, d * sizeof(uint16_t));
+        msum += load_fp16_8 (bx) * load_fp16_8 (by);
+    }
+    return hsum256_ps (msum);
+}
+
+float sq8vec_L2sqr_avx (const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    __m256 msum = _mm256_setzero_ps();
+    for (; d >= 8; d -= 8, x += 8, y += 8, scale += 8) {
+        const __m256 a_m_b = (load_sq8_8 (x) - load_sq8_8 (y)) * _mm256_loadu_ps (scale);
+        msum += a_m_b * a_m_b;
+    }
+    if (d > 0) {
+        uint8_t bx[8] = {0}, by[8] = {0};
+        memcpy (bx, x, d);
+        memcpy (by, y, d);
+        const __m256 a_m_b = (load_sq8_8 (bx) - load_sq8_8 (by)) * masked_read_8 (d, scale);
+        msum += a_m_b * a_m_b;
+    }
+    return hsum256_ps (msum);
+}
+
+float sq8vec_inner_product_avx (const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    const __m256 half = _mm256_set1_ps (0.5f);
+    __m256 msum = _mm256_setzero_ps();
+    for (; d >= 8; d -= 8, x += 8, y += 8, vmin += 8, scale += 8) {
+        const __m256 mmin = _mm256_loadu_ps (vmin);
+        const __m256 mscale = _mm256_loadu_ps (scale);
+        const __m256 mx = mmin + (load_sq8_8 (x) + half) * mscale;
+        const __m256 my = mmin + (load_sq8_8 (y) + half) * mscale;
+        msum += mx * my;
+    }
+    if (d > 0) {
+        uint8_t bx[8] = {0}, by[8] = {0};
+        memcpy (bx, x, d);
+        memcpy (by, y, d);
+        const __m256 mmin = masked_read_8 (d, vmin);
+        const __m256 mscale = masked_read_8 (d, scale);
+        const __m256 mx = mmin + (load_sq8_8 (bx) + half) * mscale;
+        const __m256 my = mmin + (load_sq8_8 (by) + half) * mscale;
+        msum += mx * my;
+    }
+    return hsum256_ps (msum);
+}
+
 const __m256i lookup = _mm256_setr_epi8(
                 /* 0 */ 0, /* 1 */ 1, /* 2 */ 1, /* 3 */ 2,
                 /* 4 */ 1, /* 5 */ 2, /* 6 */ 2, /* 7 */ 3,
@@ -480,6 +568,90 @@ jaccard__AVX2(const uint8_t * a, const uint8_t * b, size_t n) {
     return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
 }
 
+namespace {
+
+inline __m256i
+load256(const uint8_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+inline uint64_t
+load64(const uint8_t* p) {
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+/* per byte popcount by vpshufb */
+inline __m256i
+popcnt256_epi8(__m256i v) {
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+    const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+    return _mm256_add_epi8(lo, hi);
+}
+
+inline uint64_t
+hsum256_epi64(__m256i v) {
+    return _mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1) +
+           _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3);
+}
+
+} // namespace
+
+float
+jaccard_AVX2_lookup(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    // both counts in one pass, byte counters are widened every 31 vectors before they can overflow
+    size_t i = 0;
+    __m256i acc_num = _mm256_setzero_si256();
+    __m256i acc_den = _mm256_setzero_si256();
+    while (i + 32 <= n) {
+        __m256i local_num = _mm256_setzero_si256();
+        __m256i local_den = _mm256_setzero_si256();
+        for (int k = 0; k < 31 && i + 32 <= n; k++, i += 32) {
+            const __m256i a = load256(data1 + i);
+            const __m256i b = load256(data2 + i);
+            local_num = _mm256_add_epi8(local_num, popcnt256_epi8(_mm256_and_si256(a, b)));
+            local_den = _mm256_add_epi8(local_den, popcnt256_epi8(_mm256_or_si256(a, b)));
+        }
+        acc_num = _mm256_add_epi64(acc_num, _mm256_sad_epu8(local_num, _mm256_setzero_si256()));
+        acc_den = _mm256_add_epi64(acc_den, _mm256_sad_epu8(local_den, _mm256_setzero_si256()));
+    }
+    int accu_num = hsum256_epi64(acc_num);
+    int accu_den = hsum256_epi64(acc_den);
+    for (; i + 8 <= n; i += 8) {
+        accu_num += __builtin_popcountll(load64(data1 + i) & load64(data2 + i));
+        accu_den += __builtin_popcountll(load64(data1 + i) | load64(data2 + i));
+    }
+    for (; i < n; i++) {
+        accu_num += lookup8bit[data1[i] & data2[i]];
+        accu_den += lookup8bit[data1[i] | data2[i]];
+    }
+    return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
+}
+
+bool
+is_subset_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        // testc is set iff data1 & ~data2 is zero
+        if (!_mm256_testc_si256(load256(data2 + i), load256(data1 + i))) {
+            return false;
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        if ((load64(data1 + i) & ~load64(data2 + i)) != 0) {
+            return false;
+        }
+    }
+    for (; i < n; i++) {
+        if ((data1[i] & ~data2[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #else
 
 float fvec_inner_product_avx(const float* x, const float* y, size_t d) {
@@ -502,6 +674,36 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+float jaccard_AVX2_lookup(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+bool is_subset_AVX2(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+float fp16vec_L2sqr_avx(const uint16_t* x, const uint16_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float fp16vec_inner_product_avx(const uint16_t* x, const uint16_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float sq8vec_L2sqr_avx(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float sq8vec_inner_product_avx(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
 #endif
 
 } // namespace faiss
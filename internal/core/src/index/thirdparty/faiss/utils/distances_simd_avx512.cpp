@@ -425,6 +425,118 @@ jaccard__AVX512(const uint8_t * a, const uint8_t * b, size_t n) {
     return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
 }
 
+/* VPOPCNTDQ kernels, compiled for that extension only and selected at runtime by hook_init.
+ * The ragged tail of a code is read with a masked load, so any code size takes the vector path. */
+#define FAISS_TARGET_VPOPCNTDQ __attribute__((target("avx512f,avx512bw,avx512vpopcntdq")))
+
+namespace {
+
+inline __mmask64
+tail_mask(size_t remain) {
+    return remain >= 64 ? ~__mmask64(0) : (__mmask64(1) << remain) - 1;
+}
+
+} // namespace
+
+FAISS_TARGET_VPOPCNTDQ int
+xor_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    __m512i acc = _mm512_setzero_si512();
+    for (size_t i = 0; i < n; i += 64) {
+        const __mmask64 mask = tail_mask(n - i);
+        const __m512i a = _mm512_maskz_loadu_epi8(mask, data1 + i);
+        const __m512i b = _mm512_maskz_loadu_epi8(mask, data2 + i);
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_xor_si512(a, b)));
+    }
+    return _mm512_reduce_add_epi64(acc);
+}
+
+FAISS_TARGET_VPOPCNTDQ float
+jaccard_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    __m512i acc_num = _mm512_setzero_si512();
+    __m512i acc_den = _mm512_setzero_si512();
+    for (size_t i = 0; i < n; i += 64) {
+        const __mmask64 mask = tail_mask(n - i);
+        const __m512i a = _mm512_maskz_loadu_epi8(mask, data1 + i);
+        const __m512i b = _mm512_maskz_loadu_epi8(mask, data2 + i);
+        acc_num = _mm512_add_epi64(acc_num, _mm512_popcnt_epi64(_mm512_and_si512(a, b)));
+        acc_den = _mm512_add_epi64(acc_den, _mm512_popcnt_epi64(_mm512_or_si512(a, b)));
+    }
+    int accu_num = _mm512_reduce_add_epi64(acc_num);
+    int accu_den = _mm512_reduce_add_epi64(acc_den);
+    return (accu_den == 0) ? 1.0 : ((float)(accu_den - accu_num) / (float)(accu_den));
+}
+
+bool
+is_subset_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    for (size_t i = 0; i < n; i += 64) {
+        const __mmask64 mask = tail_mask(n - i);
+        const __m512i a = _mm512_maskz_loadu_epi8(mask, data1 + i);
+        const __m512i b = _mm512_maskz_loadu_epi8(mask, data2 + i);
+        // bits of data1 missing from data2
+        const __m512i missing = _mm512_andnot_si512(b, a);
+        if (_mm512_test_epi64_mask(missing, missing) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#undef FAISS_TARGET_VPOPCNTDQ
+
+/* quantized vectors, the last d % 16 components go through the AVX2 kernels */
+
+static inline __m512 load_fp16_16 (const uint16_t* x) {
+    return _mm512_cvtph_ps (_mm256_loadu_si256 ((const __m256i*)x));
+}
+
+static inline __m512 load_sq8_16 (const uint8_t* x) {
+    return _mm512_cvtepi32_ps (_mm512_cvtepu8_epi32 (_mm_loadu_si128 ((const __m128i*)x)));
+}
+
+float
+fp16vec_L2sqr_avx512(const uint16_t* x, const uint16_t* y, size_t d) {
+    __m512 msum = _mm512_setzero_ps();
+    for (; d >= 16; d -= 16, x += 16, y += 16) {
+        const __m512 a_m_b = load_fp16_16 (x) - load_fp16_16 (y);
+        msum += a_m_b * a_m_b;
+    }
+    return _mm512_reduce_add_ps (msum) + (d > 0 ? fp16vec_L2sqr_avx (x, y, d) : 0);
+}
+
+float
+fp16vec_inner_product_avx512(const uint16_t* x, const uint16_t* y, size_t d) {
+    __m512 msum = _mm512_setzero_ps();
+    for (; d >= 16; d -= 16, x += 16, y += 16) {
+        msum += load_fp16_16 (x) * load_fp16_16 (y);
+    }
+    return _mm512_reduce_add_ps (msum) + (d > 0 ? fp16vec_inner_product_avx (x, y, d) : 0);
+}
+
+float
+sq8vec_L2sqr_avx512(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    __m512 msum = _mm512_setzero_ps();
+    for (; d >= 16; d -= 16, x += 16, y += 16, vmin += 16, scale += 16) {
+        const __m512 a_m_b = (load_sq8_16 (x) - load_sq8_16 (y)) * _mm512_loadu_ps (scale);
+        msum += a_m_b * a_m_b;
+    }
+    return _mm512_reduce_add_ps (msum) + (d > 0 ? sq8vec_L2sqr_avx (x, y, vmin, scale, d) : 0);
+}
+
+float
+sq8vec_inner_product_avx512(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    const __m512 half = _mm512_set1_ps (0.5f);
+    __m512 msum = _mm512_setzero_ps();
+    for (; d >= 16; d -= 16, x += 16, y += 16, vmin += 16, scale += 16) {
+        const __m512 mmin = _mm512_loadu_ps (vmin);
+        const __m512 mscale = _mm512_loadu_ps (scale);
+        const __m512 mx = mmin + (load_sq8_16 (x) + half) * mscale;
+        const __m512 my = mmin + (load_sq8_16 (y) + half) * mscale;
+        msum += mx * my;
+    }
+    return _mm512_reduce_add_ps (msum) + (d > 0 ? sq8vec_inner_product_avx (x, y, vmin, scale, d) : 0);
+}
+
+
 #else
 
 float
@@ -451,6 +563,48 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+int
+xor_popcnt_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0;
+}
+
+float
+jaccard_AVX512VPOPCNTDQ(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+bool
+is_subset_AVX512(const uint8_t* data1, const uint8_t* data2, const size_t n) {
+    FAISS_ASSERT(false);
+    return false;
+}
+
+float
+fp16vec_L2sqr_avx512(const uint16_t* x, const uint16_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float
+fp16vec_inner_product_avx512(const uint16_t* x, const uint16_t* y, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float
+sq8vec_L2sqr_avx512(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
+float
+sq8vec_inner_product_avx512(const uint8_t* x, const uint8_t* y, const float* vmin, const float* scale, size_t d) {
+    FAISS_ASSERT(false);
+    return 0.0;
+}
+
 #endif
 
 } // namespace faiss
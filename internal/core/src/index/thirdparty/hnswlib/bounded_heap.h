@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace hnswlib {
+
+// Binary heap of at most capacity elements living in storage owned by the caller,
+// so a search never allocates per query. Compare has std::priority_queue semantics:
+// top() is the element every other one compares less than. Pushing onto a full heap throws.
+template<typename T, typename Compare>
+class BoundedHeap {
+ public:
+    BoundedHeap() = default;
+
+    BoundedHeap(T *storage, size_t capacity) : data_(storage), capacity_(capacity) {
+    }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    bool full() const { return size_ == capacity_; }
+
+    const T &top() const { return data_[0]; }
+
+    // callers size the storage so that it never fills up, a full heap means that bound is wrong
+    void push(const T &value) {
+        if (size_ == capacity_) {
+            throw std::runtime_error("BoundedHeap overflow");
+        }
+        data_[size_++] = value;
+        std::push_heap(data_, data_ + size_, Compare());
+    }
+
+    void pop() {
+        std::pop_heap(data_, data_ + size_, Compare());
+        --size_;
+    }
+
+    // drop every element pred holds for, then restore the heap order
+    template<typename Pred>
+    void remove_if(Pred pred) {
+        size_ = std::remove_if(data_, data_ + size_, pred) - data_;
+        std::make_heap(data_, data_ + size_, Compare());
+    }
+
+ private:
+    T *data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+}
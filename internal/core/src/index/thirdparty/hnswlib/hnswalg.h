@@ -1,11 +1,15 @@
 #pragma once
 
 #include "visited_list_pool.h"
+#include "bounded_heap.h"
 #include "hnswlib.h"
 #include <random>
 #include <stdlib.h>
 #include <unordered_set>
 #include <list>
+#include <functional>
+#include <tuple>
+#include <omp.h>
 
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
 
@@ -33,6 +37,8 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             metric_type_ = 0;
         } else if (auto x = dynamic_cast<InnerProductSpace*>(s)) {
             metric_type_ = 1;
+        } else if (auto x = dynamic_cast<QuantizedSpace*>(s)) {
+            metric_type_ = x->is_ip() ? 1 : 0;
         } else {
             metric_type_ = 100;
         }
@@ -54,6 +60,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         size_data_per_element_ = size_links_level0_ + data_size_; // + sizeof(labeltype);
         offsetData_ = size_links_level0_;
 //        label_offset_ = size_links_level0_ + data_size_;
+        label_offset_ = 0;  // unused, still serialized
         offsetLevel0_ = 0;
 
         data_level0_memory_ = (char *) malloc(max_elements_ * size_data_per_element_);
@@ -80,16 +87,19 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         stats_enable = false;
     }
 
+    // ties go by id, so a heap's order only depends on its elements and compacting a candidate set
+    // can't change which node a walk expands next
     struct CompareByFirst {
         constexpr bool operator()(std::pair<dist_t, tableint> const &a,
                                   std::pair<dist_t, tableint> const &b) const noexcept {
-            return a.first < b.first;
+            return a.first < b.first || (a.first == b.first && a.second < b.second);
         }
     };
 
     ~HierarchicalNSW() {
 
-        free(data_level0_memory_);
+        if (!borrowed_level0_)
+            free(data_level0_memory_);
         for (tableint i = 0; i < cur_element_count; i++) {
             if (element_levels_[i] > 0)
                 free(linkLists_[i]);
@@ -131,6 +141,8 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
 
     char *data_level0_memory_;
+    // level 0 points into the buffer the index was loaded from, which the owner keeps alive; the index can't grow
+    bool borrowed_level0_ = false;
     char **linkLists_;
     std::vector<int> element_levels_;
     std::vector<int> level_stats_;
@@ -332,37 +344,44 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             }
 
         } else if (M > 0) {
-            return_list.reserve(M);
-
             std::vector<std::pair<dist_t, tableint>> queue_closest;
             queue_closest.resize(top_candidates.size());
             for (int i = static_cast<int>(top_candidates.size() - 1); i >= 0; i--) {
                 queue_closest[i] = top_candidates.top();
                 top_candidates.pop();
             }
+            selectNeighbors(queue_closest, M, return_list);
+        }
 
-            for (std::pair<dist_t, tableint> &current_pair: queue_closest) {
-                bool good = true;
-                for (tableint id : return_list) {
-                    dist_t curdist =
-                            fstdistfunc_(getDataByInternalId(id),
-                                         getDataByInternalId(current_pair.second),
-                                         dist_func_param_);
-                    if (curdist < current_pair.first) {
-                        good = false;
-                        break;
-                    }
+        return return_list;
+    }
+
+    // the heuristic over candidates sorted nearest first: a candidate is kept unless it is
+    // closer to an already kept one than to the base element
+    void
+    selectNeighbors(const std::vector<std::pair<dist_t, tableint>> &queue_closest, const size_t M,
+                    std::vector<tableint> &return_list) const {
+        return_list.clear();
+        return_list.reserve(M);
+        for (const std::pair<dist_t, tableint> &current_pair: queue_closest) {
+            bool good = true;
+            for (tableint id : return_list) {
+                dist_t curdist =
+                        fstdistfunc_(getDataByInternalId(id),
+                                     getDataByInternalId(current_pair.second),
+                                     dist_func_param_);
+                if (curdist < current_pair.first) {
+                    good = false;
+                    break;
                 }
-                if (good) {
-                    return_list.push_back(current_pair.second);
-                    if (return_list.size() >= M) {
-                        break;
-                    }
+            }
+            if (good) {
+                return_list.push_back(current_pair.second);
+                if (return_list.size() >= M) {
+                    break;
                 }
             }
         }
-
-        return return_list;
     }
 
     linklistsizeint *get_linklist0(tableint internal_id) const {
@@ -433,46 +452,45 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             if (level > element_levels_[selectedNeighbors[idx]])
                 throw std::runtime_error("Trying to make a link on a non-existent level");
 
-            tableint *data = (tableint *) (ll_other + 1);
-            if (sz_link_list_other < Mcurmax) {
-                data[sz_link_list_other] = cur_c;
-                setListCount(ll_other, sz_link_list_other + 1);
-            } else {
-                // finding the "weakest" element to replace it with the new one
-                dist_t d_max = fstdistfunc_(getDataByInternalId(cur_c), getDataByInternalId(selectedNeighbors[idx]),
-                                            dist_func_param_);
-                // Heuristic:
-                std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidates;
-                candidates.emplace(d_max, cur_c);
-
-                for (size_t j = 0; j < sz_link_list_other; j++) {
-                    candidates.emplace(
-                            fstdistfunc_(getDataByInternalId(data[j]), getDataByInternalId(selectedNeighbors[idx]),
-                                         dist_func_param_), data[j]);
-                }
+            connectReverse(selectedNeighbors[idx], &cur_c, 1, level);
+        }
 
-                std::vector<tableint> selected(getNeighborsByHeuristic2(candidates, Mcurmax));
-                setListCount(ll_other, static_cast<unsigned short int>(selected.size()));
-                for (size_t idx = 0; idx < selected.size(); idx++) {
-                    data[idx] = selected[idx];
-                }
-                // Nearest K:
-                /*int indx = -1;
-                for (int j = 0; j < sz_link_list_other; j++) {
-                    dist_t d = fstdistfunc_(getDataByInternalId(data[j]), getDataByInternalId(rez[idx]), dist_func_param_);
-                    if (d > d_max) {
-                        indx = j;
-                        d_max = d;
-                    }
-                }
-                if (indx >= 0) {
-                    data[indx] = cur_c;
-                } */
+        return next_closest_entry_point;
+    }
+
+    // links count new elements from other's list at level, the caller holds other's lock
+    void connectReverse(tableint other, const tableint *new_ids, size_t count, int level) {
+        size_t Mcurmax = level ? maxM_ : maxM0_;
+        linklistsizeint *ll_other = level == 0 ? get_linklist0(other) : get_linklist(other, level);
+        size_t sz_link_list_other = getListCount(ll_other);
+        tableint *data = (tableint *) (ll_other + 1);
+        if (sz_link_list_other + count <= Mcurmax) {
+            for (size_t i = 0; i < count; i++) {
+                data[sz_link_list_other + i] = new_ids[i];
             }
+            setListCount(ll_other, sz_link_list_other + count);
+            return;
+        }
 
+        // finding the "weakest" elements to replace them with the new ones
+        // Heuristic:
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidates;
+        for (size_t i = 0; i < count; i++) {
+            candidates.emplace(
+                    fstdistfunc_(getDataByInternalId(new_ids[i]), getDataByInternalId(other), dist_func_param_),
+                    new_ids[i]);
+        }
+        for (size_t j = 0; j < sz_link_list_other; j++) {
+            candidates.emplace(
+                    fstdistfunc_(getDataByInternalId(data[j]), getDataByInternalId(other), dist_func_param_),
+                    data[j]);
         }
 
-        return next_closest_entry_point;
+        std::vector<tableint> selected(getNeighborsByHeuristic2(candidates, Mcurmax));
+        setListCount(ll_other, static_cast<unsigned short int>(selected.size()));
+        for (size_t idx = 0; idx < selected.size(); idx++) {
+            data[idx] = selected[idx];
+        }
     }
 
     std::mutex global;
@@ -485,6 +503,8 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
     void resizeIndex(size_t new_max_elements){
         if (new_max_elements<cur_element_count)
             throw std::runtime_error("Cannot resize, max element is less than the current number of elements");
+        if (borrowed_level0_)
+            throw std::runtime_error("Cannot resize an index loaded in place");
 
 
         delete visited_list_pool_;
@@ -517,6 +537,10 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         writeBinaryPOD(output, metric_type_);
         writeBinaryPOD(output, data_size_);
         writeBinaryPOD(output, *((size_t *) dist_func_param_));
+        // only quantized rows are not 4 * dim bytes, older indexes have nothing here
+        if (auto quantized = dynamic_cast<QuantizedSpace*>(space)) {
+            quantized->save(output);
+        }
 
         writeBinaryPOD(output, offsetLevel0_);
         writeBinaryPOD(output, max_elements_);
@@ -550,7 +574,13 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         readBinaryPOD(input, metric_type_);
         readBinaryPOD(input, data_size_);
         readBinaryPOD(input, dim);
-        if (metric_type_ == 0) {
+        if (data_size_ != dim * sizeof(float)) {
+            QuantizerType type;
+            readBinaryPOD(input, type);
+            auto quantized = new hnswlib::QuantizedSpace(dim, metric_type_ == 1, type);
+            quantized->load(input);
+            space = quantized;
+        } else if (metric_type_ == 0) {
             space = new hnswlib::L2Space(dim);
         } else if (metric_type_ == 1) {
             space = new hnswlib::InnerProductSpace(dim);
@@ -614,10 +644,18 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         // input.seekg(pos,input.beg);
 
 
-        data_level0_memory_ = (char *) malloc(max_elements * size_data_per_element_);
-        if (data_level0_memory_ == nullptr)
-            throw std::runtime_error("Not enough memory: loadIndex failed to allocate level0");
-        input.read(data_level0_memory_, cur_element_count * size_data_per_element_);
+        // search never writes level 0, so a full index reads it in place when the buffer outlives the index
+        auto borrowed = max_elements == cur_element_count ? input.borrow(size_data_per_element_, cur_element_count)
+                                                          : nullptr;
+        if (borrowed != nullptr) {
+            data_level0_memory_ = (char *) borrowed;
+            borrowed_level0_ = true;
+        } else {
+            data_level0_memory_ = (char *) malloc(max_elements * size_data_per_element_);
+            if (data_level0_memory_ == nullptr)
+                throw std::runtime_error("Not enough memory: loadIndex failed to allocate level0");
+            input.read(data_level0_memory_, cur_element_count * size_data_per_element_);
+        }
 
 
 
@@ -894,11 +932,264 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return cur_c;
     };
 
-    std::priority_queue<std::pair<dist_t, labeltype >>
-    searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
-        std::priority_queue<std::pair<dist_t, labeltype >> result;
-        if (cur_element_count == 0) return result;
+    // rows in a wave are a fraction of the rows already in the graph, so they would mostly have found
+    // neighbors there anyway, and never more than kMaxWave
+    static constexpr size_t kWaveFraction = 32;
+    static constexpr size_t kMaxWave = 16384;
+    static constexpr size_t kLinkLockStripes = 4096;
+
+    // Inserts n rows of data_size_ bytes, row i with label and internal id cur_element_count + i.
+    // Levels are drawn up front in label order and rows go in from the highest level down, in waves.
+    // Every row of a wave searches the graph as it was when the wave started, so the searches take no
+    // locks and write only the row's own link lists. Then each row is linked from its neighbors:
+    // in arrival order under lock stripes, or, when deterministic, grouped by neighbor in id order,
+    // which builds the same graph for any number of threads.
+    // progress(rows inserted so far) is called on the calling thread after every wave.
+    void addPoints(const void *data, size_t n, bool deterministic, const std::function<void(size_t)> &progress) {
+        using Entry = std::pair<dist_t, tableint>;
+        if (n == 0) {
+            return;
+        }
+        tableint base;
+        {
+            std::unique_lock <std::mutex> lock(cur_element_count_guard_);
+            if (cur_element_count + n > max_elements_) {
+                throw std::runtime_error("The number of elements exceeds the specified limit");
+            }
+            base = cur_element_count;
+            cur_element_count += n;
+        }
+
+        std::vector<tableint> order(n);
+        for (size_t i = 0; i < n; i++) {
+            tableint id = base + i;
+            order[i] = id;
+            int curlevel = getRandomLevel(mult_);
+            element_levels_[id] = curlevel;
+            if (stats_enable) {
+                if (curlevel >= level_stats_.size()) {
+                    level_stats_.resize(curlevel + 1, 0);
+                }
+                level_stats_[curlevel]++;
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [this](tableint a, tableint b) {
+            return element_levels_[a] > element_levels_[b];
+        });
+
+#pragma omp parallel for
+        for (int64_t i = 0; i < (int64_t) n; i++) {
+            tableint id = base + i;
+            memset(data_level0_memory_ + id * size_data_per_element_ + offsetLevel0_, 0, size_data_per_element_);
+            memcpy(getDataByInternalId(id), (const char *) data + i * data_size_, data_size_);
+            int curlevel = element_levels_[id];
+            linkLists_[id] = nullptr;
+            if (curlevel) {
+                linkLists_[id] = (char *) malloc(size_links_per_element_ * curlevel + 1);
+                if (linkLists_[id] != nullptr)
+                    memset(linkLists_[id], 0, size_links_per_element_ * curlevel + 1);
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (element_levels_[base + i] && linkLists_[base + i] == nullptr)
+                throw std::runtime_error("Not enough memory: addPoints failed to allocate linklist");
+        }
+
+        size_t begin = 0;
+        if ((signed) enterpoint_node_ == -1) {
+            enterpoint_node_ = order[0];
+            maxlevel_ = element_levels_[order[0]];
+            begin = 1;
+        }
 
+        // per thread, reused by every row the thread inserts
+        struct Scratch {
+            std::vector<Entry> heaps;
+            std::vector<Entry> sorted;
+            std::vector<tableint> selected;
+        };
+        std::vector<Scratch> scratch(omp_get_max_threads());
+        std::vector<std::mutex> stripes(deterministic ? 0 : kLinkLockStripes);
+        // (neighbor, level, new row) links of a wave, sorted to add them in the same order every time
+        std::vector<std::tuple<tableint, int, tableint>> reverse;
+
+        while (begin < n) {
+            size_t inserted = cur_element_count - n + begin;
+            size_t wave = std::min(std::min(std::max<size_t>(inserted / kWaveFraction, 1), kMaxWave), n - begin);
+            tableint ep = enterpoint_node_;
+            int maxlevel = maxlevel_;
+
+#pragma omp parallel for schedule(dynamic, 16)
+            for (int64_t w = 0; w < (int64_t) wave; w++) {
+                auto &local = scratch[omp_get_thread_num()];
+                linkWaveElement(order[begin + w], ep, maxlevel, local.heaps, local.sorted, local.selected);
+            }
+
+            // the graph is written only from here on
+            if (!deterministic) {
+#pragma omp parallel for schedule(dynamic, 16)
+                for (int64_t w = 0; w < (int64_t) wave; w++) {
+                    tableint cur_c = order[begin + w];
+                    for (int level = std::min(element_levels_[cur_c], maxlevel); level >= 0; level--) {
+                        linklistsizeint *ll_cur = level == 0 ? get_linklist0(cur_c) : get_linklist(cur_c, level);
+                        size_t size = getListCount(ll_cur);
+                        tableint *links = (tableint *) (ll_cur + 1);
+                        for (size_t j = 0; j < size; j++) {
+                            std::unique_lock <std::mutex> lock(stripes[links[j] % kLinkLockStripes]);
+                            connectReverse(links[j], &cur_c, 1, level);
+                        }
+                    }
+                }
+            } else {
+                for (size_t w = 0; w < wave; w++) {
+                    tableint cur_c = order[begin + w];
+                    for (int level = std::min(element_levels_[cur_c], maxlevel); level >= 0; level--) {
+                        linklistsizeint *ll_cur = level == 0 ? get_linklist0(cur_c) : get_linklist(cur_c, level);
+                        size_t size = getListCount(ll_cur);
+                        tableint *links = (tableint *) (ll_cur + 1);
+                        for (size_t j = 0; j < size; j++) {
+                            reverse.emplace_back(links[j], level, cur_c);
+                        }
+                    }
+                }
+                std::sort(reverse.begin(), reverse.end());
+                std::vector<size_t> groups;
+                for (size_t i = 0; i < reverse.size(); i++) {
+                    if (i == 0 || std::get<0>(reverse[i]) != std::get<0>(reverse[i - 1]) ||
+                        std::get<1>(reverse[i]) != std::get<1>(reverse[i - 1])) {
+                        groups.push_back(i);
+                    }
+                }
+                groups.push_back(reverse.size());
+
+                // one thread per (neighbor, level), the new rows are added in id order
+#pragma omp parallel for schedule(dynamic, 64)
+                for (int64_t g = 0; g < (int64_t) groups.size() - 1; g++) {
+                    auto &local = scratch[omp_get_thread_num()];
+                    local.selected.clear();
+                    for (size_t i = groups[g]; i < groups[g + 1]; i++) {
+                        local.selected.push_back(std::get<2>(reverse[i]));
+                    }
+                    auto &first = reverse[groups[g]];
+                    connectReverse(std::get<0>(first), local.selected.data(), local.selected.size(),
+                                   std::get<1>(first));
+                }
+                reverse.clear();
+            }
+
+            // rows are in level order, the first one above the graph becomes the entry point
+            if (element_levels_[order[begin]] > maxlevel_) {
+                enterpoint_node_ = order[begin];
+                maxlevel_ = element_levels_[order[begin]];
+            }
+            begin += wave;
+            progress(cur_element_count - n + begin);
+        }
+    }
+
+    // searches and links cur_c at its levels below maxlevel as addPoint does, without locks:
+    // no other thread writes the graph while a wave is searched
+    void linkWaveElement(tableint cur_c, tableint ep, int maxlevel, std::vector<std::pair<dist_t, tableint>> &heaps,
+                         std::vector<std::pair<dist_t, tableint>> &sorted, std::vector<tableint> &selected) {
+        using Entry = std::pair<dist_t, tableint>;
+        using Heap = BoundedHeap<Entry, CompareByFirst>;
+        const void *data_point = getDataByInternalId(cur_c);
+        int curlevel = element_levels_[cur_c];
+        tableint currObj = ep;
+
+        dist_t curdist = fstdistfunc_(data_point, getDataByInternalId(currObj), dist_func_param_);
+        for (int level = maxlevel; level > curlevel; level--) {
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                unsigned int *data = get_linklist(currObj, level);
+                int size = getListCount(data);
+                tableint *datal = (tableint *) (data + 1);
+                for (int i = 0; i < size; i++) {
+                    dist_t d = fstdistfunc_(data_point, getDataByInternalId(datal[i]), dist_func_param_);
+                    if (d < curdist) {
+                        curdist = d;
+                        currObj = datal[i];
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        // the candidate set only outgrows 2 * ef_construction_ once top_candidates is full. a live candidate,
+        // not farther than lowerBound, is then in top_candidates or a tie at lowerBound pushed out of it by a
+        // nearer one that is still there, so compacting leaves fewer than 2 * ef_construction_
+        size_t top_capacity = ef_construction_ + 1;
+        size_t candidate_capacity = 2 * ef_construction_ + maxM0_;
+        heaps.resize(top_capacity + candidate_capacity);
+        VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+        for (int level = std::min(curlevel, maxlevel); level >= 0; level--) {
+            Heap top_candidates(heaps.data(), top_capacity);
+            Heap candidate_set(heaps.data() + top_capacity, candidate_capacity);
+            vl_type *visited_array = vl->mass;
+            vl_type visited_array_tag = vl->curV;
+
+            dist_t dist = fstdistfunc_(data_point, getDataByInternalId(currObj), dist_func_param_);
+            top_candidates.push(Entry(dist, currObj));
+            candidate_set.push(Entry(-dist, currObj));
+            visited_array[currObj] = visited_array_tag;
+            dist_t lowerBound = dist;
+
+            while (!candidate_set.empty()) {
+                Entry curr_el_pair = candidate_set.top();
+                if ((-curr_el_pair.first) > lowerBound) {
+                    break;
+                }
+                candidate_set.pop();
+                if (candidate_set.size() + maxM0_ > candidate_capacity) {
+                    candidate_set.remove_if([lowerBound](const Entry &e) { return (-e.first) > lowerBound; });
+                }
+
+                tableint curNodeNum = curr_el_pair.second;
+                int *data = level == 0 ? (int *) get_linklist0(curNodeNum) : (int *) get_linklist(curNodeNum, level);
+                size_t size = getListCount((linklistsizeint *) data);
+                tableint *datal = (tableint *) (data + 1);
+                for (size_t j = 0; j < size; j++) {
+                    tableint candidate_id = *(datal + j);
+#ifdef USE_SSE
+                    _mm_prefetch((char *) (visited_array + *(datal + j + 1)), _MM_HINT_T0);
+                    _mm_prefetch(getDataByInternalId(*(datal + j + 1)), _MM_HINT_T0);
+#endif
+                    if (visited_array[candidate_id] == visited_array_tag) continue;
+                    visited_array[candidate_id] = visited_array_tag;
+
+                    dist_t dist1 = fstdistfunc_(data_point, getDataByInternalId(candidate_id), dist_func_param_);
+                    if (top_candidates.size() < ef_construction_ || lowerBound > dist1) {
+                        candidate_set.push(Entry(-dist1, candidate_id));
+                        top_candidates.push(Entry(dist1, candidate_id));
+                        if (top_candidates.size() > ef_construction_)
+                            top_candidates.pop();
+                        lowerBound = top_candidates.top().first;
+                    }
+                }
+            }
+
+            sorted.resize(top_candidates.size());
+            for (size_t i = sorted.size(); i > 0; i--) {
+                sorted[i - 1] = top_candidates.top();
+                top_candidates.pop();
+            }
+            selectNeighbors(sorted, M_, selected);
+
+            linklistsizeint *ll_cur = level == 0 ? get_linklist0(cur_c) : get_linklist(cur_c, level);
+            setListCount(ll_cur, selected.size());
+            std::copy(selected.begin(), selected.end(), (tableint *) (ll_cur + 1));
+            currObj = selected.front();
+
+            // the next level starts a new walk
+            vl->reset();
+        }
+        visited_list_pool_->releaseVisitedList(vl);
+    }
+
+    // greedy descent through the upper layers, returns the entry point of layer 0
+    tableint
+    searchUpperLayers(const void *query_data, StatisticsInfo &stats) const {
         tableint currObj = enterpoint_node_;
         dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
 
@@ -928,16 +1219,30 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
                 }
             }
         }
+        return currObj;
+    }
+
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnn(const void *query_data, size_t k, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        return searchKnn(query_data, k, std::max(ef_, k), bitset, stats);
+    }
+
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnn(const void *query_data, size_t k, size_t ef, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        std::priority_queue<std::pair<dist_t, labeltype >> result;
+        if (cur_element_count == 0) return result;
+
+        tableint currObj = searchUpperLayers(query_data, stats);
 
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
         if (!bitset.empty()) {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                top_candidates1 = searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset, stats);
+                top_candidates1 = searchBaseLayerST<true>(currObj, query_data, ef, bitset, stats);
             top_candidates.swap(top_candidates1);
         }
         else{
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                top_candidates1 = searchBaseLayerST<false>(currObj, query_data, std::max(ef_, k), bitset, stats);
+                top_candidates1 = searchBaseLayerST<false>(currObj, query_data, ef, bitset, stats);
             top_candidates.swap(top_candidates1);
         }
         while (top_candidates.size() > k) {
@@ -951,6 +1256,223 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         return result;
     };
 
+    // searchKnn for sparse filters: distances are only computed for rows that pass the bitset,
+    // and a filtered neighbor is hopped over to its own neighbors instead of being walked through,
+    // so the walk stays on valid rows and the ef budget is spent on them
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnnFiltered(const void *query_data, size_t k, size_t ef, const faiss::BitsetView bitset, StatisticsInfo &stats) const {
+        std::priority_queue<std::pair<dist_t, labeltype >> result;
+        if (cur_element_count == 0) return result;
+
+        tableint ep_id = searchUpperLayers(query_data, stats);
+
+        VisitedList *vl = visited_list_pool_->getFreeVisitedList();
+        vl_type *visited_array = vl->mass;
+        vl_type visited_array_tag = vl->curV;
+
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
+
+        dist_t lowerBound = std::numeric_limits<dist_t>::max();
+        auto evaluate = [&](tableint candidate_id) {
+            dist_t dist = fstdistfunc_(query_data, getDataByInternalId(candidate_id), dist_func_param_);
+            if (top_candidates.size() < ef || lowerBound > dist) {
+                candidate_set.emplace(-dist, candidate_id);
+                top_candidates.emplace(dist, candidate_id);
+                if (top_candidates.size() > ef)
+                    top_candidates.pop();
+                lowerBound = top_candidates.top().first;
+            }
+        };
+
+        // a filtered entry point only serves to start the walk
+        visited_array[ep_id] = visited_array_tag;
+        if (!bitset.test((faiss::ConcurrentBitset::id_type_t)(ep_id))) {
+            evaluate(ep_id);
+        } else {
+            candidate_set.emplace(-lowerBound, ep_id);
+        }
+
+        while (!candidate_set.empty()) {
+            std::pair<dist_t, tableint> current_node_pair = candidate_set.top();
+            if ((-current_node_pair.first) > lowerBound && top_candidates.size() >= ef) {
+                break;
+            }
+            candidate_set.pop();
+
+            int *data = (int *) get_linklist0(current_node_pair.second);
+            size_t size = getListCount((linklistsizeint*)data);
+            for (size_t j = 1; j <= size; j++) {
+                tableint candidate_id = *(data + j);
+                if (visited_array[candidate_id] == visited_array_tag) continue;
+                if (!bitset.test((faiss::ConcurrentBitset::id_type_t)(candidate_id))) {
+                    visited_array[candidate_id] = visited_array_tag;
+                    evaluate(candidate_id);
+                    continue;
+                }
+                // two hops: the filtered neighbor is skipped, its valid neighbors are evaluated in its place.
+                // it stays unvisited, so another path may still hop over it
+                int *hop_data = (int *) get_linklist0(candidate_id);
+                size_t hop_size = getListCount((linklistsizeint*)hop_data);
+                for (size_t h = 1; h <= hop_size; h++) {
+                    tableint hop_id = *(hop_data + h);
+                    if (visited_array[hop_id] == visited_array_tag ||
+                        bitset.test((faiss::ConcurrentBitset::id_type_t)(hop_id)))
+                        continue;
+                    visited_array[hop_id] = visited_array_tag;
+                    evaluate(hop_id);
+                }
+            }
+        }
+        visited_list_pool_->releaseVisitedList(vl);
+
+        while (top_candidates.size() > k) {
+            top_candidates.pop();
+        }
+        while (top_candidates.size() > 0) {
+            std::pair<dist_t, tableint> rez = top_candidates.top();
+            result.push(std::pair<dist_t, labeltype>(rez.first, rez.second));
+            top_candidates.pop();
+        }
+        return result;
+    };
+
+    // exact search over the rows that pass the bitset, cheaper than the graph once few rows survive
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnnBF(const void *query_data, size_t k, const faiss::BitsetView bitset) const {
+        std::priority_queue<std::pair<dist_t, labeltype >> result;
+        for (tableint id = 0; id < cur_element_count; id++) {
+            if (!bitset.empty() && bitset.test((faiss::ConcurrentBitset::id_type_t)(id)))
+                continue;
+            dist_t dist = fstdistfunc_(query_data, getDataByInternalId(id), dist_func_param_);
+            if (result.size() < k) {
+                result.emplace(dist, id);
+            } else if (dist < result.top().first) {
+                result.pop();
+                result.emplace(dist, id);
+            }
+        }
+        return result;
+    };
+
+    // unfiltered searchKnn of nq queries at once. The walks take turns expanding one node each, and every
+    // turn prefetches the link list of the query's next node, so one query's cache misses are in flight
+    // while the others compute distances. Heaps are bounded and live in one buffer per call.
+    // Results of query i land in distances / labels [i * k, i * k + counts[i]), nearest first.
+    void
+    searchKnnBatch(const void *queries, size_t nq, size_t k, size_t ef, dist_t *distances, labeltype *labels,
+                   size_t *counts, StatisticsInfo &stats) const {
+        using Entry = std::pair<dist_t, tableint>;
+        using Heap = BoundedHeap<Entry, CompareByFirst>;
+        struct Walk {
+            const void *query;
+            VisitedList *vl;
+            // nearest ef so far, worst on top
+            Heap top_candidates;
+            // negated distances, nearest on top
+            Heap candidate_set;
+            dist_t lowerBound;
+            bool done;
+        };
+        ef = std::max(ef, k);
+        if (cur_element_count == 0) {
+            std::fill(counts, counts + nq, 0);
+            return;
+        }
+
+        // the candidate set only outgrows 2 * ef once top_candidates is full. a live candidate, not farther
+        // than lowerBound, is then in top_candidates or a tie at lowerBound pushed out of it by a nearer one
+        // that is still there, so compacting leaves fewer than 2 * ef
+        size_t top_capacity = ef + 1;
+        size_t candidate_capacity = 2 * ef + maxM0_;
+        std::vector<Entry> buffer(nq * (top_capacity + candidate_capacity));
+        std::vector<Walk> walks(nq);
+        for (size_t i = 0; i < nq; i++) {
+            auto &walk = walks[i];
+            auto storage = buffer.data() + i * (top_capacity + candidate_capacity);
+            walk.query = (const char *) queries + i * data_size_;
+            walk.vl = visited_list_pool_->getFreeVisitedList();
+            walk.top_candidates = Heap(storage, top_capacity);
+            walk.candidate_set = Heap(storage + top_capacity, candidate_capacity);
+
+            tableint ep_id = searchUpperLayers(walk.query, stats);
+            dist_t dist = fstdistfunc_(walk.query, getDataByInternalId(ep_id), dist_func_param_);
+            walk.top_candidates.push(Entry(dist, ep_id));
+            walk.candidate_set.push(Entry(-dist, ep_id));
+            walk.vl->mass[ep_id] = walk.vl->curV;
+            walk.lowerBound = dist;
+            walk.done = false;
+        }
+
+        size_t active = nq;
+        while (active > 0) {
+            for (auto &walk : walks) {
+                if (walk.done) continue;
+                if (walk.candidate_set.empty() || (-walk.candidate_set.top().first) > walk.lowerBound) {
+                    walk.done = true;
+                    active--;
+                    continue;
+                }
+                tableint current_node_id = walk.candidate_set.top().second;
+                walk.candidate_set.pop();
+                if (walk.candidate_set.size() + maxM0_ > candidate_capacity) {
+                    auto lowerBound = walk.lowerBound;
+                    walk.candidate_set.remove_if([lowerBound](const Entry &e) { return (-e.first) > lowerBound; });
+                }
+
+                vl_type *visited_array = walk.vl->mass;
+                vl_type visited_array_tag = walk.vl->curV;
+                auto &top_candidates = walk.top_candidates;
+                auto &candidate_set = walk.candidate_set;
+                dist_t lowerBound = walk.lowerBound;
+                int *data = (int *) get_linklist0(current_node_id);
+                size_t size = getListCount((linklistsizeint*)data);
+                for (size_t j = 1; j <= size; j++) {
+                    int candidate_id = *(data + j);
+#ifdef USE_SSE
+                    _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
+                    _mm_prefetch(getDataByInternalId(*(data + j + 1)), _MM_HINT_T0);
+#endif
+                    if (visited_array[candidate_id] == visited_array_tag) continue;
+                    visited_array[candidate_id] = visited_array_tag;
+
+                    dist_t dist = fstdistfunc_(walk.query, getDataByInternalId(candidate_id), dist_func_param_);
+                    if (top_candidates.size() < ef || lowerBound > dist) {
+                        candidate_set.push(Entry(-dist, candidate_id));
+                        top_candidates.push(Entry(dist, candidate_id));
+                        if (top_candidates.size() > ef)
+                            top_candidates.pop();
+                        lowerBound = top_candidates.top().first;
+                    }
+                }
+                walk.lowerBound = lowerBound;
+#ifdef USE_SSE
+                // the next node of this walk is touched a full round later
+                if (!walk.candidate_set.empty()) {
+                    auto next_data = (char *) get_linklist0(walk.candidate_set.top().second);
+                    _mm_prefetch(next_data, _MM_HINT_T0);
+                    _mm_prefetch(next_data + 64, _MM_HINT_T0);
+                }
+#endif
+            }
+        }
+
+        for (size_t i = 0; i < nq; i++) {
+            auto &walk = walks[i];
+            visited_list_pool_->releaseVisitedList(walk.vl);
+            while (walk.top_candidates.size() > k) {
+                walk.top_candidates.pop();
+            }
+            auto count = walk.top_candidates.size();
+            counts[i] = count;
+            for (size_t j = count; j > 0; j--) {
+                distances[i * k + j - 1] = walk.top_candidates.top().first;
+                labels[i * k + j - 1] = walk.top_candidates.top().second;
+                walk.top_candidates.pop();
+            }
+        }
+    }
+
     int64_t cal_size() {
         int64_t ret = 0;
         ret += sizeof(*this);
@@ -104,6 +104,7 @@ namespace hnswlib {
 
 #include "space_l2.h"
 #include "space_ip.h"
+#include "space_sq.h"
 #include "bruteforce.h"
 #include "hnswalg.h"
 
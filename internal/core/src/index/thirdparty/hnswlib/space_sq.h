@@ -0,0 +1,160 @@
+#pragma once
+#include <faiss/FaissHook.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace hnswlib {
+
+// how a quantized space stores one component
+enum class QuantizerType : int32_t {
+    FP16 = 1,
+    // one byte per component, 256 equal buckets over the trained range of each dimension
+    SQ8 = 2,
+};
+
+// dist func param of a quantized space, starts with dim like the other spaces
+struct QuantizedParam {
+    size_t dim;
+    const float *vmin;
+    const float *scale;
+};
+
+static float
+FP16L2Sqr(const void *pVect1, const void *pVect2, const void *param) {
+    return faiss::fp16vec_L2sqr((const uint16_t *) pVect1, (const uint16_t *) pVect2, *((size_t *) param));
+}
+
+static float
+FP16InnerProduct(const void *pVect1, const void *pVect2, const void *param) {
+    return (1.0f - faiss::fp16vec_inner_product((const uint16_t *) pVect1, (const uint16_t *) pVect2,
+                                                *((size_t *) param)));
+}
+
+static float
+SQ8L2Sqr(const void *pVect1, const void *pVect2, const void *param) {
+    auto p = (const QuantizedParam *) param;
+    return faiss::sq8vec_L2sqr((const uint8_t *) pVect1, (const uint8_t *) pVect2, p->vmin, p->scale, p->dim);
+}
+
+static float
+SQ8InnerProduct(const void *pVect1, const void *pVect2, const void *param) {
+    auto p = (const QuantizedParam *) param;
+    return (1.0f - faiss::sq8vec_inner_product((const uint8_t *) pVect1, (const uint8_t *) pVect2, p->vmin,
+                                               p->scale, p->dim));
+}
+
+// Stores fp16 or SQ8 codes instead of fp32 rows, 2x or 4x smaller. Both sides of every distance are codes,
+// so queries go through encode() before searching; the distances approximate those of L2Space or
+// InnerProductSpace and callers that need them exact re-rank the results against the raw rows.
+class QuantizedSpace : public SpaceInterface<float> {
+ public:
+    QuantizedSpace(size_t dim, bool ip, QuantizerType type) : ip_(ip), type_(type), vmin_(dim, 0), scale_(dim, 0) {
+        param_.dim = dim;
+        param_.vmin = vmin_.data();
+        param_.scale = scale_.data();
+        if (type_ == QuantizerType::FP16) {
+            fstdistfunc_ = ip_ ? FP16InnerProduct : FP16L2Sqr;
+            data_size_ = dim * sizeof(uint16_t);
+        } else {
+            fstdistfunc_ = ip_ ? SQ8InnerProduct : SQ8L2Sqr;
+            data_size_ = dim * sizeof(uint8_t);
+        }
+    }
+
+    // param_ points into vmin_ and scale_ of this very object
+    QuantizedSpace(const QuantizedSpace &) = delete;
+    QuantizedSpace &operator=(const QuantizedSpace &) = delete;
+    QuantizedSpace(QuantizedSpace &&) = delete;
+    QuantizedSpace &operator=(QuantizedSpace &&) = delete;
+
+    size_t get_data_size() {
+        return data_size_;
+    }
+
+    DISTFUNC<float> get_dist_func() {
+        return fstdistfunc_;
+    }
+
+    void *get_dist_func_param() {
+        return &param_;
+    }
+
+    bool is_ip() const {
+        return ip_;
+    }
+
+    QuantizerType type() const {
+        return type_;
+    }
+
+    // SQ8 learns the range of every dimension from n rows, components outside it are clamped
+    void train(const float *x, size_t n) {
+        if (type_ != QuantizerType::SQ8) {
+            return;
+        }
+        auto dim = param_.dim;
+        std::vector<float> vmax(dim, std::numeric_limits<float>::lowest());
+        std::fill(vmin_.begin(), vmin_.end(), std::numeric_limits<float>::max());
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < dim; j++) {
+                vmin_[j] = std::min(vmin_[j], x[i * dim + j]);
+                vmax[j] = std::max(vmax[j], x[i * dim + j]);
+            }
+        }
+        for (size_t j = 0; j < dim; j++) {
+            if (n == 0) {
+                vmin_[j] = vmax[j] = 0;
+            }
+            scale_[j] = (vmax[j] - vmin_[j]) / 256;
+        }
+    }
+
+    void encode(const float *x, void *code) const {
+        auto dim = param_.dim;
+        if (type_ == QuantizerType::FP16) {
+            auto out = (uint16_t *) code;
+            for (size_t j = 0; j < dim; j++) {
+                out[j] = faiss::encode_fp16(x[j]);
+            }
+            return;
+        }
+        auto out = (uint8_t *) code;
+        for (size_t j = 0; j < dim; j++) {
+            float bucket = scale_[j] > 0 ? std::floor((x[j] - vmin_[j]) / scale_[j]) : 0;
+            out[j] = (uint8_t) std::min(std::max(bucket, 0.0f), 255.0f);
+        }
+    }
+
+    template<typename W>
+    void save(W &output) const {
+        writeBinaryPOD(output, type_);
+        if (type_ == QuantizerType::SQ8) {
+            output.write((char *) vmin_.data(), vmin_.size() * sizeof(float));
+            output.write((char *) scale_.data(), scale_.size() * sizeof(float));
+        }
+    }
+
+    // the type is read before constructing the space
+    template<typename R>
+    void load(R &input) {
+        if (type_ == QuantizerType::SQ8) {
+            input.read((char *) vmin_.data(), vmin_.size() * sizeof(float));
+            input.read((char *) scale_.data(), scale_.size() * sizeof(float));
+        }
+    }
+
+    ~QuantizedSpace() {}
+
+ private:
+    DISTFUNC<float> fstdistfunc_;
+    size_t data_size_;
+    bool ip_;
+    QuantizerType type_;
+    std::vector<float> vmin_;
+    std::vector<float> scale_;
+    QuantizedParam param_;
+};
+
+}
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include "knowhere/common/Dataset.h"
 #include "knowhere/common/Timer.h"
+#include "knowhere/common/Utils.h"
 #include "knowhere/knowhere/common/Exception.h"
 #include "unittest/utils.h"
 #include "index/thirdparty/faiss/utils/BitsetView.h"
@@ -47,6 +48,45 @@ TEST(COMMON_TEST, time_recoder) {
     ASSERT_GE(span, 1.0);
 }
 
+TEST(COMMON_TEST, assemble_slices) {
+    const int64_t size = 1000;
+    auto data = std::shared_ptr<uint8_t[]>(new uint8_t[size]);
+    for (int64_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    // slices copied out of the binary are stitched into an owned buffer
+    milvus::knowhere::BinarySet copied;
+    copied.Append("IVF", data, size);
+    milvus::knowhere::Disassemble(300, copied);
+    ASSERT_TRUE(copied.Contains("IVF_3"));
+    milvus::knowhere::Assemble(copied);
+    auto assembled = copied.GetByName("IVF");
+    ASSERT_EQ(assembled->size, size);
+    ASSERT_TRUE(assembled->owned);
+    ASSERT_EQ(memcmp(assembled->data.get(), data.get(), size), 0);
+    ASSERT_FALSE(copied.Contains("IVF_0"));
+
+    // views laid out back to back are aliased, the assembled binary keeps every slice alive
+    milvus::knowhere::BinarySet views;
+    std::string meta = R"({"meta":[{"name":"IVF","slice_num":2,"total_len":1000}]})";
+    auto meta_data = std::shared_ptr<uint8_t[]>(new uint8_t[meta.size()]);
+    memcpy(meta_data.get(), meta.data(), meta.size());
+    views.Append(milvus::knowhere::INDEX_FILE_SLICE_META, meta_data, meta.size());
+    auto head = std::make_shared<milvus::knowhere::Binary>();
+    head->data = std::shared_ptr<uint8_t[]>(data, data.get());
+    head->size = 600;
+    head->owned = true;
+    views.Append("IVF_0", head);
+    views.Append("IVF_1", std::shared_ptr<uint8_t[]>(data, data.get() + 600), 400);
+    milvus::knowhere::Assemble(views);
+    assembled = views.GetByName("IVF");
+    ASSERT_EQ(assembled->data.get(), data.get());
+    ASSERT_EQ(assembled->size, size);
+    // the second view was not owned, so neither is the whole
+    ASSERT_FALSE(assembled->owned);
+}
+
 TEST(COMMON_TEST, BitsetView) {
     using faiss::BitsetView;
     using faiss::ConcurrentBitset;
@@ -12,9 +12,15 @@
 #include <gtest/gtest.h>
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/IndexHNSW.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include <omp.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <unordered_set>
 #include "knowhere/common/Exception.h"
 #include "unittest/utils.h"
 
@@ -96,6 +102,265 @@ TEST_P(HNSWTest, HNSW_basic) {
     ReleaseQueryResult(result2);
 }
 
+TEST_P(HNSWTest, HNSW_zero_copy_load) {
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+    auto ref_result = index_->Query(query_dataset, conf, nullptr);
+
+    auto bs = index_->Serialize(conf);
+    auto bin = bs.GetByName("HNSW");
+    auto owned = std::make_shared<milvus::knowhere::Binary>();
+    owned->data = std::shared_ptr<uint8_t[]>(new uint8_t[bin->size]);
+    memcpy(owned->data.get(), bin->data.get(), bin->size);
+    owned->size = bin->size;
+    owned->owned = true;
+    std::weak_ptr<uint8_t[]> buffer = owned->data;
+    bs.clear();
+    bs.Append("HNSW", owned);
+    owned = nullptr;
+
+    auto loaded = std::make_shared<milvus::knowhere::IndexHNSW>();
+    loaded->Load(bs);
+    bs.clear();
+    // the level 0 graph points into the buffer, which the index keeps alive
+    ASSERT_FALSE(buffer.expired());
+    EXPECT_EQ(loaded->Count(), nb);
+
+    auto result = loaded->Query(query_dataset, conf, nullptr);
+    auto ref_ids = ref_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], ref_ids[i]);
+    }
+    ReleaseQueryResult(result);
+    ReleaseQueryResult(ref_result);
+
+    loaded = nullptr;
+    ASSERT_TRUE(buffer.expired());
+}
+
+TEST_P(HNSWTest, HNSW_filter_strategy) {
+    using Strategy = milvus::knowhere::IndexHNSW::FilterStrategy;
+    EXPECT_EQ(milvus::knowhere::IndexHNSW::ChooseFilterStrategy(10000, 10000, 200, 32), Strategy::GRAPH);
+    EXPECT_EQ(milvus::knowhere::IndexHNSW::ChooseFilterStrategy(10000, 9000, 64, 32), Strategy::GRAPH);
+    EXPECT_EQ(milvus::knowhere::IndexHNSW::ChooseFilterStrategy(1000000, 200000, 64, 32), Strategy::TWO_HOP);
+    EXPECT_EQ(milvus::knowhere::IndexHNSW::ChooseFilterStrategy(1000000, 400000, 64, 32), Strategy::GRAPH);
+    EXPECT_EQ(milvus::knowhere::IndexHNSW::ChooseFilterStrategy(1000000, 40000, 64, 32), Strategy::BRUTE_FORCE);
+    EXPECT_EQ(milvus::knowhere::IndexHNSW::ChooseFilterStrategy(10000, 0, 64, 32), Strategy::BRUTE_FORCE);
+
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+    // small ef, so the unfiltered walk can't hold k valid rows under tight filters
+    conf[milvus::knowhere::IndexParams::ef] = 10;
+
+    std::mt19937 rng(42);
+    for (int64_t survivors : {0, 5, 100, 1000, 2000, 5000, 9000}) {
+        faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+        std::vector<int64_t> rows(nb);
+        std::iota(rows.begin(), rows.end(), 0);
+        std::shuffle(rows.begin(), rows.end(), rng);
+        for (auto i = survivors; i < nb; ++i) {
+            bitset->set(rows[i]);
+        }
+
+        auto result = index_->Query(query_dataset, conf, bitset);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        int64_t hits = 0;
+        for (int64_t i = 0; i < nq; ++i) {
+            // exact answer over the surviving rows
+            std::vector<std::pair<float, int64_t>> exact;
+            for (int64_t row = 0; row < nb; ++row) {
+                if (bitset->test(row)) {
+                    continue;
+                }
+                float dist = 0;
+                for (int64_t d = 0; d < dim; ++d) {
+                    auto diff = xq[i * dim + d] - xb[row * dim + d];
+                    dist += diff * diff;
+                }
+                exact.emplace_back(dist, row);
+            }
+            auto expected = std::min<int64_t>(k, survivors);
+            std::partial_sort(exact.begin(), exact.begin() + expected, exact.end());
+            std::unordered_set<int64_t> truth;
+            for (int64_t j = 0; j < expected; ++j) {
+                truth.insert(exact[j].second);
+            }
+
+            for (int64_t j = 0; j < k; ++j) {
+                auto id = ids[i * k + j];
+                if (j >= expected) {
+                    ASSERT_EQ(id, -1) << survivors;
+                    continue;
+                }
+                ASSERT_NE(id, -1) << survivors;
+                ASSERT_FALSE(bitset->test(id)) << survivors;
+                hits += truth.count(id);
+            }
+        }
+        if (survivors > 0) {
+            EXPECT_GE(hits, 0.9 * nq * std::min<int64_t>(k, survivors)) << survivors;
+        }
+        ReleaseQueryResult(result);
+    }
+}
+
+TEST_P(HNSWTest, HNSW_batch) {
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+
+    // an empty bitset takes the interleaved batch walk, a bitset without set bits the one-query walk,
+    // both visit the same nodes
+    faiss::ConcurrentBitsetPtr no_filter = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (auto ef : {10, 64, 200}) {
+        conf[milvus::knowhere::IndexParams::ef] = ef;
+        auto batched = index_->Query(query_dataset, conf, nullptr);
+        auto single = index_->Query(query_dataset, conf, no_filter);
+        AssertAnns(batched, nq, k);
+        auto batched_ids = batched->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto batched_dist = batched->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto single_ids = single->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto single_dist = single->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            ASSERT_EQ(batched_ids[i], single_ids[i]) << ef;
+            ASSERT_EQ(batched_dist[i], single_dist[i]) << ef;
+        }
+        ReleaseQueryResult(batched);
+        ReleaseQueryResult(single);
+    }
+}
+
+TEST_P(HNSWTest, HNSW_batch_ties) {
+    // every row repeats one of a few vectors, so both walks meet many ties and must break them alike
+    constexpr int64_t rows = 2000;
+    constexpr int64_t distinct = 4;
+    std::vector<float> data(rows * dim);
+    for (int64_t i = 0; i < rows; ++i) {
+        std::copy_n(xb.data() + (i % distinct) * dim, dim, data.data() + i * dim);
+    }
+    auto dataset = milvus::knowhere::GenDataset(rows, dim, data.data());
+    conf[milvus::knowhere::IndexParams::efConstruction] = 40;
+    index_->Train(dataset, conf);
+    index_->AddWithoutIds(dataset, conf);
+
+    faiss::ConcurrentBitsetPtr no_filter = std::make_shared<faiss::ConcurrentBitset>(rows);
+    for (auto ef : {10, 64}) {
+        conf[milvus::knowhere::IndexParams::ef] = ef;
+        auto batched = index_->Query(query_dataset, conf, nullptr);
+        auto single = index_->Query(query_dataset, conf, no_filter);
+        auto batched_ids = batched->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto batched_dist = batched->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto single_ids = single->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto single_dist = single->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            ASSERT_EQ(batched_ids[i], single_ids[i]) << ef;
+            ASSERT_EQ(batched_dist[i], single_dist[i]) << ef;
+        }
+        ReleaseQueryResult(batched);
+        ReleaseQueryResult(single);
+    }
+}
+
+TEST_P(HNSWTest, HNSW_quantized) {
+    index_->Train(base_dataset, conf);
+    index_->AddWithoutIds(base_dataset, conf);
+    index_->UpdateIndexSize();
+    auto flat_size = index_->IndexSize();
+
+    auto raw = std::make_shared<milvus::knowhere::Binary>();
+    raw->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+    raw->size = nb * dim * sizeof(float);
+
+    for (auto quantizer : {milvus::knowhere::Quantizer::FP16, milvus::knowhere::Quantizer::SQ8}) {
+        conf[milvus::knowhere::IndexParams::quantizer] = quantizer;
+        auto index = std::make_shared<milvus::knowhere::IndexHNSW>();
+        index->Train(base_dataset, conf);
+        index->AddWithoutIds(base_dataset, conf);
+        index->UpdateIndexSize();
+        EXPECT_LT(index->IndexSize(), flat_size) << quantizer;
+
+        // every query is a base row and still finds itself first
+        auto result = index->Query(query_dataset, conf, nullptr);
+        AssertAnns(result, nq, k);
+        ReleaseQueryResult(result);
+
+        // loaded with the raw rows, candidates are re-ranked by their exact distances
+        auto bs = index->Serialize(conf);
+        bs.Append(RAW_DATA, raw);
+        auto loaded = std::make_shared<milvus::knowhere::IndexHNSW>();
+        loaded->Load(bs);
+        EXPECT_EQ(loaded->Count(), nb);
+        EXPECT_EQ(loaded->Dim(), dim);
+        conf[milvus::knowhere::IndexParams::refine_k] = 4 * k;
+        auto refined = loaded->Query(query_dataset, conf, nullptr);
+        conf.erase(milvus::knowhere::IndexParams::refine_k);
+        AssertAnns(refined, nq, k);
+
+        auto ids = refined->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto dists = refined->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        int64_t hits = 0;
+        for (int64_t i = 0; i < nq; ++i) {
+            std::vector<float> row_dist(nb, 0);
+            std::vector<std::pair<float, int64_t>> exact;
+            for (int64_t row = 0; row < nb; ++row) {
+                for (int64_t d = 0; d < dim; ++d) {
+                    auto diff = xq[i * dim + d] - xb[row * dim + d];
+                    row_dist[row] += diff * diff;
+                }
+                exact.emplace_back(row_dist[row], row);
+            }
+            std::partial_sort(exact.begin(), exact.begin() + k, exact.end());
+            std::unordered_set<int64_t> truth;
+            for (int64_t j = 0; j < k; ++j) {
+                truth.insert(exact[j].second);
+            }
+            for (int64_t j = 0; j < k; ++j) {
+                auto id = ids[i * k + j];
+                ASSERT_NE(id, -1);
+                EXPECT_NEAR(dists[i * k + j], row_dist[id], 1e-3 * (1 + row_dist[id])) << quantizer;
+                if (j > 0) {
+                    ASSERT_LE(dists[i * k + j - 1], dists[i * k + j]);
+                }
+                hits += truth.count(id);
+            }
+        }
+        EXPECT_GE(hits, 0.9 * nq * k) << quantizer;
+        ReleaseQueryResult(refined);
+    }
+}
+
+TEST_P(HNSWTest, HNSW_parallel_build) {
+    auto stat_level = milvus::knowhere::STATISTICS_LEVEL;
+    milvus::knowhere::STATISTICS_LEVEL = 1;
+    conf[milvus::knowhere::IndexParams::deterministic] = true;
+
+    // a deterministic build links the same graph whatever the number of threads
+    auto build = [&](int threads) {
+        omp_set_num_threads(threads);
+        auto index = std::make_shared<milvus::knowhere::IndexHNSW>();
+        index->Train(base_dataset, conf);
+        index->AddWithoutIds(base_dataset, conf);
+        EXPECT_EQ(index->Count(), nb);
+        auto stats = std::static_pointer_cast<milvus::knowhere::LibHNSWStatistics>(index->GetStatistics());
+        EXPECT_DOUBLE_EQ(stats->BuildProgress(), 1.0);
+        return index;
+    };
+    auto threads = omp_get_max_threads();
+    auto serial = build(1);
+    auto parallel = build(4);
+    omp_set_num_threads(threads);
+    milvus::knowhere::STATISTICS_LEVEL = stat_level;
+
+    auto serial_bin = serial->Serialize(conf).GetByName("HNSW");
+    auto parallel_bin = parallel->Serialize(conf).GetByName("HNSW");
+    ASSERT_EQ(serial_bin->size, parallel_bin->size);
+    EXPECT_EQ(memcmp(serial_bin->data.get(), parallel_bin->data.get(), serial_bin->size), 0);
+
+    auto result = parallel->Query(query_dataset, conf, nullptr);
+    AssertAnns(result, nq, k);
+    ReleaseQueryResult(result);
+}
+
 TEST_P(HNSWTest, HNSW_delete) {
     assert(!xb.empty());
 
@@ -47,6 +47,7 @@ ShowInstructionSet() {
     support_message("AVX512F", instruction_set_inst.AVX512F());
     support_message("AVX512PF", instruction_set_inst.AVX512PF());
     support_message("AVX512VL", instruction_set_inst.AVX512VL());
+    support_message("AVX512VPOPCNTDQ", instruction_set_inst.AVX512VPOPCNTDQ());
     support_message("BMI1", instruction_set_inst.BMI1());
     support_message("BMI2", instruction_set_inst.BMI2());
     support_message("CLFSH", instruction_set_inst.CLFSH());
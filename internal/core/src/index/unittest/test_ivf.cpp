@@ -234,6 +234,55 @@ TEST_P(IVFTest, ivf_slice) {
     }
 }
 
+TEST_P(IVFTest, ivf_zero_copy_load) {
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    auto ref_result = index_->Query(query_dataset, conf_, nullptr);
+    auto topk = conf_[milvus::knowhere::meta::TOPK].get<int64_t>();
+    auto ref_ids = ref_result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto ref_dis = ref_result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+
+    auto check = [&](const milvus::knowhere::DatasetPtr& result) {
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto dis = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * topk; ++i) {
+            ASSERT_EQ(ids[i], ref_ids[i]);
+            ASSERT_EQ(dis[i], ref_dis[i]);
+        }
+        ReleaseQueryResult(result);
+    };
+
+    // an owned copy of the serialized index, which the loaded index keeps and points into
+    auto owned_binary_set = [](const milvus::knowhere::BinarySet& binary_set) {
+        milvus::knowhere::BinarySet owned;
+        for (auto& [name, bin] : binary_set.binary_map_) {
+            auto copy = std::make_shared<milvus::knowhere::Binary>();
+            copy->data = std::shared_ptr<uint8_t[]>(new uint8_t[bin->size]);
+            memcpy(copy->data.get(), bin->data.get(), bin->size);
+            copy->size = bin->size;
+            copy->owned = true;
+            owned.Append(name, copy);
+        }
+        return owned;
+    };
+
+    auto binaryset = owned_binary_set(index_->Serialize(conf_));
+    std::weak_ptr<uint8_t[]> buffer = binaryset.GetByName("IVF")->data;
+    index_->Load(binaryset);
+    binaryset.clear();
+#ifndef MILVUS_GPU_VERSION
+    EXPECT_FALSE(buffer.expired());
+#endif
+    EXPECT_EQ(index_->Count(), nb);
+    check(index_->Query(query_dataset, conf_, nullptr));
+
+    // an index loaded in place serializes like any other
+    auto reloaded = owned_binary_set(index_->Serialize(conf_));
+    index_->Load(reloaded);
+    check(index_->Query(query_dataset, conf_, nullptr));
+    ReleaseQueryResult(ref_result);
+}
+
 // TODO(linxj): deprecated
 #ifdef MILVUS_GPU_VERSION
 TEST_P(IVFTest, clone_test) {
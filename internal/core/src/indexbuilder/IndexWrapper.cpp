@@ -11,7 +11,9 @@
 
 #include <map>
 #include <exception>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/text_format.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include "pb/index_cgo_msg.pb.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
@@ -261,25 +263,56 @@ IndexWrapper::Serialize() {
     return binary;
 }
 
-void
-IndexWrapper::Load(const char* serialized_sliced_blob_buffer, int32_t size) {
-    namespace indexcgo = milvus::proto::indexcgo;
-    auto data = std::string(serialized_sliced_blob_buffer, size);
-    indexcgo::BinarySet blob_buffer;
+// walks the wire format of indexcgo::BinarySet in place, every value is a view of the buffer instead of a copy
+static void
+ParseSlicedBlobBuffer(const char* buffer, int32_t size, knowhere::BinarySet& binary_set) {
+    using google::protobuf::internal::WireFormatLite;
+    auto base = reinterpret_cast<const uint8_t*>(buffer);
+    google::protobuf::io::CodedInputStream input(base, size);
+    auto is_bytes = [](uint32_t tag, int number) {
+        return WireFormatLite::GetTagFieldNumber(tag) == number &&
+               WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+    };
 
-    auto ok = blob_buffer.ParseFromString(data);
-    Assert(ok);
+    while (auto tag = input.ReadTag()) {
+        if (!is_bytes(tag, 1)) {
+            AssertInfo(WireFormatLite::SkipField(&input, tag), "malformed index blob buffer");
+            continue;
+        }
+        uint32_t length;
+        AssertInfo(input.ReadVarint32(&length), "malformed index blob buffer");
+        auto limit = input.PushLimit(length);
+        std::string key;
+        auto binary = std::make_shared<knowhere::Binary>();
+        while (auto field_tag = input.ReadTag()) {
+            uint32_t field_length;
+            if (is_bytes(field_tag, 1)) {
+                AssertInfo(input.ReadVarint32(&field_length) && input.ReadString(&key, field_length),
+                           "malformed index blob key");
+            } else if (is_bytes(field_tag, 2)) {
+                AssertInfo(input.ReadVarint32(&field_length), "malformed index blob value");
+                auto value = const_cast<uint8_t*>(base + input.CurrentPosition());
+                AssertInfo(input.Skip(field_length), "index blob value is truncated");
+                // the caller keeps the buffer until loading returns
+                binary->data = std::shared_ptr<uint8_t[]>(value, [](uint8_t*) {});
+                binary->size = field_length;
+            } else {
+                AssertInfo(WireFormatLite::SkipField(&input, field_tag), "malformed index blob");
+            }
+        }
+        AssertInfo(input.BytesUntilLimit() == 0, "malformed index blob");
+        input.PopLimit(limit);
+        binary_set.Append(key, binary);
+    }
+    AssertInfo(input.CurrentPosition() == size, "malformed index blob buffer");
+}
 
+void
+IndexWrapper::Load(const char* serialized_sliced_blob_buffer, int32_t size) {
     milvus::knowhere::BinarySet binarySet;
-    for (auto i = 0; i < blob_buffer.datas_size(); i++) {
-        const auto& binary = blob_buffer.datas(i);
-        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
-        auto bptr = std::make_shared<milvus::knowhere::Binary>();
-        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)binary.value().c_str(), deleter);
-        bptr->size = binary.value().length();
-        binarySet.Append(binary.key(), bptr);
-    }
+    ParseSlicedBlobBuffer(serialized_sliced_blob_buffer, size, binarySet);
 
+    // sliced binaries are assembled into owned buffers, which the index then points into
     index_->Load(binarySet);
 }
 
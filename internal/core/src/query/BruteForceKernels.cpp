@@ -0,0 +1,253 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/BruteForceKernels.h"
+#include <omp.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <faiss/utils/Heap.h>
+#include "query/BruteForceKernelsImpl.h"
+#include "query/SimdLevel.h"
+#include "utils/tools.h"
+
+namespace milvus::query {
+namespace {
+using simd::TileQueries;
+using simd::TileRows;
+using TileFunc = void (*)(const float* rows_t, const float* queries, int64_t dim, float* out);
+
+// chunks with fewer rows are scanned by a single thread
+constexpr int64_t ParallelRows = 64 * 1024;
+
+void
+l2_tile_scalar(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    simd::distance_tile<simd::ScalarFloatSimd, false>(rows_t, queries, dim, out);
+}
+
+void
+ip_tile_scalar(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    simd::distance_tile<simd::ScalarFloatSimd, true>(rows_t, queries, dim, out);
+}
+
+// bit j is set iff row begin + j is filtered out or past the end of the base
+uint64_t
+FilteredMask(const faiss::BitsetView& bitset, int64_t begin, int64_t num_rows) {
+    auto rows = std::min(TileRows, num_rows - begin);
+    uint64_t mask = 0;
+    if (!bitset.empty() && begin + TileRows <= bitset.size()) {
+        // begin is a multiple of 64, so the word starts on a byte boundary
+        memcpy(&mask, bitset.data() + begin / 8, sizeof(mask));
+    } else if (!bitset.empty()) {
+        for (int64_t j = 0; j < rows && begin + j < bitset.size(); ++j) {
+            mask |= uint64_t(bitset.test(begin + j)) << j;
+        }
+    }
+    if (rows < TileRows) {
+        mask |= ~uint64_t(0) << rows;
+    }
+    return mask;
+}
+
+template <typename C>
+void
+KnnBlocked(TileFunc tile,
+           const float* queries,
+           int64_t num_queries,
+           const uint8_t* base,
+           VectorPrecision precision,
+           int64_t num_rows,
+           int64_t dim,
+           int64_t topk,
+           const faiss::BitsetView& bitset,
+           float* values,
+           int64_t* labels) {
+    // queries are padded with zero rows up to whole tiles
+    auto num_groups = upper_div(num_queries, TileQueries);
+    std::vector<float> padded_queries(num_groups * TileQueries * dim, 0);
+    std::copy_n(queries, num_queries * dim, padded_queries.data());
+
+    auto num_blocks = upper_div(num_rows, TileRows);
+    int64_t num_threads = 1;
+    if (num_rows >= ParallelRows) {
+        num_threads = std::max<int64_t>(1, std::min<int64_t>(omp_get_max_threads(), num_blocks));
+    }
+
+    // every thread keeps private heaps over its own range of blocks, merged once at the end
+    auto heap_size = num_queries * topk;
+    std::vector<float> thread_values(num_threads * heap_size);
+    std::vector<int64_t> thread_labels(num_threads * heap_size);
+    std::vector<float> thread_rows_t(num_threads * dim * TileRows);
+    auto code_size = vector_code_sizeof(precision, dim);
+    auto compact = precision != VectorPrecision::FP32;
+    std::vector<float> thread_decoded(compact ? num_threads * dim * TileRows : 0);
+    std::vector<float> thread_distances(num_threads * TileQueries * TileRows);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+    for (int64_t t = 0; t < num_threads; ++t) {
+        auto heap_values = thread_values.data() + t * heap_size;
+        auto heap_labels = thread_labels.data() + t * heap_size;
+        auto rows_t = thread_rows_t.data() + t * dim * TileRows;
+        auto decoded = compact ? thread_decoded.data() + t * dim * TileRows : nullptr;
+        auto distances = thread_distances.data() + t * TileQueries * TileRows;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            faiss::heap_heapify<C>(topk, heap_values + q * topk, heap_labels + q * topk);
+        }
+
+        auto block_begin = num_blocks * t / num_threads;
+        auto block_end = num_blocks * (t + 1) / num_threads;
+        for (auto block = block_begin; block < block_end; ++block) {
+            auto begin = block * TileRows;
+            auto filtered = FilteredMask(bitset, begin, num_rows);
+            if (filtered == ~uint64_t(0)) {
+                continue;
+            }
+
+            // transpose the block so that one component of every row is contiguous, rows past the end are zero
+            auto rows = std::min(TileRows, num_rows - begin);
+            auto src = reinterpret_cast<const float*>(base + begin * code_size);
+            if (compact) {
+                DecodeVectors(precision, base + begin * code_size, rows, dim, decoded);
+                src = decoded;
+            }
+            for (int64_t j = 0; j < rows; ++j) {
+                for (int64_t d = 0; d < dim; ++d) {
+                    rows_t[d * TileRows + j] = src[j * dim + d];
+                }
+            }
+            for (int64_t d = 0; rows < TileRows && d < dim; ++d) {
+                std::fill(rows_t + d * TileRows + rows, rows_t + (d + 1) * TileRows, 0.0f);
+            }
+
+            for (int64_t group = 0; group < num_groups; ++group) {
+                tile(rows_t, padded_queries.data() + group * TileQueries * dim, dim, distances);
+                auto group_queries = std::min(TileQueries, num_queries - group * TileQueries);
+                for (int64_t q = 0; q < group_queries; ++q) {
+                    auto query_values = heap_values + (group * TileQueries + q) * topk;
+                    auto query_labels = heap_labels + (group * TileQueries + q) * topk;
+                    for (auto live = ~filtered; live != 0; live &= live - 1) {
+                        auto j = __builtin_ctzll(live);
+                        auto dis = distances[q * TileRows + j];
+                        if (C::cmp(query_values[0], dis)) {
+                            faiss::heap_swap_top<C>(topk, query_values, query_labels, dis, begin + j);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query_values = values + q * topk;
+        auto query_labels = labels + q * topk;
+        if (num_threads == 1) {
+            std::copy_n(thread_values.data() + q * topk, topk, query_values);
+            std::copy_n(thread_labels.data() + q * topk, topk, query_labels);
+        } else {
+            faiss::heap_heapify<C>(topk, query_values, query_labels);
+            for (int64_t t = 0; t < num_threads; ++t) {
+                auto offset = t * heap_size + q * topk;
+                for (int64_t i = 0; i < topk; ++i) {
+                    auto dis = thread_values[offset + i];
+                    if (thread_labels[offset + i] != -1 && C::cmp(query_values[0], dis)) {
+                        faiss::heap_swap_top<C>(topk, query_values, query_labels, dis, thread_labels[offset + i]);
+                    }
+                }
+            }
+        }
+        faiss::heap_reorder<C>(topk, query_values, query_labels);
+    }
+}
+
+TileFunc
+l2_tile() {
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX512:
+            return simd::l2_tile_avx512;
+        case SimdLevel::AVX2:
+            return simd::l2_tile_avx2;
+        default:
+            return l2_tile_scalar;
+    }
+}
+
+TileFunc
+ip_tile() {
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX512:
+            return simd::ip_tile_avx512;
+        case SimdLevel::AVX2:
+            return simd::ip_tile_avx2;
+        default:
+            return ip_tile_scalar;
+    }
+}
+}  // namespace
+
+void
+KnnL2Blocked(const float* queries,
+             int64_t num_queries,
+             const float* base,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels) {
+    KnnL2Compact(queries, num_queries, reinterpret_cast<const uint8_t*>(base), VectorPrecision::FP32, num_rows, dim,
+                 topk, bitset, values, labels);
+}
+
+void
+KnnIPBlocked(const float* queries,
+             int64_t num_queries,
+             const float* base,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels) {
+    KnnIPCompact(queries, num_queries, reinterpret_cast<const uint8_t*>(base), VectorPrecision::FP32, num_rows, dim,
+                 topk, bitset, values, labels);
+}
+
+void
+KnnL2Compact(const float* queries,
+             int64_t num_queries,
+             const uint8_t* codes,
+             VectorPrecision precision,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels) {
+    KnnBlocked<faiss::CMax<float, int64_t>>(l2_tile(), queries, num_queries, codes, precision, num_rows, dim, topk,
+                                            bitset, values, labels);
+}
+
+void
+KnnIPCompact(const float* queries,
+             int64_t num_queries,
+             const uint8_t* codes,
+             VectorPrecision precision,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels) {
+    KnnBlocked<faiss::CMin<float, int64_t>>(ip_tile(), queries, num_queries, codes, precision, num_rows, dim, topk,
+                                            bitset, values, labels);
+}
+
+}  // namespace milvus::query
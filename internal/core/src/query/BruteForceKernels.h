@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <cstdint>
+#include <faiss/utils/BitsetView.h>
+#include "common/VectorPrecision.h"
+
+namespace milvus::query {
+// Exact float top-k for small query batches, dispatched to AVX-512 / AVX2 / scalar at runtime.
+// Queries are scored against the base in tiles of 4 queries x 64 rows, and a whole tile is skipped when
+// its 64-bit word of the bitset filters out every row, so heavily filtered chunks cost little more than the bitset scan.
+// values / labels receive num_queries sorted lists of topk entries, missing entries are labeled -1.
+
+void
+KnnL2Blocked(const float* queries,
+             int64_t num_queries,
+             const float* base,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels);
+
+void
+KnnIPBlocked(const float* queries,
+             int64_t num_queries,
+             const float* base,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels);
+
+// the same over rows stored at reduced precision, every block of 64 rows is decoded into the tile right before
+// it is scored, so the base is only ever read in its compact form.
+void
+KnnL2Compact(const float* queries,
+             int64_t num_queries,
+             const uint8_t* codes,
+             VectorPrecision precision,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels);
+
+void
+KnnIPCompact(const float* queries,
+             int64_t num_queries,
+             const uint8_t* codes,
+             VectorPrecision precision,
+             int64_t num_rows,
+             int64_t dim,
+             int64_t topk,
+             const faiss::BitsetView& bitset,
+             float* values,
+             int64_t* labels);
+
+}  // namespace milvus::query
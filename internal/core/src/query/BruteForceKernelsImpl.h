@@ -0,0 +1,104 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+// Shared body of the brute-force distance tiles, included by every instruction set specific translation unit.
+// Same rules as ExprKernelsImpl.h: no other project headers, everything in an unnamed namespace.
+#include <cstdint>
+
+namespace milvus::query::simd {
+// a tile is TileQueries queries against TileRows base rows
+constexpr int64_t TileQueries = 4;
+constexpr int64_t TileRows = 64;
+
+// rows_t holds the tile rows transposed, rows_t[d * TileRows + j] is component d of row j,
+// queries holds TileQueries rows of dim floats, out[q * TileRows + j] receives the distance of query q to row j
+void
+l2_tile_avx2(const float* rows_t, const float* queries, int64_t dim, float* out);
+void
+ip_tile_avx2(const float* rows_t, const float* queries, int64_t dim, float* out);
+void
+l2_tile_avx512(const float* rows_t, const float* queries, int64_t dim, float* out);
+void
+ip_tile_avx512(const float* rows_t, const float* queries, int64_t dim, float* out);
+
+namespace {
+struct ScalarFloatSimd {
+    using Reg = float;
+    static constexpr int lanes = 1;
+    static Reg
+    zero() {
+        return 0;
+    }
+    static Reg
+    load(const float* ptr) {
+        return *ptr;
+    }
+    static void
+    store(float* ptr, Reg x) {
+        *ptr = x;
+    }
+    static Reg
+    set1(float val) {
+        return val;
+    }
+    static Reg
+    sub(Reg a, Reg b) {
+        return a - b;
+    }
+    // a * b + c
+    static Reg
+    madd(Reg a, Reg b, Reg c) {
+        return a * b + c;
+    }
+};
+
+// every query of the tile keeps Unroll registers of accumulators over a strip of Unroll * lanes rows,
+// the transposed layout makes one component of the whole strip a contiguous load,
+// and each query component is broadcast once per strip
+template <typename Simd, bool is_ip, int Unroll = 2>
+inline void
+distance_tile(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    constexpr int64_t strip = Unroll * Simd::lanes;
+    static_assert(TileRows % strip == 0);
+    for (int64_t offset = 0; offset < TileRows; offset += strip) {
+        typename Simd::Reg acc[TileQueries][Unroll];
+        for (int64_t q = 0; q < TileQueries; ++q) {
+            for (int u = 0; u < Unroll; ++u) {
+                acc[q][u] = Simd::zero();
+            }
+        }
+        for (int64_t d = 0; d < dim; ++d) {
+            typename Simd::Reg rows[Unroll];
+            for (int u = 0; u < Unroll; ++u) {
+                rows[u] = Simd::load(rows_t + d * TileRows + offset + u * Simd::lanes);
+            }
+            for (int64_t q = 0; q < TileQueries; ++q) {
+                auto x = Simd::set1(queries[q * dim + d]);
+                for (int u = 0; u < Unroll; ++u) {
+                    if constexpr (is_ip) {
+                        acc[q][u] = Simd::madd(rows[u], x, acc[q][u]);
+                    } else {
+                        auto diff = Simd::sub(rows[u], x);
+                        acc[q][u] = Simd::madd(diff, diff, acc[q][u]);
+                    }
+                }
+            }
+        }
+        for (int64_t q = 0; q < TileQueries; ++q) {
+            for (int u = 0; u < Unroll; ++u) {
+                Simd::store(out + q * TileRows + offset + u * Simd::lanes, acc[q][u]);
+            }
+        }
+    }
+}
+}  // namespace
+}  // namespace milvus::query::simd
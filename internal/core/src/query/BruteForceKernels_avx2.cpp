@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// compiled with -mavx2
+#include <immintrin.h>
+#include "query/BruteForceKernelsImpl.h"
+
+namespace milvus::query::simd {
+namespace {
+struct Avx2FloatSimd {
+    using Reg = __m256;
+    static constexpr int lanes = 8;
+    static Reg
+    zero() {
+        return _mm256_setzero_ps();
+    }
+    static Reg
+    load(const float* ptr) {
+        return _mm256_loadu_ps(ptr);
+    }
+    static void
+    store(float* ptr, Reg x) {
+        _mm256_storeu_ps(ptr, x);
+    }
+    static Reg
+    set1(float val) {
+        return _mm256_set1_ps(val);
+    }
+    static Reg
+    sub(Reg a, Reg b) {
+        return _mm256_sub_ps(a, b);
+    }
+    // fma is not part of -mavx2
+    static Reg
+    madd(Reg a, Reg b, Reg c) {
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+    }
+};
+}  // namespace
+
+void
+l2_tile_avx2(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    distance_tile<Avx2FloatSimd, false>(rows_t, queries, dim, out);
+}
+
+void
+ip_tile_avx2(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    distance_tile<Avx2FloatSimd, true>(rows_t, queries, dim, out);
+}
+}  // namespace milvus::query::simd
@@ -0,0 +1,57 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// compiled with -mavx512f -mavx512dq -mavx512bw
+#include <immintrin.h>
+#include "query/BruteForceKernelsImpl.h"
+
+namespace milvus::query::simd {
+namespace {
+struct Avx512FloatSimd {
+    using Reg = __m512;
+    static constexpr int lanes = 16;
+    static Reg
+    zero() {
+        return _mm512_setzero_ps();
+    }
+    static Reg
+    load(const float* ptr) {
+        return _mm512_loadu_ps(ptr);
+    }
+    static void
+    store(float* ptr, Reg x) {
+        _mm512_storeu_ps(ptr, x);
+    }
+    static Reg
+    set1(float val) {
+        return _mm512_set1_ps(val);
+    }
+    static Reg
+    sub(Reg a, Reg b) {
+        return _mm512_sub_ps(a, b);
+    }
+    static Reg
+    madd(Reg a, Reg b, Reg c) {
+        return _mm512_fmadd_ps(a, b, c);
+    }
+};
+}  // namespace
+
+void
+l2_tile_avx512(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    distance_tile<Avx512FloatSimd, false>(rows_t, queries, dim, out);
+}
+
+void
+ip_tile_avx512(const float* rows_t, const float* queries, int64_t dim, float* out) {
+    distance_tile<Avx512FloatSimd, true>(rows_t, queries, dim, out);
+}
+}  // namespace milvus::query::simd
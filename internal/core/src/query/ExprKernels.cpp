@@ -0,0 +1,171 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/ExprKernels.h"
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include "exceptions/EasyAssert.h"
+#include "query/ExprKernelsImpl.h"
+#include "query/SimdLevel.h"
+
+namespace milvus::query {
+namespace {
+using simd::CmpOp;
+
+CmpOp
+ToCmpOp(RangeExpr::OpType op) {
+    switch (op) {
+        case RangeExpr::OpType::Equal:
+            return CmpOp::Equal;
+        case RangeExpr::OpType::NotEqual:
+            return CmpOp::NotEqual;
+        case RangeExpr::OpType::GreaterThan:
+            return CmpOp::GreaterThan;
+        case RangeExpr::OpType::GreaterEqual:
+            return CmpOp::GreaterEqual;
+        case RangeExpr::OpType::LessThan:
+            return CmpOp::LessThan;
+        case RangeExpr::OpType::LessEqual:
+            return CmpOp::LessEqual;
+        default:
+            PanicInfo("unsupported range op");
+    }
+}
+
+// bool is stored as one byte of 0 or 1, so its kernels are the int8 ones
+template <typename T>
+using KernelType = std::conditional_t<std::is_same_v<T, bool>, int8_t, T>;
+}  // namespace
+
+template <typename T>
+void
+RangeKernel(const T* data_raw,
+            int64_t size,
+            RangeExpr::OpType op_raw,
+            T val_raw,
+            uint64_t* words,
+            const uint64_t* live) {
+    using U = KernelType<T>;
+    auto data = reinterpret_cast<const U*>(data_raw);
+    auto val = static_cast<U>(val_raw);
+    auto op = ToCmpOp(op_raw);
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX512:
+            return simd::compare_range_avx512(data, size, op, val, words, live);
+        case SimdLevel::AVX2:
+            return simd::compare_range_avx2(data, size, op, val, words, live);
+        default:
+            return simd::compare_range<simd::ScalarSimd<U>>(data, size, op, val, words, live);
+    }
+}
+
+template <typename T>
+void
+BetweenKernel(const T* data_raw,
+              int64_t size,
+              bool lower_inclusive,
+              T lower_raw,
+              bool upper_inclusive,
+              T upper_raw,
+              uint64_t* words,
+              const uint64_t* live) {
+    using U = KernelType<T>;
+    auto data = reinterpret_cast<const U*>(data_raw);
+    auto lower = static_cast<U>(lower_raw);
+    auto upper = static_cast<U>(upper_raw);
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX512:
+            return simd::compare_between_avx512(data, size, lower_inclusive, lower, upper_inclusive, upper, words,
+                                                live);
+        case SimdLevel::AVX2:
+            return simd::compare_between_avx2(data, size, lower_inclusive, lower, upper_inclusive, upper, words, live);
+        default:
+            return simd::compare_between<simd::ScalarSimd<U>>(data, size, lower_inclusive, lower, upper_inclusive,
+                                                              upper, words, live);
+    }
+}
+
+template <typename T>
+TermKernel<T>::TermKernel(const T* terms, int64_t num_terms) {
+    for (int64_t i = 0; i < num_terms; ++i) {
+        terms_.push_back(static_cast<Storage>(terms[i]));
+    }
+    if (num_terms <= simd::MaxBroadcastTerms) {
+        return;
+    }
+    int64_t capacity = 16;
+    while (capacity < num_terms * 2) {
+        capacity *= 2;
+    }
+    slots_.resize(capacity);
+    occupied_.resize(capacity, false);
+    for (auto term : terms_) {
+        if (contains(term)) {
+            continue;
+        }
+        auto slot = std::hash<Storage>()(term) & (capacity - 1);
+        while (occupied_[slot]) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        slots_[slot] = term;
+        occupied_[slot] = true;
+    }
+}
+
+template <typename T>
+bool
+TermKernel<T>::contains(Storage value) const {
+    auto mask = slots_.size() - 1;
+    for (auto slot = std::hash<Storage>()(value) & mask; occupied_[slot]; slot = (slot + 1) & mask) {
+        if (slots_[slot] == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void
+TermKernel<T>::operator()(const T* data_raw, int64_t size, uint64_t* words, const uint64_t* live) const {
+    using U = Storage;
+    auto data = reinterpret_cast<const U*>(data_raw);
+    auto terms = terms_.data();
+    int64_t num_terms = terms_.size();
+    if (num_terms > simd::MaxBroadcastTerms) {
+        auto is_in = [&](U x) { return contains(x); };
+        simd::fill_words<simd::ScalarSimd<U>>(
+            data, size, [&](const U* src) { return uint64_t(is_in(*src)); }, is_in, words, live);
+        return;
+    }
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX512:
+            return simd::compare_terms_avx512(data, size, terms, num_terms, words, live);
+        case SimdLevel::AVX2:
+            return simd::compare_terms_avx2(data, size, terms, num_terms, words, live);
+        default:
+            return simd::compare_terms<simd::ScalarSimd<U>>(data, size, terms, num_terms, words, live);
+    }
+}
+
+#define INSTANTIATE_EXPR_KERNELS(T)                                                                    \
+    template void RangeKernel<T>(const T*, int64_t, RangeExpr::OpType, T, uint64_t*, const uint64_t*); \
+    template void BetweenKernel<T>(const T*, int64_t, bool, T, bool, T, uint64_t*, const uint64_t*);   \
+    template class TermKernel<T>;
+
+INSTANTIATE_EXPR_KERNELS(bool)
+INSTANTIATE_EXPR_KERNELS(int8_t)
+INSTANTIATE_EXPR_KERNELS(int16_t)
+INSTANTIATE_EXPR_KERNELS(int32_t)
+INSTANTIATE_EXPR_KERNELS(int64_t)
+INSTANTIATE_EXPR_KERNELS(float)
+INSTANTIATE_EXPR_KERNELS(double)
+}  // namespace milvus::query
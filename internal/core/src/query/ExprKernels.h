@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "query/Expr.h"
+
+namespace milvus::query {
+// Predicate kernels over raw chunk data, dispatched to AVX-512 / AVX2 / scalar at runtime.
+// Results are packed into 64-bit words: bit i of words[i / 64] is set iff data[i] satisfies the predicate,
+// words must hold upper_div(size, 64) elements, bits beyond size are zeroed.
+// An optional live mask of the same layout skips the words where it is zero, those are left zero.
+
+// data[i] op val
+template <typename T>
+void
+RangeKernel(
+    const T* data, int64_t size, RangeExpr::OpType op, T val, uint64_t* words, const uint64_t* live = nullptr);
+
+// lower (< or <=) data[i] (< or <=) upper
+template <typename T>
+void
+BetweenKernel(const T* data,
+              int64_t size,
+              bool lower_inclusive,
+              T lower,
+              bool upper_inclusive,
+              T upper,
+              uint64_t* words,
+              const uint64_t* live = nullptr);
+
+// data[i] in terms, small sets are matched by broadcast compares, larger ones by a hash set built once
+template <typename T>
+class TermKernel {
+ public:
+    TermKernel(const T* terms, int64_t num_terms);
+
+    void
+    operator()(const T* data, int64_t size, uint64_t* words, const uint64_t* live = nullptr) const;
+
+ private:
+    // bool is stored as one byte of 0 or 1, so it shares the int8 kernels
+    using Storage = std::conditional_t<std::is_same_v<T, bool>, int8_t, T>;
+
+    bool
+    contains(Storage value) const;
+
+ private:
+    std::vector<Storage> terms_;
+    // open addressing hash set, only used by large sets
+    std::vector<Storage> slots_;
+    std::vector<bool> occupied_;
+};
+
+}  // namespace milvus::query
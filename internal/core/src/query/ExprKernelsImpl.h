@@ -0,0 +1,224 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+// Shared body of the predicate kernels, included by every instruction set specific translation unit.
+// Keep it free of other project headers: everything here is compiled with different -m flags,
+// so it lives in an unnamed namespace to prevent the linker from mixing up instantiations.
+#include <cstdint>
+
+namespace milvus::query::simd {
+enum class CmpOp { Equal, NotEqual, GreaterThan, GreaterEqual, LessThan, LessEqual };
+
+// terms up to this count are matched by broadcast compares, larger sets go through a hash set
+constexpr int64_t MaxBroadcastTerms = 8;
+
+template <typename T>
+void
+compare_range_avx2(const T* data, int64_t size, CmpOp op, T val, uint64_t* words, const uint64_t* live);
+template <typename T>
+void
+compare_between_avx2(const T* data,
+                     int64_t size,
+                     bool lower_inclusive,
+                     T lower,
+                     bool upper_inclusive,
+                     T upper,
+                     uint64_t* words,
+                     const uint64_t* live);
+template <typename T>
+void
+compare_terms_avx2(
+    const T* data, int64_t size, const T* terms, int64_t num_terms, uint64_t* words, const uint64_t* live);
+
+template <typename T>
+void
+compare_range_avx512(const T* data, int64_t size, CmpOp op, T val, uint64_t* words, const uint64_t* live);
+template <typename T>
+void
+compare_between_avx512(const T* data,
+                       int64_t size,
+                       bool lower_inclusive,
+                       T lower,
+                       bool upper_inclusive,
+                       T upper,
+                       uint64_t* words,
+                       const uint64_t* live);
+template <typename T>
+void
+compare_terms_avx512(
+    const T* data, int64_t size, const T* terms, int64_t num_terms, uint64_t* words, const uint64_t* live);
+
+namespace {
+template <CmpOp op, typename T>
+inline bool
+scalar_compare(T x, T val) {
+    if constexpr (op == CmpOp::Equal) {
+        return x == val;
+    } else if constexpr (op == CmpOp::NotEqual) {
+        return x != val;
+    } else if constexpr (op == CmpOp::GreaterThan) {
+        return x > val;
+    } else if constexpr (op == CmpOp::GreaterEqual) {
+        return x >= val;
+    } else if constexpr (op == CmpOp::LessThan) {
+        return x < val;
+    } else {
+        return x <= val;
+    }
+}
+
+// scalar "register" of one lane, used as the fallback instruction set
+template <typename T>
+struct ScalarSimd {
+    using Reg = T;
+    static constexpr int lanes = 1;
+    static Reg
+    load(const T* ptr) {
+        return *ptr;
+    }
+    static Reg
+    set1(T val) {
+        return val;
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return scalar_compare<op>(x, val);
+    }
+};
+
+// pack the predicate of every element into 64-bit words, bit i of word w stands for data[w * 64 + i],
+// block_func evaluates Simd::lanes elements into the low bits of its result, elem_func handles the tail,
+// words whose live word is zero are skipped and left zero, live may be null
+template <typename Simd, typename T, typename BlockFunc, typename ElemFunc>
+inline void
+fill_words(
+    const T* data, int64_t size, BlockFunc block_func, ElemFunc elem_func, uint64_t* words, const uint64_t* live) {
+    auto num_full_words = size / 64;
+    for (int64_t w = 0; w < num_full_words; ++w) {
+        if (live != nullptr && live[w] == 0) {
+            words[w] = 0;
+            continue;
+        }
+        auto src = data + w * 64;
+        uint64_t word = 0;
+        for (int j = 0; j < 64; j += Simd::lanes) {
+            word |= block_func(src + j) << j;
+        }
+        words[w] = word;
+    }
+    auto remain = size % 64;
+    if (remain != 0 && live != nullptr && live[num_full_words] == 0) {
+        words[num_full_words] = 0;
+    } else if (remain != 0) {
+        auto src = data + num_full_words * 64;
+        uint64_t word = 0;
+        for (int j = 0; j < remain; ++j) {
+            word |= uint64_t(elem_func(src[j])) << j;
+        }
+        words[num_full_words] = word;
+    }
+}
+
+template <typename Simd, CmpOp op, typename T>
+inline void
+compare_range_impl(const T* data, int64_t size, T val, uint64_t* words, const uint64_t* live) {
+    auto reg_val = Simd::set1(val);
+    fill_words<Simd>(
+        data, size, [&](const T* src) { return Simd::template compare<op>(Simd::load(src), reg_val); },
+        [&](T x) { return scalar_compare<op>(x, val); }, words, live);
+}
+
+template <typename Simd, typename T>
+inline void
+compare_range(const T* data, int64_t size, CmpOp op, T val, uint64_t* words, const uint64_t* live) {
+    switch (op) {
+        case CmpOp::Equal:
+            return compare_range_impl<Simd, CmpOp::Equal>(data, size, val, words, live);
+        case CmpOp::NotEqual:
+            return compare_range_impl<Simd, CmpOp::NotEqual>(data, size, val, words, live);
+        case CmpOp::GreaterThan:
+            return compare_range_impl<Simd, CmpOp::GreaterThan>(data, size, val, words, live);
+        case CmpOp::GreaterEqual:
+            return compare_range_impl<Simd, CmpOp::GreaterEqual>(data, size, val, words, live);
+        case CmpOp::LessThan:
+            return compare_range_impl<Simd, CmpOp::LessThan>(data, size, val, words, live);
+        case CmpOp::LessEqual:
+            return compare_range_impl<Simd, CmpOp::LessEqual>(data, size, val, words, live);
+    }
+}
+
+template <typename Simd, CmpOp lower_op, CmpOp upper_op, typename T>
+inline void
+compare_between_impl(const T* data, int64_t size, T lower, T upper, uint64_t* words, const uint64_t* live) {
+    auto reg_lower = Simd::set1(lower);
+    auto reg_upper = Simd::set1(upper);
+    fill_words<Simd>(
+        data, size,
+        [&](const T* src) {
+            auto x = Simd::load(src);
+            return Simd::template compare<lower_op>(x, reg_lower) & Simd::template compare<upper_op>(x, reg_upper);
+        },
+        [&](T x) { return scalar_compare<lower_op>(x, lower) && scalar_compare<upper_op>(x, upper); }, words, live);
+}
+
+template <typename Simd, typename T>
+inline void
+compare_between(const T* data,
+                int64_t size,
+                bool lower_inclusive,
+                T lower,
+                bool upper_inclusive,
+                T upper,
+                uint64_t* words,
+                const uint64_t* live) {
+    if (lower_inclusive && upper_inclusive) {
+        compare_between_impl<Simd, CmpOp::GreaterEqual, CmpOp::LessEqual>(data, size, lower, upper, words, live);
+    } else if (lower_inclusive) {
+        compare_between_impl<Simd, CmpOp::GreaterEqual, CmpOp::LessThan>(data, size, lower, upper, words, live);
+    } else if (upper_inclusive) {
+        compare_between_impl<Simd, CmpOp::GreaterThan, CmpOp::LessEqual>(data, size, lower, upper, words, live);
+    } else {
+        compare_between_impl<Simd, CmpOp::GreaterThan, CmpOp::LessThan>(data, size, lower, upper, words, live);
+    }
+}
+
+// broadcast every term and OR the equal masks, num_terms must not exceed MaxBroadcastTerms
+template <typename Simd, typename T>
+inline void
+compare_terms(
+    const T* data, int64_t size, const T* terms, int64_t num_terms, uint64_t* words, const uint64_t* live) {
+    typename Simd::Reg reg_terms[MaxBroadcastTerms];
+    for (int64_t i = 0; i < num_terms; ++i) {
+        reg_terms[i] = Simd::set1(terms[i]);
+    }
+    fill_words<Simd>(
+        data, size,
+        [&](const T* src) {
+            auto x = Simd::load(src);
+            uint64_t mask = 0;
+            for (int64_t i = 0; i < num_terms; ++i) {
+                mask |= Simd::template compare<CmpOp::Equal>(x, reg_terms[i]);
+            }
+            return mask;
+        },
+        [&](T x) {
+            bool is_in = false;
+            for (int64_t i = 0; i < num_terms; ++i) {
+                is_in |= (x == terms[i]);
+            }
+            return is_in;
+        },
+        words, live);
+}
+}  // namespace
+}  // namespace milvus::query::simd
@@ -0,0 +1,234 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// compiled with -mavx2
+#include <immintrin.h>
+#include "query/ExprKernelsImpl.h"
+
+namespace milvus::query::simd {
+namespace {
+// integers only have equal and greater-than compares, the others are derived by swapping or negating
+template <CmpOp op, typename Reg, typename Eq, typename Gt>
+inline uint64_t
+int_compare(Reg x, Reg val, Eq eq, Gt gt, uint64_t full) {
+    switch (op) {
+        case CmpOp::Equal:
+            return eq(x, val);
+        case CmpOp::NotEqual:
+            return eq(x, val) ^ full;
+        case CmpOp::GreaterThan:
+            return gt(x, val);
+        case CmpOp::GreaterEqual:
+            return gt(val, x) ^ full;
+        case CmpOp::LessThan:
+            return gt(val, x);
+        default:
+            return gt(x, val) ^ full;
+    }
+}
+
+template <CmpOp op>
+constexpr int
+float_predicate() {
+    switch (op) {
+        case CmpOp::Equal:
+            return _CMP_EQ_OQ;
+        case CmpOp::NotEqual:
+            return _CMP_NEQ_UQ;
+        case CmpOp::GreaterThan:
+            return _CMP_GT_OQ;
+        case CmpOp::GreaterEqual:
+            return _CMP_GE_OQ;
+        case CmpOp::LessThan:
+            return _CMP_LT_OQ;
+        default:
+            return _CMP_LE_OQ;
+    }
+}
+
+template <typename T>
+struct Avx2Simd;
+
+template <>
+struct Avx2Simd<int8_t> {
+    using Reg = __m256i;
+    static constexpr int lanes = 32;
+    static Reg
+    load(const int8_t* ptr) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static Reg
+    set1(int8_t val) {
+        return _mm256_set1_epi8(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        auto eq = [](Reg a, Reg b) { return uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)))); };
+        auto gt = [](Reg a, Reg b) { return uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(a, b)))); };
+        return int_compare<op>(x, val, eq, gt, 0xFFFFFFFFULL);
+    }
+};
+
+template <>
+struct Avx2Simd<int16_t> {
+    using Reg = __m256i;
+    static constexpr int lanes = 16;
+    static Reg
+    load(const int16_t* ptr) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static Reg
+    set1(int16_t val) {
+        return _mm256_set1_epi16(val);
+    }
+    static uint64_t
+    movemask(Reg cmp) {
+        // narrow 16-bit lanes to bytes, then one bit per lane
+        auto packed = _mm_packs_epi16(_mm256_castsi256_si128(cmp), _mm256_extracti128_si256(cmp, 1));
+        return uint64_t(uint32_t(_mm_movemask_epi8(packed)));
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        auto eq = [](Reg a, Reg b) { return movemask(_mm256_cmpeq_epi16(a, b)); };
+        auto gt = [](Reg a, Reg b) { return movemask(_mm256_cmpgt_epi16(a, b)); };
+        return int_compare<op>(x, val, eq, gt, 0xFFFFULL);
+    }
+};
+
+template <>
+struct Avx2Simd<int32_t> {
+    using Reg = __m256i;
+    static constexpr int lanes = 8;
+    static Reg
+    load(const int32_t* ptr) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static Reg
+    set1(int32_t val) {
+        return _mm256_set1_epi32(val);
+    }
+    static uint64_t
+    movemask(Reg cmp) {
+        return uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(cmp)));
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        auto eq = [](Reg a, Reg b) { return movemask(_mm256_cmpeq_epi32(a, b)); };
+        auto gt = [](Reg a, Reg b) { return movemask(_mm256_cmpgt_epi32(a, b)); };
+        return int_compare<op>(x, val, eq, gt, 0xFFULL);
+    }
+};
+
+template <>
+struct Avx2Simd<int64_t> {
+    using Reg = __m256i;
+    static constexpr int lanes = 4;
+    static Reg
+    load(const int64_t* ptr) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    static Reg
+    set1(int64_t val) {
+        return _mm256_set1_epi64x(val);
+    }
+    static uint64_t
+    movemask(Reg cmp) {
+        return uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(cmp)));
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        auto eq = [](Reg a, Reg b) { return movemask(_mm256_cmpeq_epi64(a, b)); };
+        auto gt = [](Reg a, Reg b) { return movemask(_mm256_cmpgt_epi64(a, b)); };
+        return int_compare<op>(x, val, eq, gt, 0xFULL);
+    }
+};
+
+template <>
+struct Avx2Simd<float> {
+    using Reg = __m256;
+    static constexpr int lanes = 8;
+    static Reg
+    load(const float* ptr) {
+        return _mm256_loadu_ps(ptr);
+    }
+    static Reg
+    set1(float val) {
+        return _mm256_set1_ps(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return uint64_t(_mm256_movemask_ps(_mm256_cmp_ps(x, val, float_predicate<op>())));
+    }
+};
+
+template <>
+struct Avx2Simd<double> {
+    using Reg = __m256d;
+    static constexpr int lanes = 4;
+    static Reg
+    load(const double* ptr) {
+        return _mm256_loadu_pd(ptr);
+    }
+    static Reg
+    set1(double val) {
+        return _mm256_set1_pd(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return uint64_t(_mm256_movemask_pd(_mm256_cmp_pd(x, val, float_predicate<op>())));
+    }
+};
+}  // namespace
+
+template <typename T>
+void
+compare_range_avx2(const T* data, int64_t size, CmpOp op, T val, uint64_t* words, const uint64_t* live) {
+    compare_range<Avx2Simd<T>>(data, size, op, val, words, live);
+}
+
+template <typename T>
+void
+compare_between_avx2(const T* data,
+                     int64_t size,
+                     bool lower_inclusive,
+                     T lower,
+                     bool upper_inclusive,
+                     T upper,
+                     uint64_t* words,
+                     const uint64_t* live) {
+    compare_between<Avx2Simd<T>>(data, size, lower_inclusive, lower, upper_inclusive, upper, words, live);
+}
+
+template <typename T>
+void
+compare_terms_avx2(
+    const T* data, int64_t size, const T* terms, int64_t num_terms, uint64_t* words, const uint64_t* live) {
+    compare_terms<Avx2Simd<T>>(data, size, terms, num_terms, words, live);
+}
+
+#define INSTANTIATE_AVX2_KERNELS(T)                                                                         \
+    template void compare_range_avx2<T>(const T*, int64_t, CmpOp, T, uint64_t*, const uint64_t*);           \
+    template void compare_between_avx2<T>(const T*, int64_t, bool, T, bool, T, uint64_t*, const uint64_t*); \
+    template void compare_terms_avx2<T>(const T*, int64_t, const T*, int64_t, uint64_t*, const uint64_t*);
+
+INSTANTIATE_AVX2_KERNELS(int8_t)
+INSTANTIATE_AVX2_KERNELS(int16_t)
+INSTANTIATE_AVX2_KERNELS(int32_t)
+INSTANTIATE_AVX2_KERNELS(int64_t)
+INSTANTIATE_AVX2_KERNELS(float)
+INSTANTIATE_AVX2_KERNELS(double)
+}  // namespace milvus::query::simd
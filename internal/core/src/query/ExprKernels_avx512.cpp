@@ -0,0 +1,212 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// compiled with -mavx512f -mavx512dq -mavx512bw
+#include <immintrin.h>
+#include "query/ExprKernelsImpl.h"
+
+namespace milvus::query::simd {
+namespace {
+template <CmpOp op>
+constexpr int
+int_predicate() {
+    switch (op) {
+        case CmpOp::Equal:
+            return _MM_CMPINT_EQ;
+        case CmpOp::NotEqual:
+            return _MM_CMPINT_NE;
+        case CmpOp::GreaterThan:
+            return _MM_CMPINT_NLE;
+        case CmpOp::GreaterEqual:
+            return _MM_CMPINT_NLT;
+        case CmpOp::LessThan:
+            return _MM_CMPINT_LT;
+        default:
+            return _MM_CMPINT_LE;
+    }
+}
+
+template <CmpOp op>
+constexpr int
+float_predicate() {
+    switch (op) {
+        case CmpOp::Equal:
+            return _CMP_EQ_OQ;
+        case CmpOp::NotEqual:
+            return _CMP_NEQ_UQ;
+        case CmpOp::GreaterThan:
+            return _CMP_GT_OQ;
+        case CmpOp::GreaterEqual:
+            return _CMP_GE_OQ;
+        case CmpOp::LessThan:
+            return _CMP_LT_OQ;
+        default:
+            return _CMP_LE_OQ;
+    }
+}
+
+// compares write the lane mask directly, no movemask needed
+template <typename T>
+struct Avx512Simd;
+
+template <>
+struct Avx512Simd<int8_t> {
+    using Reg = __m512i;
+    static constexpr int lanes = 64;
+    static Reg
+    load(const int8_t* ptr) {
+        return _mm512_loadu_si512(ptr);
+    }
+    static Reg
+    set1(int8_t val) {
+        return _mm512_set1_epi8(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return _mm512_cmp_epi8_mask(x, val, int_predicate<op>());
+    }
+};
+
+template <>
+struct Avx512Simd<int16_t> {
+    using Reg = __m512i;
+    static constexpr int lanes = 32;
+    static Reg
+    load(const int16_t* ptr) {
+        return _mm512_loadu_si512(ptr);
+    }
+    static Reg
+    set1(int16_t val) {
+        return _mm512_set1_epi16(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return _mm512_cmp_epi16_mask(x, val, int_predicate<op>());
+    }
+};
+
+template <>
+struct Avx512Simd<int32_t> {
+    using Reg = __m512i;
+    static constexpr int lanes = 16;
+    static Reg
+    load(const int32_t* ptr) {
+        return _mm512_loadu_si512(ptr);
+    }
+    static Reg
+    set1(int32_t val) {
+        return _mm512_set1_epi32(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return _mm512_cmp_epi32_mask(x, val, int_predicate<op>());
+    }
+};
+
+template <>
+struct Avx512Simd<int64_t> {
+    using Reg = __m512i;
+    static constexpr int lanes = 8;
+    static Reg
+    load(const int64_t* ptr) {
+        return _mm512_loadu_si512(ptr);
+    }
+    static Reg
+    set1(int64_t val) {
+        return _mm512_set1_epi64(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return _mm512_cmp_epi64_mask(x, val, int_predicate<op>());
+    }
+};
+
+template <>
+struct Avx512Simd<float> {
+    using Reg = __m512;
+    static constexpr int lanes = 16;
+    static Reg
+    load(const float* ptr) {
+        return _mm512_loadu_ps(ptr);
+    }
+    static Reg
+    set1(float val) {
+        return _mm512_set1_ps(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return _mm512_cmp_ps_mask(x, val, float_predicate<op>());
+    }
+};
+
+template <>
+struct Avx512Simd<double> {
+    using Reg = __m512d;
+    static constexpr int lanes = 8;
+    static Reg
+    load(const double* ptr) {
+        return _mm512_loadu_pd(ptr);
+    }
+    static Reg
+    set1(double val) {
+        return _mm512_set1_pd(val);
+    }
+    template <CmpOp op>
+    static uint64_t
+    compare(Reg x, Reg val) {
+        return _mm512_cmp_pd_mask(x, val, float_predicate<op>());
+    }
+};
+}  // namespace
+
+template <typename T>
+void
+compare_range_avx512(const T* data, int64_t size, CmpOp op, T val, uint64_t* words, const uint64_t* live) {
+    compare_range<Avx512Simd<T>>(data, size, op, val, words, live);
+}
+
+template <typename T>
+void
+compare_between_avx512(const T* data,
+                       int64_t size,
+                       bool lower_inclusive,
+                       T lower,
+                       bool upper_inclusive,
+                       T upper,
+                       uint64_t* words,
+                       const uint64_t* live) {
+    compare_between<Avx512Simd<T>>(data, size, lower_inclusive, lower, upper_inclusive, upper, words, live);
+}
+
+template <typename T>
+void
+compare_terms_avx512(
+    const T* data, int64_t size, const T* terms, int64_t num_terms, uint64_t* words, const uint64_t* live) {
+    compare_terms<Avx512Simd<T>>(data, size, terms, num_terms, words, live);
+}
+
+#define INSTANTIATE_AVX512_KERNELS(T)                                                                         \
+    template void compare_range_avx512<T>(const T*, int64_t, CmpOp, T, uint64_t*, const uint64_t*);           \
+    template void compare_between_avx512<T>(const T*, int64_t, bool, T, bool, T, uint64_t*, const uint64_t*); \
+    template void compare_terms_avx512<T>(const T*, int64_t, const T*, int64_t, uint64_t*, const uint64_t*);
+
+INSTANTIATE_AVX512_KERNELS(int8_t)
+INSTANTIATE_AVX512_KERNELS(int16_t)
+INSTANTIATE_AVX512_KERNELS(int32_t)
+INSTANTIATE_AVX512_KERNELS(int64_t)
+INSTANTIATE_AVX512_KERNELS(float)
+INSTANTIATE_AVX512_KERNELS(double)
+}  // namespace milvus::query::simd
@@ -25,6 +25,7 @@
 #include <google/protobuf/text_format.h>
 #include "query/PlanProto.h"
 #include "query/generated/ShowPlanNodeVisitor.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
 namespace milvus::query {
 
@@ -218,6 +219,10 @@ Parser::ParseVecNode(const Json& out_body) {
     vec_node->query_info_.topK_ = topK;
     vec_node->query_info_.metric_type_ = GetMetricType(vec_info.at("metric_type"));
     vec_node->query_info_.search_params_ = vec_info.at("params");
+    auto& search_params = vec_node->query_info_.search_params_;
+    if (search_params.contains(knowhere::IndexParams::range_search_radius)) {
+        vec_node->query_info_.radius_ = search_params[knowhere::IndexParams::range_search_radius].get<float>();
+    }
     vec_node->query_info_.field_offset_ = field_offset;
     vec_node->placeholder_tag_ = vec_info.at("query");
     auto tag = vec_node->placeholder_tag_;
@@ -320,6 +325,7 @@ CreatePlan(const Schema& schema, const std::string& dsl_str) {
     Json dsl;
     dsl = json::parse(dsl_str);
     auto plan = Parser(schema).CreatePlanImpl(dsl);
+    plan->source_ = "dsl:" + dsl_str;
     return plan;
 }
 
@@ -328,7 +334,9 @@ CreatePlanByExpr(const Schema& schema, const char* serialized_expr_plan, int64_t
     // Note: serialized_expr_plan is of binary format
     proto::plan::PlanNode plan_node;
     plan_node.ParseFromArray(serialized_expr_plan, size);
-    return ProtoParser(schema).CreatePlan(plan_node);
+    auto plan = ProtoParser(schema).CreatePlan(plan_node);
+    plan->source_ = "expr:" + std::string(serialized_expr_plan, size);
+    return plan;
 }
 
 std::vector<ExprPtr>
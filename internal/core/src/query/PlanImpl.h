@@ -52,6 +52,8 @@ struct Plan {
     std::unique_ptr<VectorPlanNode> plan_node_;
     std::map<std::string, FieldOffset> tag2field_;  // PlaceholderName -> FieldOffset
     std::vector<FieldOffset> target_entries_;
+    // the dsl or serialized proto the plan was parsed from, empty for plans built by hand
+    std::string source_;
     void
     check_identical(Plan& other);
 
@@ -36,6 +36,8 @@ struct QueryInfo {
     MetricType metric_type_;
     std::string deprecated_metric_type_;  // TODO: use enum
     nlohmann::json search_params_;
+    // from search_params_["range_search_radius"], turns the search into a range search capped at topK_ hits
+    std::optional<float> radius_;
 };
 
 struct VectorPlanNode : PlanNode {
@@ -13,6 +13,7 @@
 #include "knowhere/index/structured_index_simple/StructuredIndexSort.h"
 #include "common/Span.h"
 #include "common/FieldMeta.h"
+#include "common/ZoneMap.h"
 #include <memory>
 
 namespace milvus::query {
@@ -48,4 +49,35 @@ generate_scalar_index(SpanBase data, DataType data_type) {
     }
 }
 
+template <typename T>
+inline ZoneMap<T>
+generate_zone_map(Span<T> data) {
+    ZoneMap<T> zone_map;
+    zone_map.update(data.data(), data.row_count());
+    return zone_map;
+}
+
+inline ZoneMapVariant
+generate_zone_map(SpanBase data, DataType data_type) {
+    Assert(!datatype_is_vector(data_type));
+    switch (data_type) {
+        case DataType::BOOL:
+            return generate_zone_map(Span<bool>(data));
+        case DataType::INT8:
+            return generate_zone_map(Span<int8_t>(data));
+        case DataType::INT16:
+            return generate_zone_map(Span<int16_t>(data));
+        case DataType::INT32:
+            return generate_zone_map(Span<int32_t>(data));
+        case DataType::INT64:
+            return generate_zone_map(Span<int64_t>(data));
+        case DataType::FLOAT:
+            return generate_zone_map(Span<float>(data));
+        case DataType::DOUBLE:
+            return generate_zone_map(Span<double>(data));
+        default:
+            PanicInfo("unsupported type");
+    }
+}
+
 }  // namespace milvus::query
@@ -15,9 +15,12 @@
 #include <boost/dynamic_bitset.hpp>
 #include <queue>
 #include "SubQueryResult.h"
+#include "query/BruteForceKernels.h"
 
 #include <faiss/utils/distances.h>
 #include <faiss/utils/BinaryDistance.h>
+#include <faiss/impl/AuxIndexStructures.h>
+#include "knowhere/index/vector_index/helpers/DynamicResultSet.h"
 
 namespace milvus::query {
 
@@ -83,6 +86,33 @@ BinarySearchBruteForceFast(MetricType metric_type,
     return sub_result;
 }
 
+// every row within query_dataset.radius, taken like knowhere takes it: a plain distance for L2
+static SubQueryResult
+FloatRangeSearch(const dataset::QueryDataset& query_dataset,
+                 const float* chunk_data,
+                 int64_t size_per_chunk,
+                 const faiss::BitsetView& bitset) {
+    constexpr size_t buffer_size = 16384;
+    auto metric_type = query_dataset.metric_type;
+    auto num_queries = query_dataset.num_queries;
+    auto dim = query_dataset.dim;
+    auto radius = query_dataset.radius.value();
+    auto query_data = reinterpret_cast<const float*>(query_dataset.query_data);
+
+    std::vector<faiss::RangeSearchPartialResult*> partial_results;
+    if (metric_type == MetricType::METRIC_L2) {
+        faiss::range_search_L2sqr(query_data, chunk_data, dim, num_queries, size_per_chunk, radius * radius,
+                                  partial_results, buffer_size, bitset);
+    } else {
+        faiss::range_search_inner_product(query_data, chunk_data, dim, num_queries, size_per_chunk, radius,
+                                          partial_results, buffer_size, bitset);
+    }
+    faiss::RangeSearchResult result(num_queries);
+    knowhere::MergeRangeSearchResults(partial_results, result);
+    return SubQueryResult::from_range_hits(num_queries, query_dataset.topk, metric_type, result.lims, result.labels,
+                                           result.distances);
+}
+
 SubQueryResult
 FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
                       const void* chunk_data_raw,
@@ -92,9 +122,24 @@ FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
     auto num_queries = query_dataset.num_queries;
     auto topk = query_dataset.topk;
     auto dim = query_dataset.dim;
-    SubQueryResult sub_qr(num_queries, topk, metric_type);
     auto query_data = reinterpret_cast<const float*>(query_dataset.query_data);
     auto chunk_data = reinterpret_cast<const float*>(chunk_data_raw);
+    if (query_dataset.radius.has_value()) {
+        return FloatRangeSearch(query_dataset, chunk_data, size_per_chunk, bitset);
+    }
+    SubQueryResult sub_qr(num_queries, topk, metric_type);
+
+    // small batches take the tiled kernels, large ones amortize faiss' blas path
+    if (num_queries < faiss::distance_compute_blas_threshold) {
+        if (metric_type == MetricType::METRIC_L2) {
+            KnnL2Blocked(query_data, num_queries, chunk_data, size_per_chunk, dim, topk, bitset, sub_qr.get_values(),
+                         sub_qr.get_labels());
+        } else {
+            KnnIPBlocked(query_data, num_queries, chunk_data, size_per_chunk, dim, topk, bitset, sub_qr.get_values(),
+                         sub_qr.get_labels());
+        }
+        return sub_qr;
+    }
 
     if (metric_type == MetricType::METRIC_L2) {
         faiss::float_maxheap_array_t buf{(size_t)num_queries, (size_t)topk, sub_qr.get_labels(), sub_qr.get_values()};
@@ -107,12 +152,55 @@ FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
     }
 }
 
+SubQueryResult
+CompactSearchBruteForce(const dataset::QueryDataset& query_dataset,
+                        const uint8_t* chunk_codes,
+                        VectorPrecision precision,
+                        int64_t size_per_chunk,
+                        const faiss::BitsetView& bitset) {
+    auto metric_type = query_dataset.metric_type;
+    auto num_queries = query_dataset.num_queries;
+    auto topk = query_dataset.topk;
+    auto dim = query_dataset.dim;
+    auto query_data = reinterpret_cast<const float*>(query_dataset.query_data);
+
+    if (query_dataset.radius.has_value()) {
+        // no range kernels over codes, decode a block of rows at a time instead
+        constexpr int64_t block_size = 4096;
+        auto code_size = vector_code_sizeof(precision, dim);
+        std::vector<float> block(block_size * dim);
+        auto range_qr = SubQueryResult::empty_range(num_queries, topk, metric_type);
+        for (int64_t begin = 0; begin < size_per_chunk; begin += block_size) {
+            auto count = std::min(block_size, size_per_chunk - begin);
+            DecodeVectors(precision, chunk_codes + begin * code_size, count, dim, block.data());
+            auto block_qr = FloatRangeSearch(query_dataset, block.data(), count, BitsetSubView(bitset, begin, count));
+            for (auto& label : block_qr.mutable_labels()) {
+                label += begin;
+            }
+            range_qr.merge(block_qr);
+        }
+        return range_qr;
+    }
+
+    SubQueryResult sub_qr(num_queries, topk, metric_type);
+    // there is no blas path over codes, the tiled kernels take batches of any size
+    if (metric_type == MetricType::METRIC_L2) {
+        KnnL2Compact(query_data, num_queries, chunk_codes, precision, size_per_chunk, dim, topk, bitset,
+                     sub_qr.get_values(), sub_qr.get_labels());
+    } else {
+        KnnIPCompact(query_data, num_queries, chunk_codes, precision, size_per_chunk, dim, topk, bitset,
+                     sub_qr.get_values(), sub_qr.get_labels());
+    }
+    return sub_qr;
+}
+
 SubQueryResult
 BinarySearchBruteForce(const dataset::QueryDataset& query_dataset,
                        const void* chunk_data_raw,
                        int64_t size_per_chunk,
                        const faiss::BitsetView& bitset) {
     // TODO: refactor the internal function
+    AssertInfo(!query_dataset.radius.has_value(), "range search supports float vectors only");
     auto query_data = reinterpret_cast<const uint8_t*>(query_dataset.query_data);
     auto chunk_data = reinterpret_cast<const uint8_t*>(chunk_data_raw);
     return BinarySearchBruteForceFast(query_dataset.metric_type, query_dataset.dim, chunk_data, size_per_chunk,
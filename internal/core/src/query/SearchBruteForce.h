@@ -30,4 +30,12 @@ FloatSearchBruteForce(const dataset::QueryDataset& query_dataset,
                       int64_t size_per_chunk,
                       const faiss::BitsetView& bitset);
 
+// float vectors stored at reduced precision, distances are taken against the decoded rows
+SubQueryResult
+CompactSearchBruteForce(const dataset::QueryDataset& query_dataset,
+                        const uint8_t* chunk_codes,
+                        VectorPrecision precision,
+                        int64_t size_per_chunk,
+                        const faiss::BitsetView& bitset);
+
 }  // namespace milvus::query
@@ -15,11 +15,64 @@
 #include "segcore/Reduce.h"
 
 #include <faiss/utils/distances.h>
+#include <omp.h>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <vector>
 #include "utils/tools.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnIndex.h"
 
 namespace milvus::query {
+// run search_chunk(chunk_id) for every chunk on up to parallelism threads (0 means all of them),
+// then merge the per-chunk results pairwise in log2(num_chunk) rounds.
+// the left side of every merge covers the lower chunks, so ties resolve exactly as a sequential merge would
+template <typename SearchChunk>
+static SubQueryResult
+SearchChunks(int64_t num_chunk, int64_t parallelism, SubQueryResult empty_result, SearchChunk&& search_chunk) {
+    if (num_chunk == 0) {
+        return empty_result;
+    }
+    auto num_threads = parallelism > 0 ? parallelism : omp_get_max_threads();
+    std::vector<std::optional<SubQueryResult>> sub_results(num_chunk);
+    // exceptions must not escape an omp region, keep the first one and rethrow it afterwards
+    std::exception_ptr error;
+    std::mutex error_mutex;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads) if (num_chunk > 1)
+    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+        try {
+            sub_results[chunk_id] = search_chunk(chunk_id);
+        } catch (...) {
+            std::lock_guard lck(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    for (int64_t stride = 1; stride < num_chunk; stride *= 2) {
+#pragma omp parallel for num_threads(num_threads) if (num_chunk > 2 * stride)
+        for (int64_t left = 0; left < num_chunk - stride; left += 2 * stride) {
+            sub_results[left]->merge(sub_results[left + stride].value());
+        }
+    }
+    return std::move(sub_results[0].value());
+}
+
+// convert chunk uid to segment uid
+static void
+ShiftLabels(SubQueryResult& sub_qr, int64_t chunk_offset) {
+    for (auto& x : sub_qr.mutable_labels()) {
+        if (x != -1) {
+            x += chunk_offset;
+        }
+    }
+}
+
 Status
 FloatSearch(const segcore::SegmentGrowingImpl& segment,
             const query::QueryInfo& info,
@@ -51,66 +104,57 @@ FloatSearch(const segcore::SegmentGrowingImpl& segment,
     auto total_count = topK * num_queries;
     auto metric_type = info.metric_type_;
 
-    // step 3: small indexing search
-    // std::vector<int64_t> final_uids(total_count, -1);
-    // std::vector<float> final_dis(total_count, std::numeric_limits<float>::max());
-    SubQueryResult final_qr(num_queries, topK, metric_type);
-    dataset::QueryDataset query_dataset{metric_type, num_queries, topK, dim, query_data};
+    dataset::QueryDataset query_dataset{metric_type, num_queries, topK, dim, query_data, info.radius_};
     auto vec_ptr = record.get_field_data<FloatVector>(vecfield_offset);
+    auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
 
-    int current_chunk_id = 0;
-
+    // step 3: small indexing search on [0, max_indexed_id)
+    int64_t max_indexed_id = 0;
+    const segcore::VectorFieldIndexing* field_indexing = nullptr;
+    knowhere::Config search_conf;
     if (indexing_record.is_in(vecfield_offset)) {
-        auto max_indexed_id = indexing_record.get_finished_ack();
-        const auto& field_indexing = indexing_record.get_vec_field_indexing(vecfield_offset);
-        auto search_conf = field_indexing.get_search_params(topK);
-        Assert(vec_ptr->get_size_per_chunk() == field_indexing.get_size_per_chunk());
-
-        for (int chunk_id = current_chunk_id; chunk_id < max_indexed_id; ++chunk_id) {
-            auto size_per_chunk = field_indexing.get_size_per_chunk();
-            auto indexing = field_indexing.get_chunk_indexing(chunk_id);
-
-            auto sub_view = BitsetSubView(bitset, chunk_id * size_per_chunk, size_per_chunk);
-            auto sub_qr = SearchOnIndex(query_dataset, *indexing, search_conf, sub_view);
-
-            // convert chunk uid to segment uid
-            for (auto& x : sub_qr.mutable_labels()) {
-                if (x != -1) {
-                    x += chunk_id * size_per_chunk;
-                }
-            }
-
-            final_qr.merge(sub_qr);
-        }
-        current_chunk_id = max_indexed_id;
+        max_indexed_id = indexing_record.get_finished_ack();
+        field_indexing = &indexing_record.get_vec_field_indexing(vecfield_offset);
+        search_conf = field_indexing->get_search_params(topK);
+        Assert(vec_size_per_chunk == field_indexing->get_size_per_chunk());
     }
 
     // step 4: brute force search where small indexing is unavailable
-    auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
-    auto max_chunk = upper_div(ins_barrier, vec_size_per_chunk);
-
-    for (int chunk_id = current_chunk_id; chunk_id < max_chunk; ++chunk_id) {
-        auto& chunk = vec_ptr->get_chunk(chunk_id);
+    auto max_chunk = std::max<int64_t>(max_indexed_id, upper_div(ins_barrier, vec_size_per_chunk));
 
+    auto search_chunk = [&](int64_t chunk_id) {
         auto element_begin = chunk_id * vec_size_per_chunk;
+        // null when the build of this chunk failed
+        auto indexing = chunk_id < max_indexed_id ? field_indexing->get_chunk_indexing(chunk_id) : nullptr;
+        if (indexing != nullptr) {
+            auto sub_view = BitsetSubView(bitset, element_begin, vec_size_per_chunk);
+            auto sub_qr = SearchOnIndex(query_dataset, *indexing, search_conf, sub_view);
+            ShiftLabels(sub_qr, element_begin);
+            return sub_qr;
+        }
         auto element_end = std::min(ins_barrier, (chunk_id + 1) * vec_size_per_chunk);
         auto size_per_chunk = element_end - element_begin;
 
         auto sub_view = BitsetSubView(bitset, element_begin, size_per_chunk);
-        auto sub_qr = FloatSearchBruteForce(query_dataset, chunk.data(), size_per_chunk, sub_view);
-
-        // convert chunk uid to segment uid
-        for (auto& x : sub_qr.mutable_labels()) {
-            if (x != -1) {
-                x += chunk_id * vec_size_per_chunk;
+        auto sub_qr = [&] {
+            if (vec_ptr->is_compact()) {
+                return CompactSearchBruteForce(query_dataset, vec_ptr->get_codes(chunk_id), vec_ptr->get_precision(),
+                                               size_per_chunk, sub_view);
             }
-        }
-        final_qr.merge(sub_qr);
-    }
-    current_chunk_id = max_chunk;
+            auto& chunk = vec_ptr->get_chunk(chunk_id);
+            return FloatSearchBruteForce(query_dataset, chunk.data(), size_per_chunk, sub_view);
+        }();
+        ShiftLabels(sub_qr, element_begin);
+        return sub_qr;
+    };
+    auto parallelism = segment.get_segcore_config().get_search_parallelism();
+    auto empty_qr = info.radius_.has_value() ? SubQueryResult::empty_range(num_queries, topK, metric_type)
+                                             : SubQueryResult(num_queries, topK, metric_type);
+    auto final_qr = SearchChunks(max_chunk, parallelism, std::move(empty_qr), search_chunk);
 
     results.result_distances_ = std::move(final_qr.mutable_values());
     results.internal_seg_offsets_ = std::move(final_qr.mutable_labels());
+    results.result_lims_ = std::move(final_qr.mutable_lims());
     results.topK_ = topK;
     results.num_queries_ = num_queries;
 
@@ -150,17 +194,14 @@ BinarySearch(const segcore::SegmentGrowingImpl& segment,
     auto total_count = topK * num_queries;
 
     // step 3: small indexing search
-    query::dataset::QueryDataset query_dataset{metric_type, num_queries, topK, dim, query_data};
+    query::dataset::QueryDataset query_dataset{metric_type, num_queries, topK, dim, query_data, info.radius_};
 
     auto vec_ptr = record.get_field_data<BinaryVector>(vecfield_offset);
 
-    auto max_indexed_id = 0;
     // step 4: brute force search where small indexing is unavailable
-
     auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
     auto max_chunk = upper_div(ins_barrier, vec_size_per_chunk);
-    SubQueryResult final_result(num_queries, topK, metric_type);
-    for (int chunk_id = max_indexed_id; chunk_id < max_chunk; ++chunk_id) {
+    auto search_chunk = [&](int64_t chunk_id) {
         auto& chunk = vec_ptr->get_chunk(chunk_id);
         auto element_begin = chunk_id * vec_size_per_chunk;
         auto element_end = std::min(ins_barrier, (chunk_id + 1) * vec_size_per_chunk);
@@ -168,15 +209,12 @@ BinarySearch(const segcore::SegmentGrowingImpl& segment,
 
         auto sub_view = BitsetSubView(bitset, element_begin, nsize);
         auto sub_result = BinarySearchBruteForce(query_dataset, chunk.data(), nsize, sub_view);
-
-        // convert chunk uid to segment uid
-        for (auto& x : sub_result.mutable_labels()) {
-            if (x != -1) {
-                x += chunk_id * vec_size_per_chunk;
-            }
-        }
-        final_result.merge(sub_result);
-    }
+        ShiftLabels(sub_result, element_begin);
+        return sub_result;
+    };
+    auto parallelism = segment.get_segcore_config().get_search_parallelism();
+    auto final_result =
+        SearchChunks(max_chunk, parallelism, SubQueryResult(num_queries, topK, metric_type), search_chunk);
 
     results.result_distances_ = std::move(final_result.mutable_values());
     results.internal_seg_offsets_ = std::move(final_result.mutable_labels());
@@ -12,14 +12,9 @@
 #pragma once
 #include <optional>
 #include "segcore/SegmentGrowingImpl.h"
-#include <deque>
-#include <boost/dynamic_bitset.hpp>
 #include "query/SubQueryResult.h"
 
 namespace milvus::query {
-using BitsetChunk = boost::dynamic_bitset<>;
-using BitsetSimple = std::deque<BitsetChunk>;
-
 void
 SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
                 int64_t ins_barrier,
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "SearchOnIndex.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 namespace milvus::query {
 SubQueryResult
 SearchOnIndex(const dataset::QueryDataset& query_dataset,
@@ -26,6 +27,19 @@ SearchOnIndex(const dataset::QueryDataset& query_dataset,
     // NOTE: VecIndex Query API forget to add const qualifier
     // NOTE: use const_cast as a workaround
     auto& indexing_nonconst = const_cast<knowhere::VecIndex&>(indexing);
+    if (query_dataset.radius.has_value()) {
+        auto range_conf = search_conf;
+        range_conf[knowhere::IndexParams::range_search_radius] = query_dataset.radius.value();
+        auto ans = indexing_nonconst.QueryByRange(dataset, range_conf, bitset);
+        auto lims = ans->Get<size_t*>(knowhere::meta::LIMS);
+        auto dis = ans->Get<float*>(knowhere::meta::DISTANCE);
+        auto uids = ans->Get<int64_t*>(knowhere::meta::IDS);
+        auto sub_qr = SubQueryResult::from_range_hits(num_queries, topK, metric_type, lims, uids, dis);
+        free(lims);
+        free(dis);
+        free(uids);
+        return sub_qr;
+    }
     auto ans = indexing_nonconst.Query(dataset, search_conf, bitset);
 
     auto dis = ans->Get<float*>(milvus::knowhere::meta::DISTANCE);
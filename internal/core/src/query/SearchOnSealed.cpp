@@ -17,45 +17,9 @@
 #include <knowhere/index/vector_index/VecIndex.h>
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
-#include <boost_ext/dynamic_bitset_ext.hpp>
 
 namespace milvus::query {
 
-// negate bitset, and merge them into one
-aligned_vector<uint8_t>
-AssembleNegBitset(const BitsetSimple& bitset_simple) {
-    int64_t N = 0;
-
-    for (auto& bitset : bitset_simple) {
-        N += bitset.size();
-    }
-
-    aligned_vector<uint8_t> result(upper_align(upper_div(N, 8), 64));
-
-    if (bitset_simple.size() == 1) {
-        auto& bitset = bitset_simple[0];
-        auto byte_count = upper_div(bitset.size(), 8);
-        auto src_ptr = boost_ext::get_data(bitset);
-        memcpy(result.data(), src_ptr, byte_count);
-    } else {
-        auto acc_byte_count = 0;
-        for (auto& bitset : bitset_simple) {
-            auto size = bitset.size();
-            Assert(size % 8 == 0);
-            auto byte_count = size / 8;
-            auto src_ptr = boost_ext::get_data(bitset);
-            memcpy(result.data() + acc_byte_count, src_ptr, byte_count);
-            acc_byte_count += byte_count;
-        }
-    }
-
-    // revert the bitset
-    for (int64_t i = 0; i < result.size(); ++i) {
-        result[i] = ~result[i];
-    }
-    return result;
-}
-
 // TODO: temporary fix
 // remove this when internal destructor bug is fix
 static void
@@ -86,14 +50,29 @@ SearchOnSealed(const Schema& schema,
     auto field_indexing = record.get_field_indexing(field_offset);
     Assert(field_indexing->metric_type_ == query_info.metric_type_);
 
-    auto final = [&] {
-        auto ds = knowhere::GenDataset(num_queries, dim, query_data);
+    auto ds = knowhere::GenDataset(num_queries, dim, query_data);
+    auto conf = query_info.search_params_;
+    conf[milvus::knowhere::meta::TOPK] = query_info.topK_;
+    conf[milvus::knowhere::Metric::TYPE] = MetricTypeToName(field_indexing->metric_type_);
+
+    if (query_info.radius_.has_value()) {
+        auto range_result = field_indexing->indexing_->QueryByRange(ds, conf, bitset);
+        auto lims = range_result->Get<size_t*>(knowhere::meta::LIMS);
+        auto ids = range_result->Get<idx_t*>(knowhere::meta::IDS);
+        auto distances = range_result->Get<float*>(knowhere::meta::DISTANCE);
+        auto sub_qr = SubQueryResult::from_range_hits(num_queries, topK, query_info.metric_type_, lims, ids, distances);
+        free(lims);
+        ReleaseQueryResult(range_result);
+
+        result.internal_seg_offsets_ = std::move(sub_qr.mutable_labels());
+        result.result_distances_ = std::move(sub_qr.mutable_values());
+        result.result_lims_ = std::move(sub_qr.mutable_lims());
+        result.num_queries_ = num_queries;
+        result.topK_ = topK;
+        return;
+    }
 
-        auto conf = query_info.search_params_;
-        conf[milvus::knowhere::meta::TOPK] = query_info.topK_;
-        conf[milvus::knowhere::Metric::TYPE] = MetricTypeToName(field_indexing->metric_type_);
-        return field_indexing->indexing_->Query(ds, conf, bitset);
-    }();
+    auto final = field_indexing->indexing_->Query(ds, conf, bitset);
 
     auto ids = final->Get<idx_t*>(knowhere::meta::IDS);
     auto distances = final->Get<float*>(knowhere::meta::DISTANCE);
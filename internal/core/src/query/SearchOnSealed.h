@@ -17,9 +17,6 @@
 
 namespace milvus::query {
 
-aligned_vector<uint8_t>
-AssembleNegBitset(const BitsetSimple& bitmap_simple);
-
 void
 SearchOnSealed(const Schema& schema,
                const segcore::SealedIndexingRecord& record,
@@ -0,0 +1,32 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <faiss/FaissHook.h>
+
+namespace milvus::query {
+// widest instruction set the host supports, detected once by faiss
+enum class SimdLevel { None, AVX2, AVX512 };
+
+inline SimdLevel
+GetSimdLevel() {
+    static const SimdLevel level = [] {
+        if (faiss::support_avx512()) {
+            return SimdLevel::AVX512;
+        } else if (faiss::support_avx2()) {
+            return SimdLevel::AVX2;
+        } else {
+            return SimdLevel::None;
+        }
+    }();
+    return level;
+}
+}  // namespace milvus::query
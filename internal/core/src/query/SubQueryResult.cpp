@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <numeric>
 #include "exceptions/EasyAssert.h"
 #include "query/SubQueryResult.h"
 #include "segcore/Reduce.h"
@@ -57,9 +59,58 @@ SubQueryResult::merge_impl(const SubQueryResult& right) {
     }
 }
 
+template <bool is_desc>
+void
+SubQueryResult::merge_range_impl(const SubQueryResult& right) {
+    Assert(num_queries_ == right.num_queries_);
+    Assert(topk_ == right.topk_);
+    Assert(is_desc == is_descending(metric_type_));
+
+    std::vector<int64_t> lims(num_queries_ + 1, 0);
+    std::vector<int64_t> labels;
+    std::vector<float> values;
+    labels.reserve(labels_.size() + right.labels_.size());
+    values.reserve(values_.size() + right.values_.size());
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        auto lit = lims_[qn];
+        auto left_end = lims_[qn + 1];
+        auto rit = right.lims_[qn];
+        auto right_end = right.lims_[qn + 1];
+        auto count = std::min(left_end - lit + right_end - rit, topk_);
+        for (int64_t i = 0; i < count; ++i) {
+            // on ties the left side wins, like merge_impl
+            auto take_left = rit == right_end ||
+                             (lit < left_end && (is_desc ? values_[lit] >= right.values_[rit]
+                                                         : values_[lit] <= right.values_[rit]));
+            if (take_left) {
+                labels.push_back(labels_[lit]);
+                values.push_back(values_[lit]);
+                ++lit;
+            } else {
+                labels.push_back(right.labels_[rit]);
+                values.push_back(right.values_[rit]);
+                ++rit;
+            }
+        }
+        lims[qn + 1] = labels.size();
+    }
+    labels_ = std::move(labels);
+    values_ = std::move(values);
+    lims_ = std::move(lims);
+}
+
 void
 SubQueryResult::merge(const SubQueryResult& sub_result) {
     Assert(metric_type_ == sub_result.metric_type_);
+    Assert(is_range() == sub_result.is_range());
+    if (is_range()) {
+        if (is_descending(metric_type_)) {
+            this->merge_range_impl<true>(sub_result);
+        } else {
+            this->merge_range_impl<false>(sub_result);
+        }
+        return;
+    }
     if (is_descending(metric_type_)) {
         this->merge_impl<true>(sub_result);
     } else {
@@ -67,6 +118,39 @@ SubQueryResult::merge(const SubQueryResult& sub_result) {
     }
 }
 
+SubQueryResult
+SubQueryResult::from_range_hits(int64_t num_queries,
+                                int64_t topk,
+                                MetricType metric_type,
+                                const size_t* lims,
+                                const int64_t* labels,
+                                const float* values) {
+    auto result = empty_range(num_queries, topk, metric_type);
+    auto is_desc = is_descending(metric_type);
+    std::vector<int64_t> order;
+    for (int64_t qn = 0; qn < num_queries; ++qn) {
+        auto begin = lims[qn];
+        auto end = lims[qn + 1];
+        order.resize(end - begin);
+        std::iota(order.begin(), order.end(), begin);
+        // labels break distance ties, so the order does not depend on how the hits were gathered
+        auto better = [&](int64_t lhs, int64_t rhs) {
+            if (values[lhs] != values[rhs]) {
+                return is_desc ? values[lhs] > values[rhs] : values[lhs] < values[rhs];
+            }
+            return labels[lhs] < labels[rhs];
+        };
+        auto count = std::min<int64_t>(order.size(), topk);
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), better);
+        for (int64_t i = 0; i < count; ++i) {
+            result.labels_.push_back(labels[order[i]]);
+            result.values_.push_back(values[order[i]]);
+        }
+        result.lims_[qn + 1] = result.labels_.size();
+    }
+    return result;
+}
+
 SubQueryResult
 SubQueryResult::merge(const SubQueryResult& left, const SubQueryResult& right) {
     auto left_copy = left;
@@ -25,6 +25,25 @@ class SubQueryResult {
           values_(num_queries * topk, init_value(metric_type)) {
     }
 
+    // range search result without any hit
+    static SubQueryResult
+    empty_range(int64_t num_queries, int64_t topk, MetricType metric_type) {
+        SubQueryResult result(0, topk, metric_type);
+        result.num_queries_ = num_queries;
+        result.lims_.resize(num_queries + 1, 0);
+        return result;
+    }
+
+    // range search result: the hits of query i sit at [lims[i], lims[i + 1]), best first, at most topk of them.
+    // lims, labels and values describe unsorted hits and may hold more than topk per query
+    static SubQueryResult
+    from_range_hits(int64_t num_queries,
+                    int64_t topk,
+                    MetricType metric_type,
+                    const size_t* lims,
+                    const int64_t* labels,
+                    const float* values);
+
  public:
     static constexpr float
     init_value(MetricType metric_type) {
@@ -51,6 +70,16 @@ class SubQueryResult {
         return topk_;
     }
 
+    // knn results hold exactly topk hits per query, range results a variable count, see get_lims
+    bool
+    is_range() const {
+        return !lims_.empty();
+    }
+    const std::vector<int64_t>&
+    get_lims() const {
+        return lims_;
+    }
+
     const int64_t*
     get_labels() const {
         return labels_.data();
@@ -75,6 +104,10 @@ class SubQueryResult {
     mutable_values() {
         return values_;
     }
+    auto&
+    mutable_lims() {
+        return lims_;
+    }
 
     static SubQueryResult
     merge(const SubQueryResult& left, const SubQueryResult& right);
@@ -87,12 +120,18 @@ class SubQueryResult {
     void
     merge_impl(const SubQueryResult& sub_result);
 
+    template <bool is_desc>
+    void
+    merge_range_impl(const SubQueryResult& sub_result);
+
  private:
     int64_t num_queries_;
     int64_t topk_;
     MetricType metric_type_;
     std::vector<int64_t> labels_;
     std::vector<float> values_;
+    // empty for knn results, num_queries + 1 offsets into labels_ / values_ for range results
+    std::vector<int64_t> lims_;
 };
 
 }  // namespace milvus::query
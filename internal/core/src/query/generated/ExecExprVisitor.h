@@ -13,9 +13,11 @@
 // Generated File
 // DO NOT EDIT
 #include <optional>
-#include <boost/dynamic_bitset.hpp>
+#include <map>
 #include <utility>
-#include <deque>
+#include <vector>
+#include <boost_ext/dynamic_bitset_ext.hpp>
+#include "common/Bitmap.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/ExprImpl.h"
 #include "ExprVisitor.h"
@@ -36,13 +38,20 @@ class ExecExprVisitor : public ExprVisitor {
     visit(RangeExpr& expr) override;
 
  public:
-    using RetType = std::deque<boost::dynamic_bitset<>>;
+    // covers num_chunk * size_per_chunk rows, rows past row_count_ are unspecified
+    using RetType = Bitmap;
     ExecExprVisitor(const segcore::SegmentInternalInterface& segment, int64_t row_count, Timestamp timestamp)
         : segment_(segment), row_count_(row_count), timestamp_(timestamp) {
     }
     RetType
     call_child(Expr& expr) {
         Assert(!ret_.has_value());
+        auto cached = leaf_result_cache_.find(&expr);
+        if (cached != leaf_result_cache_.end()) {
+            auto ret = std::move(cached->second);
+            leaf_result_cache_.erase(cached);
+            return ret;
+        }
         expr.accept(*this);
         Assert(ret_.has_value());
         auto ret = std::move(ret_);
@@ -51,9 +60,10 @@ class ExecExprVisitor : public ExprVisitor {
     }
 
  public:
-    template <typename T, typename IndexFunc, typename ElementFunc>
+    template <typename T, typename IndexFunc, typename KernelFunc, typename ZoneFunc>
     auto
-    ExecRangeVisitorImpl(RangeExprImpl<T>& expr, IndexFunc func, ElementFunc element_func) -> RetType;
+    ExecRangeVisitorImpl(RangeExprImpl<T>& expr, IndexFunc func, KernelFunc kernel_func, ZoneFunc zone_func)
+        -> RetType;
 
     template <typename T>
     auto
@@ -63,10 +73,27 @@ class ExecExprVisitor : public ExprVisitor {
     auto
     ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType;
 
+    // fraction of rows expected to pass expr, leaves are evaluated on a sparse sample of words
+    double
+    EstimateSelectivity(Expr& expr);
+
+    // number of TermExpr / RangeExpr nodes evaluated so far
+    int64_t
+    leaf_evaluations() const {
+        return leaf_evaluations_;
+    }
+
  private:
     const segcore::SegmentInternalInterface& segment_;
     int64_t row_count_;
     std::optional<RetType> ret_;
     Timestamp timestamp_;
+    // rows the caller still needs, results are only meaningful on the words where it is set, null means all
+    const Bitmap* live_ = nullptr;
+    // keyed by node, so a visitor serves one plan at a time
+    std::map<const Expr*, double> selectivity_cache_;
+    // leaves fully evaluated while estimating, handed out once by call_child
+    std::map<const Expr*, RetType> leaf_result_cache_;
+    int64_t leaf_evaluations_ = 0;
 };
 }  // namespace milvus::query
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #pragma once
+#include <optional>
 #include "common/Types.h"
 
 namespace milvus::query {
@@ -21,6 +22,8 @@ struct QueryDataset {
     int64_t topk;
     int64_t dim;
     const void* query_data;
+    // set for a range search: every row within radius instead of the topk nearest, topk still caps the hits
+    std::optional<float> radius = std::nullopt;
 };
 
 }  // namespace dataset
@@ -9,12 +9,16 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <optional>
-#include <boost/dynamic_bitset.hpp>
+#include <map>
 #include <utility>
-#include <deque>
+#include <vector>
+#include <boost_ext/dynamic_bitset_ext.hpp>
+#include "common/Bitmap.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/ExprImpl.h"
+#include "query/ExprKernels.h"
 #include "query/generated/ExecExprVisitor.h"
 
 namespace milvus::query {
@@ -24,13 +28,20 @@ namespace milvus::query {
 namespace impl {
 class ExecExprVisitor : ExprVisitor {
  public:
-    using RetType = std::deque<boost::dynamic_bitset<>>;
-    ExecExprVisitor(const segcore::SegmentInternalInterface& segment, int64_t row_count)
-        : segment_(segment), row_count_(row_count) {
+    // covers num_chunk * size_per_chunk rows, rows past row_count_ are unspecified
+    using RetType = Bitmap;
+    ExecExprVisitor(const segcore::SegmentInternalInterface& segment, int64_t row_count, Timestamp timestamp)
+        : segment_(segment), row_count_(row_count), timestamp_(timestamp) {
     }
     RetType
     call_child(Expr& expr) {
         Assert(!ret_.has_value());
+        auto cached = leaf_result_cache_.find(&expr);
+        if (cached != leaf_result_cache_.end()) {
+            auto ret = std::move(cached->second);
+            leaf_result_cache_.erase(cached);
+            return ret;
+        }
         expr.accept(*this);
         Assert(ret_.has_value());
         auto ret = std::move(ret_);
@@ -39,9 +50,10 @@ class ExecExprVisitor : ExprVisitor {
     }
 
  public:
-    template <typename T, typename IndexFunc, typename ElementFunc>
+    template <typename T, typename IndexFunc, typename KernelFunc, typename ZoneFunc>
     auto
-    ExecRangeVisitorImpl(RangeExprImpl<T>& expr, IndexFunc func, ElementFunc element_func) -> RetType;
+    ExecRangeVisitorImpl(RangeExprImpl<T>& expr, IndexFunc func, KernelFunc kernel_func, ZoneFunc zone_func)
+        -> RetType;
 
     template <typename T>
     auto
@@ -51,10 +63,28 @@ class ExecExprVisitor : ExprVisitor {
     auto
     ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType;
 
+    // fraction of rows expected to pass expr, leaves are evaluated on a sparse sample of words
+    double
+    EstimateSelectivity(Expr& expr);
+
+    // number of TermExpr / RangeExpr nodes evaluated so far
+    int64_t
+    leaf_evaluations() const {
+        return leaf_evaluations_;
+    }
+
  private:
     const segcore::SegmentInternalInterface& segment_;
     int64_t row_count_;
     std::optional<RetType> ret_;
+    Timestamp timestamp_;
+    // rows the caller still needs, results are only meaningful on the words where it is set, null means all
+    const Bitmap* live_ = nullptr;
+    // keyed by node, so a visitor serves one plan at a time
+    std::map<const Expr*, double> selectivity_cache_;
+    // leaves fully evaluated while estimating, handed out once by call_child
+    std::map<const Expr*, RetType> leaf_result_cache_;
+    int64_t leaf_evaluations_ = 0;
 };
 }  // namespace impl
 #endif
@@ -62,20 +92,15 @@ class ExecExprVisitor : ExprVisitor {
 void
 ExecExprVisitor::visit(LogicalUnaryExpr& expr) {
     using OpType = LogicalUnaryExpr::OpType;
-    auto vec = call_child(*expr.child_);
-    RetType ret;
-    for (int chunk_id = 0; chunk_id < vec.size(); ++chunk_id) {
-        auto chunk = vec[chunk_id];
-        switch (expr.op_type_) {
-            case OpType::LogicalNot: {
-                chunk.flip();
-                break;
-            }
-            default: {
-                PanicInfo("Invalid OpType");
-            }
+    auto ret = call_child(*expr.child_);
+    switch (expr.op_type_) {
+        case OpType::LogicalNot: {
+            ret.flip();
+            break;
+        }
+        default: {
+            PanicInfo("Invalid OpType");
         }
-        ret.emplace_back(std::move(chunk));
     }
     ret_ = std::move(ret);
 }
@@ -83,71 +108,288 @@ ExecExprVisitor::visit(LogicalUnaryExpr& expr) {
 void
 ExecExprVisitor::visit(LogicalBinaryExpr& expr) {
     using OpType = LogicalBinaryExpr::OpType;
-    RetType ret;
-    auto left = call_child(*expr.left_);
-    auto right = call_child(*expr.right_);
-    Assert(left.size() == right.size());
-
-    for (int chunk_id = 0; chunk_id < left.size(); ++chunk_id) {
-        boost::dynamic_bitset<> chunk_res;
-        auto left_chunk = std::move(left[chunk_id]);
-        auto right_chunk = std::move(right[chunk_id]);
-        chunk_res = std::move(left_chunk);
-        switch (expr.op_type_) {
-            case OpType::LogicalAnd: {
-                chunk_res &= right_chunk;
-                break;
+    auto first = expr.left_.get();
+    auto second = expr.right_.get();
+    auto op = expr.op_type_;
+    if (op == OpType::LogicalAnd || op == OpType::LogicalOr) {
+        // AND runs the sparser side first and OR the denser one, leaving the least for the other side to examine
+        auto first_selectivity = EstimateSelectivity(*first);
+        auto second_selectivity = EstimateSelectivity(*second);
+        if (op == OpType::LogicalAnd ? second_selectivity < first_selectivity
+                                     : second_selectivity > first_selectivity) {
+            std::swap(first, second);
+        }
+    }
+
+    auto ret = call_child(*first);
+    auto saved_live = live_;
+    std::optional<Bitmap> pending;
+    switch (op) {
+        case OpType::LogicalAnd:
+        case OpType::LogicalMinus: {
+            if (!ret.any(0, row_count_)) {
+                ret_ = std::move(ret);
+                return;
             }
-            case OpType::LogicalOr: {
-                chunk_res |= right_chunk;
-                break;
+            // only rows still set in ret can change the result
+            live_ = &ret;
+            break;
+        }
+        case OpType::LogicalOr: {
+            if (ret.all(0, row_count_)) {
+                ret_ = std::move(ret);
+                return;
             }
-            case OpType::LogicalXor: {
-                chunk_res ^= right_chunk;
-                break;
+            pending = ret;
+            pending->flip();
+            if (live_ != nullptr) {
+                *pending &= *live_;
             }
-            case OpType::LogicalMinus: {
-                chunk_res -= right_chunk;
+            live_ = &pending.value();
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+    auto right = call_child(*second);
+    live_ = saved_live;
+    Assert(ret.size() == right.size());
+
+    switch (op) {
+        case OpType::LogicalAnd: {
+            ret &= right;
+            break;
+        }
+        case OpType::LogicalOr: {
+            ret |= right;
+            break;
+        }
+        case OpType::LogicalXor: {
+            ret ^= right;
+            break;
+        }
+        case OpType::LogicalMinus: {
+            ret -= right;
+            break;
+        }
+        default: {
+            PanicInfo("Invalid OpType");
+        }
+    }
+    ret_ = std::move(ret);
+}
+
+// words spread over the sampled rows when estimating selectivity
+constexpr int64_t SampleWords = 32;
+
+double
+ExecExprVisitor::EstimateSelectivity(Expr& expr) {
+    using OpType = LogicalBinaryExpr::OpType;
+    auto iter = selectivity_cache_.find(&expr);
+    if (iter != selectivity_cache_.end()) {
+        return iter->second;
+    }
+    if (row_count_ == 0) {
+        return 1;
+    }
+
+    double selectivity;
+    if (auto unary = dynamic_cast<LogicalUnaryExpr*>(&expr)) {
+        selectivity = 1 - EstimateSelectivity(*unary->child_);
+    } else if (auto binary = dynamic_cast<LogicalBinaryExpr*>(&expr)) {
+        // assume independent children
+        auto left = EstimateSelectivity(*binary->left_);
+        auto right = EstimateSelectivity(*binary->right_);
+        switch (binary->op_type_) {
+            case OpType::LogicalAnd:
+                selectivity = left * right;
                 break;
+            case OpType::LogicalOr:
+                selectivity = left + right - left * right;
+                break;
+            case OpType::LogicalXor:
+                selectivity = left + right - 2 * left * right;
+                break;
+            case OpType::LogicalMinus:
+                selectivity = left * (1 - right);
+                break;
+            default:
+                PanicInfo("Invalid OpType");
+        }
+    } else {
+        FieldOffset field_offset = [&] {
+            if (auto term = dynamic_cast<TermExpr*>(&expr)) {
+                return term->field_offset_;
+            } else if (auto range = dynamic_cast<RangeExpr*>(&expr)) {
+                return range->field_offset_;
+            } else {
+                PanicInfo("unsupported expr");
             }
+        }();
+        auto size_per_chunk = segment_.size_per_chunk();
+        auto num_chunk = upper_div(row_count_, size_per_chunk);
+        // prefer raw rows, the scalar index is only queried when every chunk has one
+        auto indexed_rows = std::min(segment_.num_chunk_index(field_offset), num_chunk) * size_per_chunk;
+        if (num_chunk == 1 && indexed_rows >= row_count_) {
+            // a single indexed chunk is the whole segment (sealed), evaluate it once and keep the result
+            auto saved_live = live_;
+            live_ = nullptr;
+            auto ret = call_child(expr);
+            live_ = saved_live;
+            Bitmap rows(ret.size());
+            rows.fill(0, row_count_, true);
+            rows &= ret;
+            selectivity = double(rows.count()) / row_count_;
+            leaf_result_cache_.emplace(&expr, std::move(ret));
+            selectivity_cache_.emplace(&expr, selectivity);
+            return selectivity;
         }
-        ret.emplace_back(std::move(chunk_res));
+        auto sample_begin = indexed_rows < row_count_ ? indexed_rows : 0;
+        auto sample_end = indexed_rows < row_count_ ? row_count_ : std::min(size_per_chunk, row_count_);
+        auto begin_word = sample_begin / 64;
+        auto end_word = upper_div(sample_end, 64);
+        auto step = std::max<int64_t>(1, (end_word - begin_word) / SampleWords);
+
+        Bitmap sample(num_chunk * size_per_chunk);
+        int64_t sample_rows = 0;
+        for (auto w = begin_word; w < end_word; w += step) {
+            auto begin = w * 64;
+            auto end = std::min(begin + 64, row_count_);
+            sample.fill(begin, end, true);
+            sample_rows += end - begin;
+        }
+
+        auto saved_live = live_;
+        live_ = &sample;
+        auto ret = call_child(expr);
+        live_ = saved_live;
+        ret &= sample;
+        selectivity = double(ret.count()) / sample_rows;
     }
-    ret_ = std::move(ret);
+    selectivity_cache_.emplace(&expr, selectivity);
+    return selectivity;
+}
+
+// run a chunk kernel into rows [offset, offset + size) of result, in place when the rows start on a word,
+// kernel_func takes the output words and the matching live words, which may be null
+template <typename KernelFunc>
+static void
+FillChunk(Bitmap& result, const Bitmap* live, int64_t offset, int64_t size, KernelFunc&& kernel_func) {
+    if (offset % 64 == 0 && (size % 64 == 0 || offset + size == result.size())) {
+        auto live_words = live != nullptr ? live->words() + offset / 64 : nullptr;
+        kernel_func(result.words() + offset / 64, live_words);
+    } else {
+        std::vector<uint64_t> buffer(upper_div(size, 64));
+        kernel_func(buffer.data(), nullptr);
+        result.copy_from(offset, buffer.data(), size);
+    }
+}
+
+// whole-chunk outcome of a predicate, read off the chunk's zone map
+enum class ChunkMatch { Some, None, All };
+
+template <typename T>
+static ChunkMatch
+RangeMatch(const ZoneMap<T>& zone_map, RangeExpr::OpType op, T val) {
+    using OpType = RangeExpr::OpType;
+    auto min = zone_map.min;
+    auto max = zone_map.max;
+    switch (op) {
+        case OpType::Equal:
+            return val < min || max < val ? ChunkMatch::None : min == max ? ChunkMatch::All : ChunkMatch::Some;
+        case OpType::NotEqual:
+            return val < min || max < val ? ChunkMatch::All : min == max ? ChunkMatch::None : ChunkMatch::Some;
+        case OpType::GreaterEqual:
+            return val <= min ? ChunkMatch::All : max < val ? ChunkMatch::None : ChunkMatch::Some;
+        case OpType::GreaterThan:
+            return val < min ? ChunkMatch::All : max <= val ? ChunkMatch::None : ChunkMatch::Some;
+        case OpType::LessEqual:
+            return max <= val ? ChunkMatch::All : val < min ? ChunkMatch::None : ChunkMatch::Some;
+        case OpType::LessThan:
+            return max < val ? ChunkMatch::All : val <= min ? ChunkMatch::None : ChunkMatch::Some;
+        default:
+            return ChunkMatch::Some;
+    }
+}
+
+template <typename T>
+static ChunkMatch
+BetweenMatch(const ZoneMap<T>& zone_map, bool lower_inclusive, T lower, bool upper_inclusive, T upper) {
+    auto above_lower = [&](T value) { return lower_inclusive ? lower <= value : lower < value; };
+    auto below_upper = [&](T value) { return upper_inclusive ? value <= upper : value < upper; };
+    if (!above_lower(zone_map.max) || !below_upper(zone_map.min)) {
+        return ChunkMatch::None;
+    }
+    if (above_lower(zone_map.min) && below_upper(zone_map.max)) {
+        return ChunkMatch::All;
+    }
+    return ChunkMatch::Some;
+}
+
+// sorted_terms must be sorted and free of NaN
+template <typename T, typename Terms>
+static ChunkMatch
+TermMatch(const ZoneMap<T>& zone_map, const Terms& sorted_terms) {
+    auto iter = std::lower_bound(sorted_terms.begin(), sorted_terms.end(), zone_map.min);
+    if (iter == sorted_terms.end() || zone_map.max < *iter) {
+        return ChunkMatch::None;
+    }
+    return zone_map.min == zone_map.max ? ChunkMatch::All : ChunkMatch::Some;
 }
 
-template <typename T, typename IndexFunc, typename ElementFunc>
+template <typename T, typename ZoneFunc>
+static ChunkMatch
+MatchChunk(const segcore::SegmentInternalInterface& segment,
+           FieldOffset field_offset,
+           int64_t chunk_id,
+           ZoneFunc&& zone_func) {
+    auto zone_map = segment.chunk_zone_map<T>(field_offset, chunk_id);
+    if (!zone_map.has_value() || !zone_map->usable()) {
+        return ChunkMatch::Some;
+    }
+    return zone_func(zone_map.value());
+}
+
+template <typename T, typename IndexFunc, typename KernelFunc, typename ZoneFunc>
 auto
-ExecExprVisitor::ExecRangeVisitorImpl(RangeExprImpl<T>& expr, IndexFunc index_func, ElementFunc element_func)
-    -> RetType {
+ExecExprVisitor::ExecRangeVisitorImpl(RangeExprImpl<T>& expr,
+                                      IndexFunc index_func,
+                                      KernelFunc kernel_func,
+                                      ZoneFunc zone_func) -> RetType {
     auto& schema = segment_.get_schema();
     auto field_offset = expr.field_offset_;
     auto& field_meta = schema[field_offset];
-    auto indexing_barrier = segment_.num_chunk_index(field_offset);
     auto size_per_chunk = segment_.size_per_chunk();
     auto num_chunk = upper_div(row_count_, size_per_chunk);
-    RetType results;
+    auto indexing_barrier = std::min(segment_.num_chunk_index(field_offset), num_chunk);
+    RetType results(num_chunk * size_per_chunk);
 
     using Index = knowhere::scalar::StructuredIndex<T>;
-    for (auto chunk_id = 0; chunk_id < indexing_barrier; ++chunk_id) {
-        const Index& indexing = segment_.chunk_scalar_index<T>(field_offset, chunk_id);
-        // NOTE: knowhere is not const-ready
-        // This is a dirty workaround
-        auto data = index_func(const_cast<Index*>(&indexing));
-        Assert(data->size() == size_per_chunk);
-        results.emplace_back(std::move(*data));
-    }
-
-    for (auto chunk_id = indexing_barrier; chunk_id < num_chunk; ++chunk_id) {
-        boost::dynamic_bitset<> result(size_per_chunk);
-        result.resize(size_per_chunk);
-        auto chunk = segment_.chunk_data<T>(field_offset, chunk_id);
-        const T* data = chunk.data();
-        for (int index = 0; index < size_per_chunk; ++index) {
-            result[index] = element_func(data[index]);
+    for (auto chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+        auto size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
+        if (live_ != nullptr && !live_->any(chunk_id * size_per_chunk, chunk_id * size_per_chunk + size)) {
+            continue;
+        }
+        auto match = MatchChunk<T>(segment_, field_offset, chunk_id, zone_func);
+        if (match != ChunkMatch::Some) {
+            results.fill(chunk_id * size_per_chunk, chunk_id * size_per_chunk + size, match == ChunkMatch::All);
+            continue;
+        }
+        // chunks whose index failed to build are scanned like unindexed ones
+        auto indexing = chunk_id < indexing_barrier ? segment_.chunk_scalar_index<T>(field_offset, chunk_id) : nullptr;
+        if (indexing != nullptr) {
+            // NOTE: knowhere is not const-ready
+            // This is a dirty workaround
+            auto data = index_func(const_cast<Index*>(indexing));
+            Assert(data->size() == size_per_chunk);
+            auto words = reinterpret_cast<const uint64_t*>(boost_ext::get_data(*data));
+            results.copy_from(chunk_id * size_per_chunk, words, size_per_chunk);
+            continue;
         }
-        Assert(result.size() == size_per_chunk);
-        results.emplace_back(std::move(result));
+        auto chunk = segment_.chunk_data<T>(field_offset, chunk_id);
+        FillChunk(results, live_, chunk_id * size_per_chunk, size,
+                  [&](uint64_t* words, const uint64_t* live) { kernel_func(chunk.data(), size, words, live); });
     }
     return results;
 }
@@ -167,35 +409,39 @@ ExecExprVisitor::ExecRangeVisitorDispatcher(RangeExpr& expr_raw) -> RetType {
         // auto [op, val] = cond; // strange bug on capture
         auto op = std::get<0>(cond);
         auto val = std::get<1>(cond);
+        auto kernel_func = [op, val](const T* data, int64_t size, uint64_t* words, const uint64_t* live) {
+            RangeKernel(data, size, op, val, words, live);
+        };
+        auto zone_func = [op, val](const ZoneMap<T>& zone_map) { return RangeMatch(zone_map, op, val); };
         switch (op) {
             case OpType::Equal: {
                 auto index_func = [val](Index* index) { return index->In(1, &val); };
-                return ExecRangeVisitorImpl(expr, index_func, [val](T x) { return (x == val); });
+                return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
             }
 
             case OpType::NotEqual: {
                 auto index_func = [val](Index* index) { return index->NotIn(1, &val); };
-                return ExecRangeVisitorImpl(expr, index_func, [val](T x) { return (x != val); });
+                return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
             }
 
             case OpType::GreaterEqual: {
                 auto index_func = [val](Index* index) { return index->Range(val, Operator::GE); };
-                return ExecRangeVisitorImpl(expr, index_func, [val](T x) { return (x >= val); });
+                return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
             }
 
             case OpType::GreaterThan: {
                 auto index_func = [val](Index* index) { return index->Range(val, Operator::GT); };
-                return ExecRangeVisitorImpl(expr, index_func, [val](T x) { return (x > val); });
+                return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
             }
 
             case OpType::LessEqual: {
                 auto index_func = [val](Index* index) { return index->Range(val, Operator::LE); };
-                return ExecRangeVisitorImpl(expr, index_func, [val](T x) { return (x <= val); });
+                return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
             }
 
             case OpType::LessThan: {
                 auto index_func = [val](Index* index) { return index->Range(val, Operator::LT); };
-                return ExecRangeVisitorImpl(expr, index_func, [val](T x) { return (x < val); });
+                return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
             }
             default: {
                 PanicInfo("unsupported range node");
@@ -211,23 +457,46 @@ ExecExprVisitor::ExecRangeVisitorDispatcher(RangeExpr& expr_raw) -> RetType {
             // Empty
             auto size_per_chunk = segment_.size_per_chunk();
             auto num_chunk = upper_div(row_count_, size_per_chunk);
-            RetType ret(num_chunk, boost::dynamic_bitset<>(size_per_chunk));
-            return ret;
+            return RetType(num_chunk * size_per_chunk);
         }
         auto ops = std::make_tuple(op1, op2);
         if (false) {
         } else if (ops == std::make_tuple(OpType::GreaterThan, OpType::LessThan)) {
             auto index_func = [val1, val2](Index* index) { return index->Range(val1, false, val2, false); };
-            return ExecRangeVisitorImpl(expr, index_func, [val1, val2](T x) { return (val1 < x && x < val2); });
+            auto kernel_func = [val1, val2](const T* data, int64_t size, uint64_t* words, const uint64_t* live) {
+                BetweenKernel(data, size, false, val1, false, val2, words, live);
+            };
+            auto zone_func = [val1, val2](const ZoneMap<T>& zone_map) {
+                return BetweenMatch(zone_map, false, val1, false, val2);
+            };
+            return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
         } else if (ops == std::make_tuple(OpType::GreaterThan, OpType::LessEqual)) {
             auto index_func = [val1, val2](Index* index) { return index->Range(val1, false, val2, true); };
-            return ExecRangeVisitorImpl(expr, index_func, [val1, val2](T x) { return (val1 < x && x <= val2); });
+            auto kernel_func = [val1, val2](const T* data, int64_t size, uint64_t* words, const uint64_t* live) {
+                BetweenKernel(data, size, false, val1, true, val2, words, live);
+            };
+            auto zone_func = [val1, val2](const ZoneMap<T>& zone_map) {
+                return BetweenMatch(zone_map, false, val1, true, val2);
+            };
+            return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
         } else if (ops == std::make_tuple(OpType::GreaterEqual, OpType::LessThan)) {
             auto index_func = [val1, val2](Index* index) { return index->Range(val1, true, val2, false); };
-            return ExecRangeVisitorImpl(expr, index_func, [val1, val2](T x) { return (val1 <= x && x < val2); });
+            auto kernel_func = [val1, val2](const T* data, int64_t size, uint64_t* words, const uint64_t* live) {
+                BetweenKernel(data, size, true, val1, false, val2, words, live);
+            };
+            auto zone_func = [val1, val2](const ZoneMap<T>& zone_map) {
+                return BetweenMatch(zone_map, true, val1, false, val2);
+            };
+            return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
         } else if (ops == std::make_tuple(OpType::GreaterEqual, OpType::LessEqual)) {
             auto index_func = [val1, val2](Index* index) { return index->Range(val1, true, val2, true); };
-            return ExecRangeVisitorImpl(expr, index_func, [val1, val2](T x) { return (val1 <= x && x <= val2); });
+            auto kernel_func = [val1, val2](const T* data, int64_t size, uint64_t* words, const uint64_t* live) {
+                BetweenKernel(data, size, true, val1, true, val2, words, live);
+            };
+            auto zone_func = [val1, val2](const ZoneMap<T>& zone_map) {
+                return BetweenMatch(zone_map, true, val1, true, val2);
+            };
+            return ExecRangeVisitorImpl(expr, index_func, kernel_func, zone_func);
         } else {
             PanicInfo("unsupported range node");
         }
@@ -240,6 +509,7 @@ ExecExprVisitor::ExecRangeVisitorDispatcher(RangeExpr& expr_raw) -> RetType {
 void
 ExecExprVisitor::visit(RangeExpr& expr) {
     auto& field_meta = segment_.get_schema()[expr.field_offset_];
+    ++leaf_evaluations_;
     Assert(expr.data_type_ == field_meta.get_data_type());
     RetType ret;
     switch (expr.data_type_) {
@@ -287,19 +557,28 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType {
     auto& field_meta = schema[field_offset];
     auto size_per_chunk = segment_.size_per_chunk();
     auto num_chunk = upper_div(row_count_, size_per_chunk);
-    RetType bitsets;
+    RetType bitsets(num_chunk * size_per_chunk);
+    // built once, large term sets are hashed here instead of per chunk
+    TermKernel<T> kernel(expr.terms_.data(), expr.terms_.size());
+    auto sorted_terms = expr.terms_;
+    sorted_terms.erase(std::remove_if(sorted_terms.begin(), sorted_terms.end(), [](T term) { return term != term; }),
+                       sorted_terms.end());
+    std::sort(sorted_terms.begin(), sorted_terms.end());
+    auto zone_func = [&](const ZoneMap<T>& zone_map) { return TermMatch(zone_map, sorted_terms); };
     for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
-        Span<T> chunk = segment_.chunk_data<T>(field_offset, chunk_id);
-
         auto size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
-
-        boost::dynamic_bitset<> bitset(size_per_chunk);
-        for (int i = 0; i < size; ++i) {
-            auto value = chunk.data()[i];
-            bool is_in = std::binary_search(expr.terms_.begin(), expr.terms_.end(), value);
-            bitset[i] = is_in;
+        if (live_ != nullptr && !live_->any(chunk_id * size_per_chunk, chunk_id * size_per_chunk + size)) {
+            continue;
+        }
+        auto match = MatchChunk<T>(segment_, field_offset, chunk_id, zone_func);
+        if (match != ChunkMatch::Some) {
+            bitsets.fill(chunk_id * size_per_chunk, chunk_id * size_per_chunk + size, match == ChunkMatch::All);
+            continue;
         }
-        bitsets.emplace_back(std::move(bitset));
+        Span<T> chunk = segment_.chunk_data<T>(field_offset, chunk_id);
+
+        FillChunk(bitsets, live_, chunk_id * size_per_chunk, size,
+                  [&](uint64_t* words, const uint64_t* live) { kernel(chunk.data(), size, words, live); });
     }
     return bitsets;
 }
@@ -307,6 +586,7 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> RetType {
 void
 ExecExprVisitor::visit(TermExpr& expr) {
     auto& field_meta = segment_.get_schema()[expr.field_offset_];
+    ++leaf_evaluations_;
     Assert(expr.data_type_ == field_meta.get_data_type());
     RetType ret;
     switch (expr.data_type_) {
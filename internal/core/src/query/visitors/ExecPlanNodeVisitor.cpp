@@ -62,13 +62,17 @@ class ExecPlanNodeVisitor : PlanNodeVisitor {
 #endif
 
 static QueryResult
-empty_query_result(int64_t num_queries, int64_t topk, MetricType metric_type) {
+empty_query_result(int64_t num_queries, const QueryInfo& query_info) {
     QueryResult final_result;
-    SubQueryResult result(num_queries, topk, metric_type);
+    auto topk = query_info.topK_;
+    auto metric_type = query_info.metric_type_;
+    auto result = query_info.radius_.has_value() ? SubQueryResult::empty_range(num_queries, topk, metric_type)
+                                                 : SubQueryResult(num_queries, topk, metric_type);
     final_result.num_queries_ = num_queries;
     final_result.topK_ = topk;
     final_result.internal_seg_offsets_ = std::move(result.mutable_labels());
     final_result.result_distances_ = std::move(result.mutable_values());
+    final_result.result_lims_ = std::move(result.mutable_lims());
     return final_result;
 }
 
@@ -84,7 +88,7 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
     auto src_data = ph.get_blob<EmbeddedType<VectorType>>();
     auto num_queries = ph.num_of_queries_;
 
-    aligned_vector<uint8_t> bitset_holder;
+    Bitmap bitset_holder;
     BitsetView view;
     // TODO: add API to unify row_count
     // auto row_count = segment->get_row_count();
@@ -92,16 +96,27 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
 
     // skip all calculation
     if (active_count == 0) {
-        ret_ = empty_query_result(num_queries, node.query_info_.topK_, node.query_info_.metric_type_);
+        ret_ = empty_query_result(num_queries, node.query_info_);
         return;
     }
 
-    if (node.predicate_.has_value()) {
-        ExecExprVisitor::RetType expr_ret =
-            ExecExprVisitor(*segment, active_count, timestamp_).call_child(*node.predicate_.value());
-        segment->mask_with_timestamps(expr_ret, timestamp_);
-        bitset_holder = AssembleNegBitset(expr_ret);
-        view = BitsetView(bitset_holder.data(), bitset_holder.size() * 8);
+    // rows past active_count are cut off by the row count limit, a bitmap is needed only for a predicate
+    // or for the rows whose visibility the timestamp index leaves undecided
+    auto need_mask = segment->need_timestamp_mask(timestamp_);
+    if (node.predicate_.has_value() || need_mask) {
+        if (node.predicate_.has_value()) {
+            bitset_holder = ExecExprVisitor(*segment, active_count, timestamp_).call_child(*node.predicate_.value());
+        } else {
+            auto size_per_chunk = segment->size_per_chunk();
+            bitset_holder = Bitmap(upper_div(active_count, size_per_chunk) * size_per_chunk, true);
+        }
+        if (need_mask) {
+            segment->mask_with_timestamps(bitset_holder, timestamp_);
+        }
+        // negate in place, vector search skips the set bits
+        bitset_holder.flip();
+        bitset_holder.fill(active_count, bitset_holder.size(), true);
+        view = bitset_holder.view();
     }
 
     segment->vector_search(active_count, node.query_info_, src_data, num_queries, MAX_TIMESTAMP, view, ret);
@@ -92,6 +92,9 @@ VerifyPlanNodeVisitor::visit(FloatVectorANNS& node) {
 
 void
 VerifyPlanNodeVisitor::visit(BinaryVectorANNS& node) {
+    if (node.query_info_.radius_.has_value()) {
+        PanicCodeInfo(ErrorCodeEnum::IllegalArgument, "range search supports float vectors only");
+    }
     auto& search_params = node.query_info_.search_params_;
     auto inferred_type = InferBinaryIndexType(search_params);
     auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(inferred_type);
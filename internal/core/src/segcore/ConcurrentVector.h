@@ -12,11 +12,14 @@
 #pragma once
 #include <tbb/concurrent_vector.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cstring>
 #include <deque>
+#include <limits>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <vector>
 #include <utility>
 #include "exceptions/EasyAssert.h"
@@ -24,15 +27,39 @@
 #include <boost/container/vector.hpp>
 #include "common/Types.h"
 #include "common/Span.h"
+#include "common/VectorPrecision.h"
+#include "common/ZoneMap.h"
 
 namespace milvus::segcore {
 
 template <typename Type>
 using FixedVector = boost::container::vector<Type>;
 
+// append-only vector with a lock-free read path.
+// elements live in segments of doubling capacity (1, 2, 4, ...), a segment is never
+// moved or freed before destruction, so readers only need to observe size_
+// to safely access any published element; writers are serialized by mutex_.
 template <typename Type>
 class ThreadSafeVector {
  public:
+    ThreadSafeVector() = default;
+    ThreadSafeVector(const ThreadSafeVector&) = delete;
+    ThreadSafeVector&
+    operator=(const ThreadSafeVector&) = delete;
+
+    ~ThreadSafeVector() {
+        auto size = size_.load();
+        for (int64_t index = 0; index < size; ++index) {
+            get_ptr(index)->~Type();
+        }
+        for (int segment_id = 0; segment_id < MaxSegmentCount; ++segment_id) {
+            auto segment = segments_[segment_id].load(std::memory_order_relaxed);
+            if (segment != nullptr) {
+                std::allocator<Type>().deallocate(segment, int64_t(1) << segment_id);
+            }
+        }
+    }
+
     template <typename... Args>
     void
     emplace_to_at_least(int64_t size, Args... args) {
@@ -40,34 +67,57 @@ class ThreadSafeVector {
             return;
         }
         std::lock_guard lck(mutex_);
-        while (vec_.size() < size) {
-            vec_.emplace_back(std::forward<Args...>(args...));
-            ++size_;
+        auto cur_size = size_.load(std::memory_order_relaxed);
+        while (cur_size < size) {
+            auto [segment_id, segment_offset] = locate(cur_size);
+            auto segment = segments_[segment_id].load(std::memory_order_relaxed);
+            if (segment == nullptr) {
+                segment = std::allocator<Type>().allocate(int64_t(1) << segment_id);
+                segments_[segment_id].store(segment, std::memory_order_release);
+            }
+            new (segment + segment_offset) Type(args...);
+            // publish the element only after it is fully constructed
+            size_.store(++cur_size, std::memory_order_release);
         }
     }
+
     const Type&
     operator[](int64_t index) const {
-        Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        Assert(index < size());
+        return *get_ptr(index);
     }
 
     Type&
     operator[](int64_t index) {
-        Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        Assert(index < size());
+        return *get_ptr(index);
     }
 
     int64_t
     size() const {
-        return size_;
+        return size_.load(std::memory_order_acquire);
     }
 
  private:
+    static std::pair<int, int64_t>
+    locate(int64_t index) {
+        // segment k holds indexes [2^k - 1, 2^(k+1) - 1)
+        auto segment_id = 63 - __builtin_clzll(index + 1);
+        auto segment_offset = index + 1 - (int64_t(1) << segment_id);
+        return {segment_id, segment_offset};
+    }
+
+    Type*
+    get_ptr(int64_t index) const {
+        auto [segment_id, segment_offset] = locate(index);
+        return segments_[segment_id].load(std::memory_order_acquire) + segment_offset;
+    }
+
+ private:
+    static constexpr int MaxSegmentCount = 48;
     std::atomic<int64_t> size_ = 0;
-    std::deque<Type> vec_;
-    mutable std::shared_mutex mutex_;
+    std::atomic<Type*> segments_[MaxSegmentCount] = {};
+    std::mutex mutex_;
 };
 
 class VectorBase {
@@ -82,9 +132,24 @@ class VectorBase {
     virtual void
     set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) = 0;
 
+    // gather elements from row-based data straight into chunks,
+    // source points to this field of the first row, row_order (optional) permutes the rows
+    virtual void
+    set_data_raw_from_rows(ssize_t element_offset,
+                           const void* source,
+                           ssize_t sizeof_per_row,
+                           const int64_t* row_order,
+                           ssize_t element_count) = 0;
+
     virtual SpanBase
     get_span_base(int64_t chunk_id) const = 0;
 
+    // bounds of everything written into the chunk so far, monostate for vectors
+    virtual ZoneMapVariant
+    get_zone_map(int64_t chunk_id) const {
+        return {};
+    }
+
     int64_t
     get_size_per_chunk() const {
         return size_per_chunk_;
@@ -120,6 +185,9 @@ class ConcurrentVectorImpl : public VectorBase {
     grow_to_at_least(int64_t element_count) override {
         auto chunk_count = upper_div(element_count, size_per_chunk_);
         chunks_.emplace_to_at_least(chunk_count, Dim * size_per_chunk_);
+        if constexpr (with_zone_map) {
+            zone_maps_.emplace_to_at_least(chunk_count);
+        }
     }
 
     Span<TraitType>
@@ -146,6 +214,36 @@ class ConcurrentVectorImpl : public VectorBase {
         set_data(element_offset, static_cast<const Type*>(source), element_count);
     }
 
+    void
+    set_data_raw_from_rows(ssize_t element_offset,
+                           const void* source,
+                           ssize_t sizeof_per_row,
+                           const int64_t* row_order,
+                           ssize_t element_count) override {
+        if (element_count == 0) {
+            return;
+        }
+        this->grow_to_at_least(element_offset + element_count);
+        auto source_base = static_cast<const char*>(source);
+        constexpr ssize_t parallel_threshold = 4096;
+        ssize_t source_offset = 0;
+        while (source_offset < element_count) {
+            auto chunk_id = (element_offset + source_offset) / size_per_chunk_;
+            auto chunk_offset = (element_offset + source_offset) % size_per_chunk_;
+            auto count = std::min(element_count - source_offset, size_per_chunk_ - chunk_offset);
+            auto dst = chunks_[chunk_id].data() + chunk_offset * Dim;
+            auto order = row_order == nullptr ? nullptr : row_order + source_offset;
+            auto src = source_base + (row_order == nullptr ? source_offset * sizeof_per_row : 0);
+#pragma omp parallel for if (count >= parallel_threshold)
+            for (ssize_t i = 0; i < count; ++i) {
+                auto row = order == nullptr ? i : order[i];
+                memcpy(dst + i * Dim, src + row * sizeof_per_row, sizeof(Type) * Dim);
+            }
+            update_zone_map(chunk_id, dst, count);
+            source_offset += count;
+        }
+    }
+
     void
     set_data(ssize_t element_offset, const Type* source, ssize_t element_count) {
         if (element_count == 0) {
@@ -209,7 +307,43 @@ class ConcurrentVectorImpl : public VectorBase {
         return chunks_.size();
     }
 
+    ZoneMapVariant
+    get_zone_map(int64_t chunk_id) const override {
+        if constexpr (with_zone_map) {
+            auto& zone_map = zone_maps_[chunk_id];
+            ZoneMap<Type> result;
+            result.min = zone_map.min.load(std::memory_order_relaxed);
+            result.max = zone_map.max.load(std::memory_order_relaxed);
+            result.null_count = zone_map.null_count.load(std::memory_order_relaxed);
+            return result;
+        } else {
+            return {};
+        }
+    }
+
  private:
+    // merge the bounds of freshly written elements into the chunk, concurrent writers
+    // fill disjoint ranges of the same chunk, so the bounds are only ever widened by CAS
+    void
+    update_zone_map(ssize_t chunk_id, const Type* data, ssize_t element_count) {
+        if constexpr (with_zone_map) {
+            ZoneMap<Type> local;
+            local.update(data, element_count);
+            auto& zone_map = zone_maps_[chunk_id];
+            auto min = zone_map.min.load(std::memory_order_relaxed);
+            while (local.min < min &&
+                   !zone_map.min.compare_exchange_weak(min, local.min, std::memory_order_relaxed)) {
+            }
+            auto max = zone_map.max.load(std::memory_order_relaxed);
+            while (max < local.max &&
+                   !zone_map.max.compare_exchange_weak(max, local.max, std::memory_order_relaxed)) {
+            }
+            if (local.null_count != 0) {
+                zone_map.null_count.fetch_add(local.null_count, std::memory_order_relaxed);
+            }
+        }
+    }
+
     void
     fill_chunk(
         ssize_t chunk_id, ssize_t chunk_offset, ssize_t element_count, const Type* source, ssize_t source_offset) {
@@ -221,12 +355,22 @@ class ConcurrentVectorImpl : public VectorBase {
         Chunk& chunk = chunks_[chunk_id];
         auto ptr = chunk.data();
         std::copy_n(source + source_offset * Dim, element_count * Dim, ptr + chunk_offset * Dim);
+        update_zone_map(chunk_id, ptr + chunk_offset, element_count);
     }
 
     const ssize_t Dim;
 
  private:
+    static constexpr bool with_zone_map = is_scalar && HasZoneMap<Type>;
+    struct AtomicZoneMap {
+        std::atomic<Type> min = std::numeric_limits<Type>::max();
+        std::atomic<Type> max = std::numeric_limits<Type>::lowest();
+        std::atomic<int64_t> null_count = 0;
+    };
+
     ThreadSafeVector<Chunk> chunks_;
+    // parallel to chunks_, only grown when with_zone_map
+    ThreadSafeVector<AtomicZoneMap> zone_maps_;
 };
 
 template <typename Type>
@@ -238,12 +382,137 @@ class ConcurrentVector : public ConcurrentVectorImpl<Type, true> {
     }
 };
 
+// with a reduced storage precision rows are encoded into code chunks as they are written,
+// the fp32 chunks of the base class then stay empty: read through get_codes / copy_element instead.
 template <>
 class ConcurrentVector<FloatVector> : public ConcurrentVectorImpl<float, false> {
  public:
-    ConcurrentVector(int64_t dim, int64_t size_per_chunk)
-        : ConcurrentVectorImpl<float, false>::ConcurrentVectorImpl(dim, size_per_chunk) {
+    ConcurrentVector(int64_t dim, int64_t size_per_chunk, VectorPrecision precision = VectorPrecision::FP32)
+        : ConcurrentVectorImpl<float, false>::ConcurrentVectorImpl(dim, size_per_chunk),
+          dim_(dim),
+          precision_(precision),
+          code_size_(vector_code_sizeof(precision, dim)) {
+    }
+
+    bool
+    is_compact() const {
+        return precision_ != VectorPrecision::FP32;
+    }
+
+    VectorPrecision
+    get_precision() const {
+        return precision_;
+    }
+
+    void
+    grow_to_at_least(int64_t element_count) override {
+        if (!is_compact()) {
+            ConcurrentVectorImpl::grow_to_at_least(element_count);
+            return;
+        }
+        auto chunk_count = upper_div(element_count, size_per_chunk_);
+        code_chunks_.emplace_to_at_least(chunk_count, code_size_ * size_per_chunk_);
     }
+
+    void
+    set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) override {
+        set_data(element_offset, static_cast<const float*>(source), element_count);
+    }
+
+    void
+    set_data_raw_from_rows(ssize_t element_offset,
+                           const void* source,
+                           ssize_t sizeof_per_row,
+                           const int64_t* row_order,
+                           ssize_t element_count) override {
+        if (!is_compact()) {
+            ConcurrentVectorImpl::set_data_raw_from_rows(element_offset, source, sizeof_per_row, row_order,
+                                                         element_count);
+            return;
+        }
+        encode_rows(element_offset, static_cast<const char*>(source), sizeof_per_row, row_order, element_count);
+    }
+
+    void
+    set_data(ssize_t element_offset, const float* source, ssize_t element_count) {
+        if (!is_compact()) {
+            ConcurrentVectorImpl::set_data(element_offset, source, element_count);
+            return;
+        }
+        encode_rows(element_offset, reinterpret_cast<const char*>(source), sizeof(float) * dim_, nullptr,
+                    element_count);
+    }
+
+    SpanBase
+    get_span_base(int64_t chunk_id) const override {
+        AssertInfo(!is_compact(), "reduced-precision vectors have no fp32 span");
+        return ConcurrentVectorImpl::get_span_base(chunk_id);
+    }
+
+    ssize_t
+    num_chunk() const {
+        return is_compact() ? code_chunks_.size() : ConcurrentVectorImpl::num_chunk();
+    }
+
+    // size_per_chunk encoded rows, only with reduced precision
+    const uint8_t*
+    get_codes(ssize_t chunk_id) const {
+        Assert(is_compact());
+        return code_chunks_[chunk_id].data();
+    }
+
+    // fp32 copy of one element, decoded when stored at reduced precision
+    void
+    copy_element(ssize_t element_index, float* dst) const {
+        if (!is_compact()) {
+            std::copy_n(get_element(element_index), dim_, dst);
+            return;
+        }
+        auto chunk_id = element_index / size_per_chunk_;
+        auto chunk_offset = element_index % size_per_chunk_;
+        DecodeVectors(precision_, get_codes(chunk_id) + chunk_offset * code_size_, 1, dim_, dst);
+    }
+
+ private:
+    void
+    encode_rows(ssize_t element_offset,
+                const char* source,
+                ssize_t sizeof_per_row,
+                const int64_t* row_order,
+                ssize_t element_count) {
+        if (element_count == 0) {
+            return;
+        }
+        this->grow_to_at_least(element_offset + element_count);
+        constexpr ssize_t parallel_threshold = 1024;
+        ssize_t source_offset = 0;
+        while (source_offset < element_count) {
+            auto chunk_id = (element_offset + source_offset) / size_per_chunk_;
+            auto chunk_offset = (element_offset + source_offset) % size_per_chunk_;
+            auto count = std::min(element_count - source_offset, size_per_chunk_ - chunk_offset);
+            auto dst = code_chunks_[chunk_id].data() + chunk_offset * code_size_;
+            auto order = row_order == nullptr ? nullptr : row_order + source_offset;
+            auto src = source + (row_order == nullptr ? source_offset * sizeof_per_row : 0);
+#pragma omp parallel if (count >= parallel_threshold)
+            {
+                // rows of row-based data are not float aligned
+                std::vector<float> row(dim_);
+#pragma omp for
+                for (ssize_t i = 0; i < count; ++i) {
+                    auto row_index = order == nullptr ? i : order[i];
+                    memcpy(row.data(), src + row_index * sizeof_per_row, sizeof(float) * dim_);
+                    EncodeVectors(precision_, row.data(), 1, dim_, dst + i * code_size_);
+                }
+            }
+            source_offset += count;
+        }
+    }
+
+ private:
+    const int64_t dim_;
+    const VectorPrecision precision_;
+    const int64_t code_size_;
+    ThreadSafeVector<FixedVector<uint8_t>> code_chunks_;
 };
 
 template <>
@@ -15,6 +15,8 @@
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include <string>
 #include "common/SystemProperty.h"
+#include "log/Log.h"
+#include "segcore/IndexBuildScheduler.h"
 
 namespace milvus::segcore {
 void
@@ -28,11 +30,21 @@ VectorFieldIndexing::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const Vec
     assert(ack_end <= num_chunk);
     auto conf = get_build_params();
     data_.grow_to_at_least(ack_end);
+    // the small index keeps its own fp32 copy, compact chunks are decoded for it
+    std::vector<float> decoded;
     for (int chunk_id = ack_beg; chunk_id < ack_end; chunk_id++) {
-        const auto& chunk = source->get_chunk(chunk_id);
+        const float* chunk_data;
+        if (source->is_compact()) {
+            decoded.resize(source->get_size_per_chunk() * dim);
+            DecodeVectors(source->get_precision(), source->get_codes(chunk_id), source->get_size_per_chunk(), dim,
+                          decoded.data());
+            chunk_data = decoded.data();
+        } else {
+            chunk_data = source->get_chunk(chunk_id).data();
+        }
         // build index for chunk
         auto indexing = std::make_unique<knowhere::IVF>();
-        auto dataset = knowhere::GenDataset(source->get_size_per_chunk(), dim, chunk.data());
+        auto dataset = knowhere::GenDataset(source->get_size_per_chunk(), dim, chunk_data);
         indexing->Train(dataset, conf);
         indexing->AddWithoutIds(dataset, conf);
         data_[chunk_id] = std::move(indexing);
@@ -87,13 +99,49 @@ IndexingRecord::UpdateResourceAck(int64_t chunk_ack, const InsertRecord& record)
     resource_ack_ = chunk_ack;
     lck.unlock();
 
-    //    std::thread([this, old_ack, chunk_ack, &record] {
-    for (auto& [field_offset, entry] : field_indexings_) {
-        auto vec_base = record.get_field_data_base(field_offset);
-        entry->BuildIndexRange(old_ack, chunk_ack, vec_base);
+    {
+        std::lock_guard pending_lck(pending_mutex_);
+        pending_builds_ += chunk_ack - old_ack;
     }
-    finished_ack_.AddSegment(old_ack, chunk_ack);
-    //    }).detach();
+    // one build per chunk, so a burst of inserts is indexed in parallel
+    for (int64_t chunk_id = old_ack; chunk_id < chunk_ack; ++chunk_id) {
+        IndexBuildScheduler::Instance().Submit([this, chunk_id, &record] {
+            std::exception_ptr error;
+            try {
+                for (auto& [field_offset, entry] : field_indexings_) {
+                    auto vec_base = record.get_field_data_base(field_offset);
+                    entry->BuildIndexRange(chunk_id, chunk_id + 1, vec_base);
+                }
+            } catch (std::exception& e) {
+                LOG_ENGINE_ERROR_ << "small index build of chunk " << chunk_id << " failed: " << e.what();
+                error = std::current_exception();
+            } catch (...) {
+                LOG_ENGINE_ERROR_ << "small index build of chunk " << chunk_id << " failed";
+                error = std::current_exception();
+            }
+            // a failed chunk is acked as well, it keeps no index and is brute forced, later chunks keep theirs
+            finished_ack_.AddSegment(chunk_id, chunk_id + 1);
+            FinishBuild();
+            if (error) {
+                // counted as a failure by the scheduler
+                std::rethrow_exception(error);
+            }
+        });
+    }
+}
+
+void
+IndexingRecord::FinishBuild() {
+    std::lock_guard lck(pending_mutex_);
+    if (--pending_builds_ == 0) {
+        pending_cv_.notify_all();
+    }
+}
+
+void
+IndexingRecord::WaitForBuilds() const {
+    std::unique_lock lck(pending_mutex_);
+    pending_cv_.wait(lck, [this] { return pending_builds_ == 0; });
 }
 
 template <typename T>
@@ -13,6 +13,7 @@
 #include "AckResponder.h"
 #include <tbb/concurrent_vector.h>
 #include "common/Schema.h"
+#include <condition_variable>
 #include <optional>
 #include <map>
 #include <memory>
@@ -48,6 +49,7 @@ class FieldIndexing {
         return segcore_config_.get_size_per_chunk();
     }
 
+    // null when the chunk has no index, e.g. its build failed
     virtual knowhere::Index*
     get_chunk_indexing(int64_t chunk_id) const = 0;
 
@@ -68,7 +70,7 @@ class ScalarFieldIndexing : public FieldIndexing {
     knowhere::scalar::StructuredIndex<T>*
     get_chunk_indexing(int64_t chunk_id) const override {
         Assert(!field_meta_.is_vector());
-        return data_.at(chunk_id).get();
+        return chunk_id < int64_t(data_.size()) ? data_[chunk_id].get() : nullptr;
     }
 
  private:
@@ -86,7 +88,7 @@ class VectorFieldIndexing : public FieldIndexing {
     knowhere::VecIndex*
     get_chunk_indexing(int64_t chunk_id) const override {
         Assert(field_meta_.is_vector());
-        return data_.at(chunk_id).get();
+        return chunk_id < int64_t(data_.size()) ? data_[chunk_id].get() : nullptr;
     }
 
     knowhere::Config
@@ -109,6 +111,11 @@ class IndexingRecord {
         Initialize();
     }
 
+    // builds still in the scheduler reference this record and the insert record
+    ~IndexingRecord() {
+        WaitForBuilds();
+    }
+
     void
     Initialize() {
         int offset_id = 0;
@@ -133,15 +140,28 @@ class IndexingRecord {
     }
 
     // concurrent, reentrant
+    // hands every newly filled chunk to the IndexBuildScheduler, chunks become searchable
+    // through their index once [0, chunk] are all built, until then they are brute forced.
+    // a chunk whose build failed is logged and skipped, it is brute forced from then on
     void
     UpdateResourceAck(int64_t chunk_ack, const InsertRecord& record);
 
+    // block until every submitted build is done
+    void
+    WaitForBuilds() const;
+
     // concurrent
     int64_t
     get_finished_ack() const {
         return finished_ack_.GetAck();
     }
 
+    // filled chunks still waiting for their index
+    int64_t
+    get_build_lag() const {
+        return resource_ack_ - finished_ack_.GetAck();
+    }
+
     const FieldIndexing&
     get_field_indexing(FieldOffset field_offset) const {
         Assert(field_indexings_.count(field_offset));
@@ -170,6 +190,10 @@ class IndexingRecord {
         return *ptr;
     }
 
+ private:
+    void
+    FinishBuild();
+
  private:
     const Schema& schema_;
     const SegcoreConfig& segcore_config_;
@@ -181,6 +205,11 @@ class IndexingRecord {
     AckResponder finished_ack_;
     std::mutex mutex_;
 
+    // builds submitted but not done
+    int64_t pending_builds_ = 0;
+    mutable std::mutex pending_mutex_;
+    mutable std::condition_variable pending_cv_;
+
  private:
     // field_offset => indexing
     std::map<FieldOffset, std::unique_ptr<FieldIndexing>> field_indexings_;
@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <chrono>
+#include <utility>
+#include "exceptions/EasyAssert.h"
+#include "segcore/IndexBuildScheduler.h"
+
+namespace milvus::segcore {
+
+IndexBuildScheduler&
+IndexBuildScheduler::Instance() {
+    static IndexBuildScheduler instance;
+    return instance;
+}
+
+void
+IndexBuildScheduler::Configure(int64_t concurrency, int64_t queue_capacity) {
+    Assert(concurrency >= 0);
+    Assert(queue_capacity > 0);
+    std::shared_ptr<ThreadPool> pool;
+    if (concurrency > 0) {
+        pool = std::make_shared<ThreadPool>(concurrency, queue_capacity);
+    }
+    std::unique_lock lck(mutex_);
+    std::swap(pool, pool_);
+    concurrency_ = concurrency;
+    lck.unlock();
+    // the old pool drains its queue when the last submitter lets go of it
+}
+
+void
+IndexBuildScheduler::Submit(std::function<void()> task) {
+    std::unique_lock lck(mutex_);
+    auto pool = pool_;
+    lck.unlock();
+
+    ++queued_;
+    if (pool == nullptr) {
+        Run(task);
+        return;
+    }
+    // blocks while the queue is full
+    pool->enqueue([this, task = std::move(task)] { Run(task); });
+}
+
+void
+IndexBuildScheduler::Run(const std::function<void()>& task) {
+    --queued_;
+    ++running_;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        task();
+    } catch (...) {
+        ++failed_;
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+    build_us_ += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    --running_;
+    ++finished_;
+}
+
+IndexBuildMetrics
+IndexBuildScheduler::GetMetrics() const {
+    IndexBuildMetrics metrics;
+    metrics.queued = queued_;
+    metrics.running = running_;
+    metrics.finished = finished_;
+    metrics.failed = failed_;
+    metrics.build_us = build_us_;
+    return metrics;
+}
+
+}  // namespace milvus::segcore
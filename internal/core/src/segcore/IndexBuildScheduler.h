@@ -0,0 +1,75 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "utils/ThreadPool.h"
+
+namespace milvus::segcore {
+
+struct IndexBuildMetrics {
+    // chunk builds submitted but not started yet
+    int64_t queued = 0;
+    // chunk builds in progress
+    int64_t running = 0;
+    int64_t finished = 0;
+    int64_t failed = 0;
+    // total wall time spent building
+    int64_t build_us = 0;
+};
+
+// process-wide scheduler of small index builds for growing segments.
+// with concurrency 0 (the default) every build runs inline on the inserting thread,
+// otherwise builds run on a pool of that many threads; once queue_capacity builds are pending
+// Submit blocks, so inserts are throttled instead of piling up unindexed chunks without bound.
+class IndexBuildScheduler {
+ public:
+    static IndexBuildScheduler&
+    Instance();
+
+    // builds already submitted finish on the old pool
+    void
+    Configure(int64_t concurrency, int64_t queue_capacity);
+
+    int64_t
+    get_concurrency() const {
+        return concurrency_;
+    }
+
+    // task builds one chunk, exceptions are counted as failures and swallowed
+    void
+    Submit(std::function<void()> task);
+
+    IndexBuildMetrics
+    GetMetrics() const;
+
+ private:
+    IndexBuildScheduler() = default;
+
+    void
+    Run(const std::function<void()>& task);
+
+ private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<ThreadPool> pool_;
+    std::atomic<int64_t> concurrency_ = 0;
+
+    std::atomic<int64_t> queued_ = 0;
+    std::atomic<int64_t> running_ = 0;
+    std::atomic<int64_t> finished_ = 0;
+    std::atomic<int64_t> failed_ = 0;
+    std::atomic<int64_t> build_us_ = 0;
+};
+
+}  // namespace milvus::segcore
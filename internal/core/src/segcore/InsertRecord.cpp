@@ -17,7 +17,7 @@ InsertRecord::InsertRecord(const Schema& schema, int64_t size_per_chunk) : uids_
     for (auto& field : schema) {
         if (field.is_vector()) {
             if (field.get_data_type() == DataType::VECTOR_FLOAT) {
-                this->append_field_data<FloatVector>(field.get_dim(), size_per_chunk);
+                this->append_field_data(field.get_dim(), size_per_chunk, field.get_vector_precision());
                 continue;
             } else if (field.get_data_type() == DataType::VECTOR_BINARY) {
                 this->append_field_data<BinaryVector>(field.get_dim(), size_per_chunk);
@@ -70,6 +70,12 @@ struct InsertRecord {
         field_datas_.emplace_back(std::make_unique<ConcurrentVector<VectorType>>(dim, size_per_chunk));
     }
 
+    // append a float vector column stored at the given precision
+    void
+    append_field_data(int64_t dim, int64_t size_per_chunk, VectorPrecision precision) {
+        field_datas_.emplace_back(std::make_unique<ConcurrentVector<FloatVector>>(dim, size_per_chunk, precision));
+    }
+
  private:
     std::vector<std::unique_ptr<VectorBase>> field_datas_;
 };
@@ -0,0 +1,69 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <omp.h>
+#include <utility>
+#include "exceptions/EasyAssert.h"
+#include "segcore/LoadScheduler.h"
+
+namespace milvus::segcore {
+
+LoadScheduler&
+LoadScheduler::Instance() {
+    static LoadScheduler instance;
+    return instance;
+}
+
+void
+LoadScheduler::Configure(int64_t concurrency, int64_t queue_capacity) {
+    Assert(concurrency >= 0);
+    Assert(queue_capacity > 0);
+    std::shared_ptr<ThreadPool> pool;
+    if (concurrency > 0) {
+        pool = std::make_shared<ThreadPool>(concurrency, queue_capacity);
+    }
+    std::unique_lock lck(mutex_);
+    std::swap(pool, pool_);
+    concurrency_ = concurrency;
+    lck.unlock();
+    // the old pool drains its queue when the last submitter lets go of it
+}
+
+void
+LoadScheduler::Stop() {
+    std::unique_lock lck(mutex_);
+    auto pool = pool_;
+    lck.unlock();
+    if (pool != nullptr) {
+        pool->Stop();
+    }
+}
+
+std::future<void>
+LoadScheduler::Submit(std::function<void()> task) {
+    std::unique_lock lck(mutex_);
+    auto pool = pool_;
+    lck.unlock();
+
+    if (pool == nullptr) {
+        std::packaged_task<void()> inline_task(std::move(task));
+        inline_task();
+        return inline_task.get_future();
+    }
+    // blocks while the queue is full
+    return pool->enqueue([task = std::move(task)] {
+        // the pool already spreads loads over the cores, a nested omp team per load would oversubscribe them
+        omp_set_num_threads(1);
+        task();
+    });
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,57 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include "utils/ThreadPool.h"
+
+namespace milvus::segcore {
+
+// process-wide pool for sealed segment loads: copying or mapping a column and building its scalar,
+// zone map and primary key indexes. fields of many segments load side by side, bounded by the pool size.
+// with concurrency 0 (the default) every load runs inline on the submitting thread,
+// once queue_capacity loads are pending Submit blocks.
+class LoadScheduler {
+ public:
+    static LoadScheduler&
+    Instance();
+
+    // loads already submitted finish on the old pool
+    void
+    Configure(int64_t concurrency, int64_t queue_capacity);
+
+    // stop the pool after its queued loads, Submit throws until the next Configure
+    void
+    Stop();
+
+    int64_t
+    get_concurrency() const {
+        return concurrency_;
+    }
+
+    // an exception thrown by task is rethrown from the future
+    std::future<void>
+    Submit(std::function<void()> task);
+
+ private:
+    LoadScheduler() = default;
+
+ private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<ThreadPool> pool_;
+    std::atomic<int64_t> concurrency_ = 0;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,157 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/PkOffsetIndex.h"
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include "utils/tools.h"
+
+namespace milvus::segcore {
+PkOffsetIndex::PkOffsetIndex(int64_t expected_size) : shards_(std::make_unique<Shard[]>(ShardCount)) {
+    // keep load factor of each shard under 3/4
+    auto capacity = MinShardCapacity;
+    while (capacity * 3 < upper_div(expected_size, ShardCount) * 4) {
+        capacity *= 2;
+    }
+    for (int64_t shard_id = 0; shard_id < ShardCount; ++shard_id) {
+        shards_[shard_id].entries_.resize(capacity, Entry{0, -1, 0});
+    }
+}
+
+void
+PkOffsetIndex::insert_entry(Shard& shard, uint64_t hash_value, const Entry& entry) {
+    auto& entries = shard.entries_;
+    auto mask = entries.size() - 1;
+    auto slot = hash_value & mask;
+    while (entries[slot].offset != -1) {
+        slot = (slot + 1) & mask;
+    }
+    entries[slot] = entry;
+    ++shard.count_;
+}
+
+void
+PkOffsetIndex::rehash(Shard& shard, int64_t capacity) {
+    std::vector<Entry> old_entries(capacity, Entry{0, -1, 0});
+    std::swap(old_entries, shard.entries_);
+    shard.count_ = 0;
+    for (auto& entry : old_entries) {
+        if (entry.offset != -1) {
+            insert_entry(shard, hash(entry.pk), entry);
+        }
+    }
+}
+
+void
+PkOffsetIndex::insert(int64_t offset_begin, int64_t size, const int64_t* pks, const Timestamp* timestamps) {
+    // bucket rows by shard, so that each shard is locked only once per batch
+    std::vector<uint64_t> hash_values(size);
+    std::vector<int64_t> shard_sizes(ShardCount + 1, 0);
+    for (int64_t i = 0; i < size; ++i) {
+        hash_values[i] = hash(pks[i]);
+        ++shard_sizes[shard_id_of(hash_values[i]) + 1];
+    }
+    std::vector<int64_t> shard_begins(ShardCount + 1, 0);
+    std::partial_sum(shard_sizes.begin(), shard_sizes.end(), shard_begins.begin());
+    std::vector<int64_t> rows(size);
+    {
+        auto cursors = shard_begins;
+        for (int64_t i = 0; i < size; ++i) {
+            rows[cursors[shard_id_of(hash_values[i])]++] = i;
+        }
+    }
+
+    for (int64_t shard_id = 0; shard_id < ShardCount; ++shard_id) {
+        auto beg = shard_begins[shard_id];
+        auto end = shard_begins[shard_id + 1];
+        if (beg == end) {
+            continue;
+        }
+        auto& shard = shards_[shard_id];
+        std::lock_guard lck(shard.mutex_);
+        auto capacity = static_cast<int64_t>(shard.entries_.size());
+        while ((shard.count_ + end - beg) * 4 > capacity * 3) {
+            capacity *= 2;
+        }
+        if (capacity != shard.entries_.size()) {
+            rehash(shard, capacity);
+        }
+        for (auto index = beg; index < end; ++index) {
+            auto row = rows[index];
+            insert_entry(shard, hash_values[row], Entry{pks[row], offset_begin + row, timestamps[row]});
+        }
+    }
+    size_ += size;
+}
+
+int64_t
+PkOffsetIndex::find_latest_in_shard(
+    const Shard& shard, uint64_t hash_value, int64_t pk, Timestamp timestamp, int64_t offset_barrier) {
+    auto& entries = shard.entries_;
+    auto mask = entries.size() - 1;
+    auto slot = hash_value & mask;
+    int64_t the_offset = -1;
+    for (; entries[slot].offset != -1; slot = (slot + 1) & mask) {
+        auto& entry = entries[slot];
+        if (entry.pk == pk && entry.timestamp < timestamp && entry.offset < offset_barrier) {
+            the_offset = std::max(the_offset, entry.offset);
+        }
+    }
+    return the_offset;
+}
+
+int64_t
+PkOffsetIndex::find_latest(int64_t pk, Timestamp timestamp, int64_t offset_barrier) const {
+    auto hash_value = hash(pk);
+    auto& shard = shards_[shard_id_of(hash_value)];
+    std::shared_lock lck(shard.mutex_);
+    return find_latest_in_shard(shard, hash_value, pk, timestamp, offset_barrier);
+}
+
+void
+PkOffsetIndex::find_latest(
+    int64_t size, const int64_t* pks, Timestamp timestamp, int64_t offset_barrier, int64_t* offsets) const {
+    std::vector<uint64_t> hash_values(size);
+    std::vector<int64_t> rows(size);
+    for (int64_t i = 0; i < size; ++i) {
+        hash_values[i] = hash(pks[i]);
+    }
+    std::iota(rows.begin(), rows.end(), 0);
+    std::sort(rows.begin(), rows.end(),
+              [&](int64_t lhs, int64_t rhs) { return shard_id_of(hash_values[lhs]) < shard_id_of(hash_values[rhs]); });
+
+    int64_t beg = 0;
+    while (beg < size) {
+        auto shard_id = shard_id_of(hash_values[rows[beg]]);
+        auto& shard = shards_[shard_id];
+        std::shared_lock lck(shard.mutex_);
+        auto end = beg;
+        for (; end < size && shard_id_of(hash_values[rows[end]]) == shard_id; ++end) {
+            auto row = rows[end];
+            offsets[row] = find_latest_in_shard(shard, hash_values[row], pks[row], timestamp, offset_barrier);
+        }
+        beg = end;
+    }
+}
+
+int64_t
+PkOffsetIndex::memory_usage_in_bytes() const {
+    int64_t total_bytes = 0;
+    for (int64_t shard_id = 0; shard_id < ShardCount; ++shard_id) {
+        auto& shard = shards_[shard_id];
+        std::shared_lock lck(shard.mutex_);
+        total_bytes += shard.entries_.capacity() * sizeof(Entry);
+    }
+    return total_bytes;
+}
+
+}  // namespace milvus::segcore
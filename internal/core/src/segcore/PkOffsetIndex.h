@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+#include "common/Types.h"
+
+namespace milvus::segcore {
+// primary key => (offset, timestamp) index for growing segments
+// keys are hashed into shards, each shard is an open-addressing table with linear probing,
+// duplicated keys take one slot per insertion so every version of a key stays reachable
+class PkOffsetIndex {
+ public:
+    explicit PkOffsetIndex(int64_t expected_size = 0);
+
+    // insert rows [offset_begin, offset_begin + size)
+    void
+    insert(int64_t offset_begin, int64_t size, const int64_t* pks, const Timestamp* timestamps);
+
+    // the max offset of pk, which is inserted before timestamp and below offset_barrier, -1 if not found
+    int64_t
+    find_latest(int64_t pk, Timestamp timestamp, int64_t offset_barrier) const;
+
+    // batch version of find_latest, output offsets[i] for pks[i]
+    void
+    find_latest(int64_t size,
+                const int64_t* pks,
+                Timestamp timestamp,
+                int64_t offset_barrier,
+                int64_t* offsets) const;
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
+    int64_t
+    memory_usage_in_bytes() const;
+
+ private:
+    struct Entry {
+        int64_t pk;
+        int64_t offset;  // -1 means empty slot
+        Timestamp timestamp;
+    };
+
+    struct Shard {
+        std::vector<Entry> entries_;
+        int64_t count_ = 0;
+        mutable std::shared_mutex mutex_;
+    };
+
+    static uint64_t
+    hash(int64_t pk) {
+        // splitmix64 finalizer
+        auto x = static_cast<uint64_t>(pk);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static int64_t
+    shard_id_of(uint64_t hash_value) {
+        // top bits select the shard, low bits select the slot
+        return hash_value >> (64 - ShardBits);
+    }
+
+    static void
+    insert_entry(Shard& shard, uint64_t hash_value, const Entry& entry);
+
+    static void
+    rehash(Shard& shard, int64_t capacity);
+
+    static int64_t
+    find_latest_in_shard(const Shard& shard,
+                         uint64_t hash_value,
+                         int64_t pk,
+                         Timestamp timestamp,
+                         int64_t offset_barrier);
+
+ private:
+    static constexpr int ShardBits = 6;
+    static constexpr int64_t ShardCount = int64_t(1) << ShardBits;
+    static constexpr int64_t MinShardCapacity = 64;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<int64_t> size_ = 0;
+};
+
+}  // namespace milvus::segcore
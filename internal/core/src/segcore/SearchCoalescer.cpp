@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <chrono>
+#include "exceptions/EasyAssert.h"
+#include "query/PlanImpl.h"
+#include "segcore/SearchCoalescer.h"
+
+namespace milvus::segcore {
+
+SearchCoalescer&
+SearchCoalescer::Instance() {
+    static SearchCoalescer instance;
+    return instance;
+}
+
+void
+SearchCoalescer::Configure(int64_t window_us, int64_t max_batch_queries) {
+    Assert(window_us >= 0);
+    Assert(max_batch_queries >= 0);
+    window_us_ = window_us;
+    max_batch_queries_ = max_batch_queries;
+}
+
+QueryResult
+SearchCoalescer::Search(const SegmentInternalInterface& segment,
+                        const query::Plan* plan,
+                        const query::PlaceholderGroup& placeholder_group,
+                        Timestamp timestamp) {
+    AssertInfo(plan, "empty plan");
+    ++requests_;
+    auto max_batch_queries = max_batch_queries_.load();
+    // a plan without source has nothing to tell it apart from others
+    if (max_batch_queries == 0 || placeholder_group.size() != 1 || plan->source_.empty()) {
+        ++batches_;
+        return segment.Search(plan, placeholder_group, timestamp);
+    }
+    auto num_queries = placeholder_group[0].num_of_queries_;
+
+    // requests with equal keys can run as one search, plans are compared by the source they were parsed from
+    auto key = std::to_string(reinterpret_cast<uintptr_t>(&segment)) + "/" +
+               std::to_string(segment.get_snapshot_timestamp(timestamp)) + "/" + plan->source_;
+
+    std::unique_lock lck(mutex_);
+    auto& slot = slots_[key];
+    auto batch = slot.pending;
+    auto is_leader = batch == nullptr;
+    if (is_leader) {
+        batch = std::make_shared<Batch>();
+        slot.pending = batch;
+    } else if (batch->num_queries + num_queries > max_batch_queries) {
+        lck.unlock();
+        ++batches_;
+        return segment.Search(plan, placeholder_group, timestamp);
+    }
+    auto index = batch->requests.size();
+    batch->requests.push_back(&placeholder_group);
+    batch->num_queries += num_queries;
+
+    if (is_leader) {
+        // slot stays referenced: it is only erased once neither running nor pending
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(window_us_.load());
+        cv_.wait(lck, [&] { return !slot.running; });
+        cv_.wait_until(lck, deadline, [&] { return batch->num_queries >= max_batch_queries; });
+        slot.running = true;
+        slot.pending = nullptr;
+        lck.unlock();
+
+        try {
+            Run(segment, plan, timestamp, *batch);
+        } catch (...) {
+            batch->error = std::current_exception();
+        }
+        ++batches_;
+
+        lck.lock();
+        batch->done = true;
+        slot.running = false;
+        if (slot.pending == nullptr) {
+            slots_.erase(key);
+        }
+        cv_.notify_all();
+    } else {
+        // the leader reads the placeholder groups of its members, they must outlive the batch
+        if (batch->num_queries >= max_batch_queries) {
+            cv_.notify_all();
+        }
+        cv_.wait(lck, [&] { return batch->done; });
+    }
+    lck.unlock();
+
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+    return std::move(batch->results[index]);
+}
+
+void
+SearchCoalescer::Run(const SegmentInternalInterface& segment,
+                     const query::Plan* plan,
+                     Timestamp timestamp,
+                     Batch& batch) {
+    if (batch.requests.size() == 1) {
+        batch.results.push_back(segment.Search(plan, *batch.requests[0], timestamp));
+        return;
+    }
+
+    // concatenate the queries of all members into one placeholder
+    query::PlaceholderGroup merged(1);
+    auto& dst = merged[0];
+    auto& first = (*batch.requests[0])[0];
+    dst.tag_ = first.tag_;
+    dst.line_sizeof_ = first.line_sizeof_;
+    dst.num_of_queries_ = batch.num_queries;
+    dst.blob_.reserve(batch.num_queries * first.line_sizeof_);
+    for (auto request : batch.requests) {
+        auto& src = (*request)[0];
+        Assert(src.line_sizeof_ == dst.line_sizeof_);
+        dst.blob_.insert(dst.blob_.end(), src.blob_.begin(), src.blob_.end());
+    }
+
+    auto result = segment.Search(plan, merged, timestamp);
+    auto topk = result.topK_;
+    int64_t query_offset = 0;
+    for (auto request : batch.requests) {
+        auto num_queries = (*request)[0].num_of_queries_;
+        auto begin = result.get_query_offset(query_offset);
+        auto end = result.get_query_offset(query_offset + num_queries);
+        QueryResult sub_result;
+        sub_result.num_queries_ = num_queries;
+        sub_result.topK_ = topk;
+        sub_result.result_distances_.assign(result.result_distances_.begin() + begin,
+                                            result.result_distances_.begin() + end);
+        sub_result.internal_seg_offsets_.assign(result.internal_seg_offsets_.begin() + begin,
+                                                result.internal_seg_offsets_.begin() + end);
+        if (!result.result_lims_.empty()) {
+            // range results, rebase the lims of this request's queries
+            for (int64_t i = 0; i <= num_queries; ++i) {
+                sub_result.result_lims_.push_back(result.result_lims_[query_offset + i] - begin);
+            }
+        }
+        batch.results.push_back(std::move(sub_result));
+        query_offset += num_queries;
+    }
+}
+
+SearchCoalescerMetrics
+SearchCoalescer::GetMetrics() const {
+    SearchCoalescerMetrics metrics;
+    metrics.requests = requests_;
+    metrics.batches = batches_;
+    return metrics;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,89 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "query/Plan.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::segcore {
+
+struct SearchCoalescerMetrics {
+    int64_t requests = 0;
+    // searches actually run on a segment, requests - batches were served by joining another one
+    int64_t batches = 0;
+};
+
+// process-wide coalescing of concurrent searches.
+// requests against the same segment with the same plan (vector field, metric, topk, search params and filter)
+// and the same visible rows are joined into one search over all of their queries, so the chunks or the index
+// are scanned once for the whole batch, and the result is split back per request.
+// a request runs at once when nothing of its kind is in flight, otherwise it queues behind the running batch and
+// the requests that pile up meanwhile go together. with window_us > 0 the first request of a batch also waits
+// up to that long for company. max_batch_queries caps the queries of one batch, requests that don't fit run alone.
+class SearchCoalescer {
+ public:
+    static SearchCoalescer&
+    Instance();
+
+    // max_batch_queries 0 disables coalescing
+    void
+    Configure(int64_t window_us, int64_t max_batch_queries);
+
+    QueryResult
+    Search(const SegmentInternalInterface& segment,
+           const query::Plan* plan,
+           const query::PlaceholderGroup& placeholder_group,
+           Timestamp timestamp);
+
+    SearchCoalescerMetrics
+    GetMetrics() const;
+
+ private:
+    SearchCoalescer() = default;
+
+    struct Batch {
+        std::vector<const query::PlaceholderGroup*> requests;
+        int64_t num_queries = 0;
+        bool done = false;
+        std::vector<QueryResult> results;
+        std::exception_ptr error;
+    };
+
+    // one per key with a batch running or queued
+    struct Slot {
+        bool running = false;
+        std::shared_ptr<Batch> pending;
+    };
+
+    static void
+    Run(const SegmentInternalInterface& segment, const query::Plan* plan, Timestamp timestamp, Batch& batch);
+
+ private:
+    std::atomic<int64_t> window_us_ = 0;
+    std::atomic<int64_t> max_batch_queries_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, Slot> slots_;
+
+    std::atomic<int64_t> requests_ = 0;
+    std::atomic<int64_t> batches_ = 0;
+};
+
+}  // namespace milvus::segcore
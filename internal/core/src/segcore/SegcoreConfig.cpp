@@ -52,6 +52,10 @@ SegcoreConfig::parse_from(const std::string& config_path) {
         auto chunk_size = subnode(seg_config, "chunk_size").as<int64_t>();
         result.size_per_chunk_ = chunk_size;
 
+        if (seg_config["search_parallelism"].IsDefined()) {
+            result.set_search_parallelism(seg_config["search_parallelism"].as<int64_t>());
+        }
+
         auto index_list = subnode(seg_config, "small_index");
 
         Assert(index_list.IsSequence());
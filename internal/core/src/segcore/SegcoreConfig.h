@@ -57,6 +57,18 @@ class SegcoreConfig {
         size_per_chunk_ = size_per_chunk;
     }
 
+    // max threads searching the chunks of one growing segment, 0 means all omp threads
+    int64_t
+    get_search_parallelism() const {
+        return search_parallelism_;
+    }
+
+    void
+    set_search_parallelism(int64_t search_parallelism) {
+        Assert(search_parallelism >= 0);
+        search_parallelism_ = search_parallelism;
+    }
+
     void
     set_small_index_config(MetricType metric_type, const SmallIndexConf& small_index_conf) {
         table_[metric_type] = small_index_conf;
@@ -67,6 +79,7 @@ class SegcoreConfig {
 
  private:
     int64_t size_per_chunk_ = -1;
+    int64_t search_parallelism_ = 0;
     std::map<MetricType, SmallIndexConf> table_;
 };
 
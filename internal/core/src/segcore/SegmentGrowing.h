@@ -90,6 +90,10 @@ class SegmentGrowing : public SegmentInternalInterface {
 
     virtual ssize_t
     get_deleted_count() const = 0;
+
+    // filled chunks whose small index is not built yet, searched by brute force meanwhile
+    virtual int64_t
+    get_small_index_lag() const = 0;
 };
 
 using SegmentGrowingPtr = std::unique_ptr<SegmentGrowing>;
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <numeric>
 #include <thread>
+#include <tuple>
 #include <queue>
 
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
@@ -28,6 +29,7 @@
 #include "segcore/Reduce.h"
 #include "utils/tools.h"
 #include <boost/iterator/counting_iterator.hpp>
+#include <tbb/parallel_sort.h>
 
 namespace milvus::segcore {
 
@@ -60,21 +62,19 @@ SegmentGrowingImpl::get_deleted_bitmap(int64_t del_barrier,
     current->del_barrier = del_barrier;
 
     auto bitmap = current->bitmap_ptr;
+    // map uids in delete logs to the max offset inserted before query_timestamp,
+    // which should be closest to query_timestamp, so the delete log should refer to it
+    auto get_target_offsets = [&](int64_t del_begin, int64_t del_end) {
+        std::vector<idx_t> uids(del_end - del_begin);
+        for (auto del_index = del_begin; del_index < del_end; ++del_index) {
+            uids[del_index - del_begin] = deleted_record_.uids_[del_index];
+        }
+        std::vector<int64_t> offsets(uids.size());
+        uid2offset_.find_latest(uids.size(), uids.data(), query_timestamp, insert_barrier, offsets.data());
+        return offsets;
+    };
     if (del_barrier < old->del_barrier) {
-        for (auto del_index = del_barrier; del_index < old->del_barrier; ++del_index) {
-            // get uid in delete logs
-            auto uid = deleted_record_.uids_[del_index];
-            // map uid to corresponding offsets, select the max one, which should be the target
-            // the max one should be closest to query_timestamp, so the delete log should refer to it
-            int64_t the_offset = -1;
-            auto [iter_b, iter_e] = uid2offset_.equal_range(uid);
-            for (auto iter = iter_b; iter != iter_e; ++iter) {
-                auto offset = iter->second;
-                if (record_.timestamps_[offset] < query_timestamp) {
-                    Assert(offset < insert_barrier);
-                    the_offset = std::max(the_offset, offset);
-                }
-            }
+        for (auto the_offset : get_target_offsets(del_barrier, old->del_barrier)) {
             // if not found, skip
             if (the_offset == -1) {
                 continue;
@@ -84,29 +84,11 @@ SegmentGrowingImpl::get_deleted_bitmap(int64_t del_barrier,
         }
         return current;
     } else {
-        for (auto del_index = old->del_barrier; del_index < del_barrier; ++del_index) {
-            // get uid in delete logs
-            auto uid = deleted_record_.uids_[del_index];
-            // map uid to corresponding offsets, select the max one, which should be the target
-            // the max one should be closest to query_timestamp, so the delete log should refer to it
-            int64_t the_offset = -1;
-            auto [iter_b, iter_e] = uid2offset_.equal_range(uid);
-            for (auto iter = iter_b; iter != iter_e; ++iter) {
-                auto offset = iter->second;
-                if (offset >= insert_barrier) {
-                    continue;
-                }
-                if (record_.timestamps_[offset] < query_timestamp) {
-                    Assert(offset < insert_barrier);
-                    the_offset = std::max(the_offset, offset);
-                }
-            }
-
+        for (auto the_offset : get_target_offsets(old->del_barrier, del_barrier)) {
             // if not found, skip
             if (the_offset == -1) {
                 continue;
             }
-
             // otherwise, set the flag
             bitmap->set(the_offset);
         }
@@ -129,45 +111,59 @@ SegmentGrowingImpl::Insert(int64_t reserved_begin,
         throw std::runtime_error(msg);
     }
 
-    // step 2: sort timestamp
+    // step 2: sort timestamp, skipped when timestamps are already monotonic, which is the common case
     auto raw_data = reinterpret_cast<const char*>(entities_raw.raw_data);
     auto len_per_row = entities_raw.sizeof_per_row;
-    std::vector<std::tuple<Timestamp, idx_t, int64_t>> ordering;
-    ordering.resize(size);
-    // #pragma omp parallel for
-    for (int i = 0; i < size; ++i) {
-        ordering[i] = std::make_tuple(timestamps_raw[i], uids_raw[i], i);
+    std::vector<int64_t> row_order;
+    std::vector<idx_t> uids;
+    std::vector<Timestamp> timestamps;
+    if (!std::is_sorted(timestamps_raw, timestamps_raw + size)) {
+        row_order.resize(size);
+        std::iota(row_order.begin(), row_order.end(), 0);
+        tbb::parallel_sort(row_order.begin(), row_order.end(), [&](int64_t lhs, int64_t rhs) {
+            return std::tie(timestamps_raw[lhs], uids_raw[lhs], lhs) <
+                   std::tie(timestamps_raw[rhs], uids_raw[rhs], rhs);
+        });
+        uids.resize(size);
+        timestamps.resize(size);
+#pragma omp parallel for
+        for (int64_t index = 0; index < size; ++index) {
+            auto order_index = row_order[index];
+            timestamps[index] = timestamps_raw[order_index];
+            uids[index] = uids_raw[order_index];
+        }
+        uids_raw = uids.data();
+        timestamps_raw = timestamps.data();
     }
-    std::sort(ordering.begin(), ordering.end());
+    auto row_order_ptr = row_order.empty() ? nullptr : row_order.data();
 
-    // step 3: and convert row-base data to column base accordingly
+    // step 3: transpose row-based data into the column chunks directly
     auto sizeof_infos = schema_->get_sizeof_infos();
     std::vector<int> offset_infos(schema_->size() + 1, 0);
     std::partial_sum(sizeof_infos.begin(), sizeof_infos.end(), offset_infos.begin() + 1);
-    std::vector<aligned_vector<uint8_t>> entities(schema_->size());
 
+    record_.timestamps_.set_data(reserved_begin, timestamps_raw, size);
+    record_.uids_.set_data(reserved_begin, uids_raw, size);
     for (int fid = 0; fid < schema_->size(); ++fid) {
-        auto len = sizeof_infos[fid];
-        entities[fid].resize(len * size);
+        auto field_offset = FieldOffset(fid);
+        auto src = raw_data + offset_infos[fid];
+        record_.get_field_data_base(field_offset)
+            ->set_data_raw_from_rows(reserved_begin, src, len_per_row, row_order_ptr, size);
     }
 
-    std::vector<idx_t> uids(size);
-    std::vector<Timestamp> timestamps(size);
-    // #pragma omp parallel for
-    for (int index = 0; index < size; ++index) {
-        auto [t, uid, order_index] = ordering[index];
-        timestamps[index] = t;
-        uids[index] = uid;
-        for (int fid = 0; fid < schema_->size(); ++fid) {
-            auto len = sizeof_infos[fid];
-            auto offset = offset_infos[fid];
-            auto src = raw_data + offset + order_index * len_per_row;
-            auto dst = entities[fid].data() + index * len;
-            memcpy(dst, src, len);
+    if (schema_->get_is_auto_id()) {
+        do_insert_finish(reserved_begin, size, uids_raw, timestamps_raw);
+    } else {
+        auto pk_offset = schema_->get_primary_key_offset().value_or(FieldOffset(-1));
+        Assert(pk_offset.get() != -1);
+        auto src = raw_data + offset_infos[pk_offset.get()];
+        std::vector<int64_t> pks(size);
+        for (int64_t index = 0; index < size; ++index) {
+            auto row = row_order_ptr == nullptr ? index : row_order_ptr[index];
+            memcpy(&pks[index], src + row * len_per_row, sizeof(int64_t));
         }
+        do_insert_finish(reserved_begin, size, pks.data(), timestamps_raw);
     }
-
-    do_insert(reserved_begin, size, uids.data(), timestamps.data(), entities);
     return Status::OK();
 }
 
@@ -186,20 +182,23 @@ SegmentGrowingImpl::do_insert(int64_t reserved_begin,
     }
 
     if (schema_->get_is_auto_id()) {
-        for (int i = 0; i < size; ++i) {
-            auto row_id = row_ids[i];
-            // NOTE: this must be the last step, cannot be put above
-            uid2offset_.insert(std::make_pair(row_id, reserved_begin + i));
-        }
+        do_insert_finish(reserved_begin, size, row_ids, timestamps);
     } else {
         auto offset = schema_->get_primary_key_offset().value_or(FieldOffset(-1));
         Assert(offset.get() != -1);
         auto& row = columns_data[offset.get()];
         auto row_ptr = reinterpret_cast<const int64_t*>(row.data());
-        for (int i = 0; i < size; ++i) {
-            uid2offset_.insert(std::make_pair(row_ptr[i], reserved_begin + i));
-        }
+        do_insert_finish(reserved_begin, size, row_ptr, timestamps);
     }
+}
+
+void
+SegmentGrowingImpl::do_insert_finish(int64_t reserved_begin,
+                                     int64_t size,
+                                     const int64_t* primary_keys,
+                                     const Timestamp* timestamps) {
+    // NOTE: this must be the last step, cannot be put above
+    uid2offset_.insert(reserved_begin, size, primary_keys, timestamps);
 
     record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
     if (!debug_disable_small_index_) {
@@ -257,7 +256,7 @@ SegmentGrowingImpl::GetMemoryUsageInBytes() const {
     int64_t total_bytes = 0;
     auto size_per_chunk = segcore_config_.get_size_per_chunk();
     int64_t ins_n = upper_align(record_.reserved, size_per_chunk);
-    total_bytes += ins_n * (schema_->get_total_sizeof() + 16 + 1);
+    total_bytes += ins_n * (schema_->get_total_storage_sizeof() + 16 + 1);
     int64_t del_n = upper_align(deleted_record_.reserved, size_per_chunk);
     total_bytes += del_n * (16 * 2);
     return total_bytes;
@@ -280,6 +279,12 @@ SegmentGrowingImpl::chunk_data_impl(FieldOffset field_offset, int64_t chunk_id)
     return vec->get_span_base(chunk_id);
 }
 
+ZoneMapVariant
+SegmentGrowingImpl::chunk_zone_map_impl(FieldOffset field_offset, int64_t chunk_id) const {
+    auto vec = get_insert_record().get_field_data_base(field_offset);
+    return vec->get_zone_map(chunk_id);
+}
+
 int64_t
 SegmentGrowingImpl::num_chunk() const {
     auto size = get_insert_record().ack_responder_.GetAck();
@@ -377,6 +382,12 @@ SegmentGrowingImpl::bulk_subscript_impl(int64_t element_sizeof,
     for (int i = 0; i < count; ++i) {
         auto dst = output_base + i * element_sizeof;
         auto offset = seg_offsets[i];
+        if constexpr (std::is_same_v<T, FloatVector>) {
+            if (offset != -1 && vec.is_compact()) {
+                vec.copy_element(offset, reinterpret_cast<float*>(dst));
+                continue;
+            }
+        }
         const uint8_t* src = offset == -1 ? empty.data() : (const uint8_t*)vec.get_element(offset);
         memcpy(dst, src, element_sizeof);
     }
@@ -470,20 +481,17 @@ SegmentGrowingImpl::search_ids(const IdArray& id_array, Timestamp timestamp) con
     auto res_id_arr = std::make_unique<IdArray>();
     auto res_int_id_arr = res_id_arr->mutable_int_id();
     std::vector<SegOffset> res_offsets;
-    for (auto uid : src_int_arr.data()) {
-        auto [iter_b, iter_e] = uid2offset_.equal_range(uid);
-        SegOffset the_offset(-1);
-        for (auto iter = iter_b; iter != iter_e; ++iter) {
-            auto offset = SegOffset(iter->second);
-            if (record_.timestamps_[offset.get()] < timestamp) {
-                the_offset = std::max(the_offset, offset);
-            }
-        }
+    auto size = src_int_arr.data_size();
+    std::vector<int64_t> offsets(size);
+    uid2offset_.find_latest(size, src_int_arr.data().data(), timestamp, std::numeric_limits<int64_t>::max(),
+                            offsets.data());
+    for (int64_t i = 0; i < size; ++i) {
+        auto the_offset = SegOffset(offsets[i]);
         // if not found, skip
         if (the_offset == SegOffset(-1)) {
             continue;
         }
-        res_int_id_arr->add_data(uid);
+        res_int_id_arr->add_data(src_int_arr.data(i));
         res_offsets.push_back(the_offset);
     }
     return {std::move(res_id_arr), std::move(res_offsets)};
@@ -503,9 +511,24 @@ SegmentGrowingImpl::get_active_count(Timestamp ts) const {
     return *iter;
 }
 
+Timestamp
+SegmentGrowingImpl::get_snapshot_timestamp(Timestamp ts) const {
+    // rows are visible by prefix, the snapshot is identified by its last row
+    auto active_count = get_active_count(ts);
+    if (active_count == 0) {
+        return 0;
+    }
+    return get_insert_record().timestamps_[active_count - 1];
+}
+
+bool
+SegmentGrowingImpl::need_timestamp_mask(Timestamp timestamp) const {
+    // rows are inserted in timestamp order, the active count alone decides visibility
+    return false;
+}
+
 void
-SegmentGrowingImpl::mask_with_timestamps(std::deque<boost::dynamic_bitset<>>& bitset_chunks,
-                                         Timestamp timestamp) const {
+SegmentGrowingImpl::mask_with_timestamps(Bitmap& bitmap, Timestamp timestamp) const {
     // DO NOTHING
 }
 
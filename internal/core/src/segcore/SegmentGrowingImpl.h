@@ -12,7 +12,6 @@
 #pragma once
 
 #include <tbb/concurrent_priority_queue.h>
-#include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_vector.h>
 
 #include <shared_mutex>
@@ -29,6 +28,7 @@
 #include "exceptions/EasyAssert.h"
 #include "FieldIndexing.h"
 #include "InsertRecord.h"
+#include "PkOffsetIndex.h"
 #include <utility>
 #include <memory>
 #include <string>
@@ -116,6 +116,11 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return segcore_config_.get_size_per_chunk();
     }
 
+    const SegcoreConfig&
+    get_segcore_config() const {
+        return segcore_config_;
+    }
+
  public:
     void
     debug_disable_small_index() override {
@@ -137,9 +142,17 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return 0;
     }
 
+    int64_t
+    get_small_index_lag() const override {
+        return indexing_record_.get_build_lag();
+    }
+
     int64_t
     get_active_count(Timestamp ts) const override;
 
+    Timestamp
+    get_snapshot_timestamp(Timestamp ts) const override;
+
     // for scalar vectors
     template <typename T>
     void
@@ -174,8 +187,11 @@ class SegmentGrowingImpl : public SegmentGrowing {
           indexing_record_(*schema_, segcore_config_) {
     }
 
+    bool
+    need_timestamp_mask(Timestamp timestamp) const override;
+
     void
-    mask_with_timestamps(std::deque<boost::dynamic_bitset<>>& bitset_chunks, Timestamp timestamp) const override;
+    mask_with_timestamps(Bitmap& bitmap, Timestamp timestamp) const override;
 
     void
     vector_search(int64_t vec_count,
@@ -200,6 +216,9 @@ class SegmentGrowingImpl : public SegmentGrowing {
     SpanBase
     chunk_data_impl(FieldOffset field_offset, int64_t chunk_id) const override;
 
+    ZoneMapVariant
+    chunk_zone_map_impl(FieldOffset field_offset, int64_t chunk_id) const override;
+
     void
     check_search(const query::Plan* plan) const override {
         Assert(plan);
@@ -213,6 +232,13 @@ class SegmentGrowingImpl : public SegmentGrowing {
               const Timestamp* timestamps,
               const std::vector<aligned_vector<uint8_t>>& columns_data);
 
+    // index primary keys and ack the rows, once all columns of [reserved_begin, reserved_begin + size) are filled
+    void
+    do_insert_finish(int64_t reserved_begin,
+                     int64_t size,
+                     const int64_t* primary_keys,
+                     const Timestamp* timestamps);
+
  private:
     SegcoreConfig segcore_config_;
     SchemaPtr schema_;
@@ -223,7 +249,7 @@ class SegmentGrowingImpl : public SegmentGrowing {
     IndexingRecord indexing_record_;
     SealedIndexingRecord sealed_indexing_record_;
 
-    tbb::concurrent_unordered_multimap<idx_t, int64_t> uid2offset_;
+    PkOffsetIndex uid2offset_;
 
  private:
     bool debug_disable_small_index_ = false;
@@ -53,22 +53,22 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, QueryResult&
         element_sizeofs.push_back(element_sizeof);
     }
 
-    auto target_sizeof = std::accumulate(element_sizeofs.begin(), element_sizeofs.end(), 0);
-
-    for (int64_t i = 0; i < size; ++i) {
-        int64_t element_offset = 0;
-        std::vector<char> target(target_sizeof);
-        for (int loc = 0; loc < blobs.size(); ++loc) {
-            auto element_sizeof = element_sizeofs[loc];
-            auto blob_ptr = blobs[loc].data();
-            auto src = blob_ptr + element_sizeof * i;
-            auto dst = target.data() + element_offset;
-            memcpy(dst, src, element_sizeof);
-            element_offset += element_sizeof;
+    auto target_sizeof = std::accumulate(element_sizeofs.begin(), element_sizeofs.end(), int64_t(0));
+
+    // one row-major arena for all hits, each field is scattered into its column of the rows
+    results.row_data_sizeof_ = target_sizeof;
+    results.row_data_.resize(size * target_sizeof);
+    int64_t element_offset = 0;
+    for (int loc = 0; loc < blobs.size(); ++loc) {
+        auto element_sizeof = element_sizeofs[loc];
+        auto src = blobs[loc].data();
+        auto dst = results.row_data_.data() + element_offset;
+        for (int64_t i = 0; i < size; ++i) {
+            memcpy(dst + i * target_sizeof, src + i * element_sizeof, element_sizeof);
         }
-        assert(element_offset == target_sizeof);
-        results.row_data_.emplace_back(std::move(target));
+        element_offset += element_sizeof;
     }
+    assert(element_offset == target_sizeof);
 }
 
 QueryResult
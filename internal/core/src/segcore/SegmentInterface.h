@@ -14,6 +14,8 @@
 #include "common/Schema.h"
 #include "query/Plan.h"
 #include "common/Span.h"
+#include "common/Bitmap.h"
+#include "common/ZoneMap.h"
 #include "FieldIndexing.h"
 #include <knowhere/index/vector_index/VecIndex.h>
 #include "common/SystemProperty.h"
@@ -21,6 +23,7 @@
 #include "pb/schema.pb.h"
 #include "pb/segcore.pb.h"
 #include <memory>
+#include <optional>
 #include <deque>
 #include <vector>
 #include <utility>
@@ -68,15 +71,31 @@ class SegmentInternalInterface : public SegmentInterface {
         return static_cast<Span<T>>(chunk_data_impl(field_offset, chunk_id));
     }
 
+    // null when the chunk has no index, e.g. its small index build failed
     template <typename T>
-    const knowhere::scalar::StructuredIndex<T>&
+    const knowhere::scalar::StructuredIndex<T>*
     chunk_scalar_index(FieldOffset field_offset, int64_t chunk_id) const {
         static_assert(IsScalar<T>);
         using IndexType = knowhere::scalar::StructuredIndex<T>;
         auto base_ptr = chunk_index_impl(field_offset, chunk_id);
+        if (base_ptr == nullptr) {
+            return nullptr;
+        }
         auto ptr = dynamic_cast<const IndexType*>(base_ptr);
         AssertInfo(ptr, "entry mismatch");
-        return *ptr;
+        return ptr;
+    }
+
+    // bounds of a chunk, nullopt when the segment keeps none for the field
+    template <typename T>
+    std::optional<ZoneMap<T>>
+    chunk_zone_map(FieldOffset field_offset, int64_t chunk_id) const {
+        static_assert(IsScalar<T>);
+        auto zone_map = chunk_zone_map_impl(field_offset, chunk_id);
+        if (auto ptr = std::get_if<ZoneMap<T>>(&zone_map)) {
+            return *ptr;
+        }
+        return std::nullopt;
     }
 
     QueryResult
@@ -109,8 +128,13 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual int64_t
     num_chunk_index(FieldOffset field_offset) const = 0;
 
+    // whether some of the first get_active_count(timestamp) rows are still invisible at timestamp,
+    // only those rows are touched by mask_with_timestamps
+    virtual bool
+    need_timestamp_mask(Timestamp timestamp) const = 0;
+
     virtual void
-    mask_with_timestamps(std::deque<boost::dynamic_bitset<>>& bitset_chunks, Timestamp timestamp) const = 0;
+    mask_with_timestamps(Bitmap& bitmap, Timestamp timestamp) const = 0;
 
     // count of chunks
     virtual int64_t
@@ -123,6 +147,11 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual int64_t
     get_active_count(Timestamp ts) const = 0;
 
+    // a representative of the timestamps that see exactly the same rows as ts,
+    // searches with equal snapshot timestamps return equal results
+    virtual Timestamp
+    get_snapshot_timestamp(Timestamp ts) const = 0;
+
  protected:
     // internal API: return chunk_data in span
     virtual SpanBase
@@ -132,6 +161,10 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual const knowhere::Index*
     chunk_index_impl(FieldOffset field_offset, int64_t chunk_id) const = 0;
 
+    // internal API: return zone map of a scalar chunk, monostate if absent
+    virtual ZoneMapVariant
+    chunk_zone_map_impl(FieldOffset field_offset, int64_t chunk_id) const = 0;
+
     // TODO remove system fields
     // calculate output[i] = Vec[seg_offsets[i]}, where Vec binds to system_type
     virtual void
@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 #pragma once
+#include <future>
 #include <memory>
 
 #include "segcore/SegmentInterface.h"
@@ -26,6 +27,10 @@ class SegmentSealed : public SegmentInternalInterface {
     LoadSegmentMeta(const milvus::proto::segcore::LoadSegmentMeta& meta) = 0;
     virtual void
     LoadFieldData(const LoadFieldDataInfo& info) = 0;
+    // loads on the LoadScheduler pool, info.blob must stay valid until the future is ready.
+    // the field is searchable as soon as its own load finishes
+    virtual std::future<void>
+    LoadFieldDataAsync(const LoadFieldDataInfo& info) = 0;
     virtual void
     DropIndex(const FieldId field_id) = 0;
     virtual void
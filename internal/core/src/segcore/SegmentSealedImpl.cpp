@@ -13,6 +13,7 @@
 #include "query/SearchOnSealed.h"
 #include "query/ScalarIndex.h"
 #include "query/SearchBruteForce.h"
+#include "segcore/LoadScheduler.h"
 
 namespace milvus::segcore {
 
@@ -56,7 +57,7 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
     // NOTE: lock only when data is ready to avoid starvation
     Assert(info.row_count > 0);
     auto field_id = FieldId(info.field_id);
-    Assert(info.blob);
+    Assert(info.blob || !info.file_path.empty());
     Assert(info.row_count > 0);
     auto create_index = [](const int64_t* data, int64_t size) {
         Assert(size);
@@ -66,10 +67,22 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         return pk_index;
     };
 
+    // a file-backed column is read through a mapping, user fields keep it as their storage
+    auto map_column = [&](int64_t element_sizeof) {
+        if (info.file_path.empty()) {
+            return FieldBuffer();
+        }
+        return FieldBuffer::Map(info.file_path, info.file_offset, element_sizeof * info.row_count,
+                                info.access_pattern);
+    };
+
     if (SystemProperty::Instance().IsSystem(field_id)) {
         auto system_field_type = SystemProperty::Instance().GetSystemFieldType(field_id);
+        // system fields are indexed and kept on the heap, the mapping only saves the caller's copy
+        auto mapped = map_column(sizeof(int64_t));
+        auto blob = mapped.is_mapped() ? mapped.data() : info.blob;
         if (system_field_type == SystemFieldType::Timestamp) {
-            auto src_ptr = reinterpret_cast<const Timestamp*>(info.blob);
+            auto src_ptr = reinterpret_cast<const Timestamp*>(blob);
             aligned_vector<Timestamp> vec_data(info.row_count);
             std::copy_n(src_ptr, info.row_count, vec_data.data());
 
@@ -88,10 +101,11 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
             AssertInfo(timestamps_.empty(), "already exists");
             timestamps_ = std::move(vec_data);
             timestamp_index_ = std::move(index);
+            timestamp_mask_cache_.clear();
 
         } else {
             Assert(system_field_type == SystemFieldType::RowId);
-            auto src_ptr = reinterpret_cast<const idx_t*>(info.blob);
+            auto src_ptr = reinterpret_cast<const idx_t*>(blob);
 
             // prepare data
             aligned_vector<idx_t> vec_data(info.row_count);
@@ -120,15 +134,40 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         auto& field_meta = schema_->operator[](field_offset);
         // Assert(!field_meta.is_vector());
         auto element_sizeof = field_meta.get_sizeof();
-        auto span = SpanBase(info.blob, info.row_count, element_sizeof);
+        auto mapped = map_column(element_sizeof);
+        auto blob = mapped.is_mapped() ? mapped.data() : info.blob;
+        auto span = SpanBase(blob, info.row_count, element_sizeof);
         auto length_in_bytes = element_sizeof * info.row_count;
-        aligned_vector<char> vec_data(length_in_bytes);
-        memcpy(vec_data.data(), info.blob, length_in_bytes);
+        FieldBuffer vec_data;
+        if (field_meta.get_storage_sizeof() != element_sizeof) {
+            // reduced-precision float vectors are encoded as they are loaded, the fp32 blob is not kept
+            auto dim = field_meta.get_dim();
+            auto precision = field_meta.get_vector_precision();
+            auto code_size = field_meta.get_storage_sizeof();
+            aligned_vector<char> codes(code_size * info.row_count);
+            auto src = reinterpret_cast<const float*>(blob);
+            auto dst = reinterpret_cast<uint8_t*>(codes.data());
+            constexpr int64_t block_rows = 4096;
+#pragma omp parallel for
+            for (int64_t begin = 0; begin < info.row_count; begin += block_rows) {
+                auto rows = std::min(block_rows, info.row_count - begin);
+                EncodeVectors(precision, src + begin * dim, rows, dim, dst + begin * code_size);
+            }
+            vec_data = FieldBuffer(std::move(codes));
+        } else if (mapped.is_mapped()) {
+            vec_data = std::move(mapped);
+        } else {
+            aligned_vector<char> copy(length_in_bytes);
+            memcpy(copy.data(), blob, length_in_bytes);
+            vec_data = FieldBuffer(std::move(copy));
+        }
 
         // generate scalar index
         std::unique_ptr<knowhere::Index> index;
+        ZoneMapVariant zone_map;
         if (!field_meta.is_vector()) {
             index = query::generate_scalar_index(span, field_meta.get_data_type());
+            zone_map = query::generate_zone_map(span, field_meta.get_data_type());
         }
 
         std::unique_ptr<ScalarIndexBase> pk_index_;
@@ -148,6 +187,7 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
             AssertInfo(!scalar_indexings_[field_offset.get()], "scalar indexing not cleared");
             field_datas_[field_offset.get()] = std::move(vec_data);
             scalar_indexings_[field_offset.get()] = std::move(index);
+            zone_maps_[field_offset.get()] = std::move(zone_map);
         }
 
         if (schema_->get_primary_key_offset() == field_offset) {
@@ -178,11 +218,20 @@ SegmentSealedImpl::chunk_data_impl(FieldOffset field_offset, int64_t chunk_id) c
     std::shared_lock lck(mutex_);
     Assert(get_bit(field_data_ready_bitset_, field_offset));
     auto& field_meta = schema_->operator[](field_offset);
+    AssertInfo(field_meta.get_storage_sizeof() == field_meta.get_sizeof(),
+               "reduced-precision vectors have no fp32 span");
     auto element_sizeof = field_meta.get_sizeof();
     SpanBase base(field_datas_[field_offset.get()].data(), row_count_opt_.value(), element_sizeof);
     return base;
 }
 
+ZoneMapVariant
+SegmentSealedImpl::chunk_zone_map_impl(FieldOffset field_offset, int64_t chunk_id) const {
+    Assert(chunk_id == 0);
+    std::shared_lock lck(mutex_);
+    return zone_maps_[field_offset.get()];
+}
+
 const knowhere::Index*
 SegmentSealedImpl::chunk_index_impl(FieldOffset field_offset, int64_t chunk_id) const {
     Assert(chunk_id == 0);
@@ -197,7 +246,14 @@ SegmentSealedImpl::GetMemoryUsageInBytes() const {
     // TODO: add estimate for index
     std::shared_lock lck(mutex_);
     auto row_count = row_count_opt_.value_or(0);
-    return schema_->get_total_sizeof() * row_count;
+    int64_t usage = schema_->get_total_storage_sizeof() * row_count;
+    // mapped fields live in the page cache, which the kernel reclaims on its own
+    for (auto& field_data : field_datas_) {
+        if (field_data.is_mapped()) {
+            usage -= field_data.size();
+        }
+    }
+    return usage;
 }
 
 int64_t
@@ -239,23 +295,31 @@ SegmentSealedImpl::vector_search(int64_t vec_count,
     dataset.metric_type = query_info.metric_type_;
     dataset.topk = query_info.topK_;
     dataset.dim = field_meta.get_dim();
+    dataset.radius = query_info.radius_;
 
     Assert(get_bit(field_data_ready_bitset_, field_offset));
     Assert(row_count_opt_.has_value());
-    auto row_count = row_count_opt_.value();
+    // rows past vec_count are not visible yet, brute force never reads them
+    Assert(vec_count <= row_count_opt_.value());
     auto chunk_data = field_datas_[field_offset.get()].data();
 
     auto sub_qr = [&] {
         if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-            return query::FloatSearchBruteForce(dataset, chunk_data, row_count, bitset);
+            auto precision = field_meta.get_vector_precision();
+            if (precision != VectorPrecision::FP32) {
+                auto codes = reinterpret_cast<const uint8_t*>(chunk_data);
+                return query::CompactSearchBruteForce(dataset, codes, precision, vec_count, bitset);
+            }
+            return query::FloatSearchBruteForce(dataset, chunk_data, vec_count, bitset);
         } else {
-            return query::BinarySearchBruteForce(dataset, chunk_data, row_count, bitset);
+            return query::BinarySearchBruteForce(dataset, chunk_data, vec_count, bitset);
         }
     }();
 
     QueryResult results;
     results.result_distances_ = std::move(sub_qr.mutable_values());
     results.internal_seg_offsets_ = std::move(sub_qr.mutable_labels());
+    results.result_lims_ = std::move(sub_qr.mutable_lims());
     results.topK_ = dataset.topk;
     results.num_queries_ = dataset.num_queries;
 
@@ -273,6 +337,7 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
             auto row_ids = std::move(row_ids_);
         } else if (system_field_type == SystemFieldType::Timestamp) {
             auto ts = std::move(timestamps_);
+            timestamp_mask_cache_.clear();
         }
         lck.unlock();
     } else {
@@ -282,6 +347,7 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
         std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_offset, false);
         auto vec = std::move(field_datas_[field_offset.get()]);
+        zone_maps_[field_offset.get()] = std::monostate();
         lck.unlock();
 
         vec.clear();
@@ -324,10 +390,44 @@ SegmentSealedImpl::check_search(const query::Plan* plan) const {
 SegmentSealedImpl::SegmentSealedImpl(SchemaPtr schema)
     : schema_(schema),
       field_datas_(schema->size()),
+      zone_maps_(schema->size()),
       field_data_ready_bitset_(schema->size()),
       vecindex_ready_bitset_(schema->size()),
       scalar_indexings_(schema->size()) {
 }
+
+SegmentSealedImpl::~SegmentSealedImpl() {
+    std::unique_lock lck(pending_loads_mutex_);
+    pending_loads_cv_.wait(lck, [this] { return pending_loads_ == 0; });
+}
+
+std::future<void>
+SegmentSealedImpl::LoadFieldDataAsync(const LoadFieldDataInfo& info) {
+    {
+        std::lock_guard lck(pending_loads_mutex_);
+        ++pending_loads_;
+    }
+    auto finish = [this] {
+        std::lock_guard lck(pending_loads_mutex_);
+        --pending_loads_;
+        pending_loads_cv_.notify_all();
+    };
+    try {
+        return LoadScheduler::Instance().Submit([this, info, finish] {
+            try {
+                LoadFieldData(info);
+            } catch (...) {
+                finish();
+                throw;
+            }
+            finish();
+        });
+    } catch (...) {
+        // the load was never queued, e.g. the pool is stopped
+        finish();
+        throw;
+    }
+}
 void
 SegmentSealedImpl::bulk_subscript(SystemFieldType system_type,
                                   const int64_t* seg_offsets,
@@ -337,6 +437,20 @@ SegmentSealedImpl::bulk_subscript(SystemFieldType system_type,
     Assert(system_type == SystemFieldType::RowId);
     bulk_subscript_impl<int64_t>(row_ids_.data(), seg_offsets, count, output);
 }
+// hits sit at random offsets, so gathers touch the row a few hits ahead to overlap its cache miss with the copies
+constexpr int64_t kGatherPrefetchDistance = 8;
+
+static inline void
+PrefetchRow(const char* src, const int64_t* seg_offsets, int64_t count, int64_t index, int64_t element_sizeof) {
+    if (index >= count || seg_offsets[index] == -1) {
+        return;
+    }
+    auto row = src + seg_offsets[index] * element_sizeof;
+    for (int64_t byte = 0; byte < element_sizeof; byte += 64) {
+        __builtin_prefetch(row + byte);
+    }
+}
+
 template <typename T>
 void
 SegmentSealedImpl::bulk_subscript_impl(const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw) {
@@ -344,6 +458,7 @@ SegmentSealedImpl::bulk_subscript_impl(const void* src_raw, const int64_t* seg_o
     auto src = reinterpret_cast<const T*>(src_raw);
     auto dst = reinterpret_cast<T*>(dst_raw);
     for (int64_t i = 0; i < count; ++i) {
+        PrefetchRow(reinterpret_cast<const char*>(src), seg_offsets, count, i + kGatherPrefetchDistance, sizeof(T));
         auto offset = seg_offsets[i];
         dst[i] = offset == -1 ? -1 : src[offset];
     }
@@ -357,6 +472,7 @@ SegmentSealedImpl::bulk_subscript_impl(
     auto dst_vec = reinterpret_cast<char*>(dst_raw);
     std::vector<char> none(element_sizeof, 0);
     for (int64_t i = 0; i < count; ++i) {
+        PrefetchRow(src_vec, seg_offsets, count, i + kGatherPrefetchDistance, element_sizeof);
         auto offset = seg_offsets[i];
         auto dst = dst_vec + i * element_sizeof;
         const char* src;
@@ -369,6 +485,29 @@ SegmentSealedImpl::bulk_subscript_impl(
     }
 }
 
+// for reduced-precision float vector, rows are decoded back to fp32
+void
+SegmentSealedImpl::bulk_subscript_impl(VectorPrecision precision,
+                                       int64_t dim,
+                                       const void* src_raw,
+                                       const int64_t* seg_offsets,
+                                       int64_t count,
+                                       void* dst_raw) {
+    auto code_size = vector_code_sizeof(precision, dim);
+    auto src_vec = reinterpret_cast<const uint8_t*>(src_raw);
+    auto dst_vec = reinterpret_cast<float*>(dst_raw);
+    for (int64_t i = 0; i < count; ++i) {
+        PrefetchRow(reinterpret_cast<const char*>(src_vec), seg_offsets, count, i + kGatherPrefetchDistance, code_size);
+        auto offset = seg_offsets[i];
+        auto dst = dst_vec + i * dim;
+        if (offset != -1) {
+            DecodeVectors(precision, src_vec + code_size * offset, 1, dim, dst);
+        } else {
+            std::fill_n(dst, dim, 0.0f);
+        }
+    }
+}
+
 void
 SegmentSealedImpl::bulk_subscript(FieldOffset field_offset,
                                   const int64_t* seg_offsets,
@@ -407,7 +546,15 @@ SegmentSealedImpl::bulk_subscript(FieldOffset field_offset,
             break;
         }
 
-        case DataType::VECTOR_FLOAT:
+        case DataType::VECTOR_FLOAT: {
+            auto precision = field_meta.get_vector_precision();
+            if (precision != VectorPrecision::FP32) {
+                bulk_subscript_impl(precision, field_meta.get_dim(), src_vec, seg_offsets, count, output);
+                break;
+            }
+            bulk_subscript_impl(field_meta.get_sizeof(), src_vec, seg_offsets, count, output);
+            break;
+        }
         case DataType::VECTOR_BINARY: {
             bulk_subscript_impl(field_meta.get_sizeof(), src_vec, seg_offsets, count, output);
             break;
@@ -467,21 +614,41 @@ SegmentSealedImpl::LoadSegmentMeta(const proto::segcore::LoadSegmentMeta& segmen
 }
 int64_t
 SegmentSealedImpl::get_active_count(Timestamp ts) const {
-    // TODO optimize here to reduce expr search range
-    return this->get_row_count();
+    if (this->timestamps_.empty()) {
+        return this->get_row_count();
+    }
+    // rows past the undecided slice are inserted after ts
+    return timestamp_index_.get_active_range(ts).second;
 }
+Timestamp
+SegmentSealedImpl::get_snapshot_timestamp(Timestamp ts) const {
+    auto range = timestamp_index_.get_active_range(ts);
+    if (range.first == range.second && range.first == this->timestamps_.size()) {
+        // every row is visible
+        return MAX_TIMESTAMP;
+    }
+    return ts;
+}
+
+bool
+SegmentSealedImpl::need_timestamp_mask(Timestamp timestamp) const {
+    if (this->timestamps_.empty()) {
+        return false;
+    }
+    auto range = timestamp_index_.get_active_range(timestamp);
+    return range.first < range.second;
+}
+
 void
-SegmentSealedImpl::mask_with_timestamps(std::deque<boost::dynamic_bitset<>>& bitset_chunks, Timestamp timestamp) const {
-    // TODO change the
+SegmentSealedImpl::mask_with_timestamps(Bitmap& bitmap, Timestamp timestamp) const {
     Assert(this->timestamps_.size() == get_row_count());
-    Assert(bitset_chunks.size() == 1);
     auto range = timestamp_index_.get_active_range(timestamp);
-    if (range.first == range.second && range.first == this->timestamps_.size()) {
-        // just skip
+    if (range.first == range.second) {
+        // [0, beg) is visible and the rest is past the active count
         return;
     }
-    auto mask = TimestampIndex::GenerateBitset(timestamp, range, this->timestamps_.data(), this->timestamps_.size());
-    bitset_chunks[0] &= mask;
+    auto mask = timestamp_mask_cache_.Get(timestamp, range, this->timestamps_.data());
+    TimestampIndex::ApplyMask(*mask, bitmap);
 }
 
 SegmentSealedPtr
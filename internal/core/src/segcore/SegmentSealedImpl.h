@@ -11,10 +11,14 @@
 
 #pragma once
 #include <segcore/TimestampIndex.h>
+#include <boost/dynamic_bitset.hpp>
+#include "common/FieldBuffer.h"
 #include "segcore/SegmentSealed.h"
 #include "SealedIndexingRecord.h"
 #include "ScalarIndex.h"
+#include <condition_variable>
 #include <deque>
+#include <future>
 #include <map>
 #include <vector>
 #include <memory>
@@ -25,10 +29,14 @@ namespace milvus::segcore {
 class SegmentSealedImpl : public SegmentSealed {
  public:
     explicit SegmentSealedImpl(SchemaPtr schema);
+    // waits for the loads still in flight
+    ~SegmentSealedImpl() override;
     void
     LoadIndex(const LoadIndexInfo& info) override;
     void
     LoadFieldData(const LoadFieldDataInfo& info) override;
+    std::future<void>
+    LoadFieldDataAsync(const LoadFieldDataInfo& info) override;
     void
     LoadSegmentMeta(const milvus::proto::segcore::LoadSegmentMeta& segment_meta) override;
     void
@@ -72,6 +80,9 @@ class SegmentSealedImpl : public SegmentSealed {
     const knowhere::Index*
     chunk_index_impl(FieldOffset field_offset, int64_t chunk_id) const override;
 
+    ZoneMapVariant
+    chunk_zone_map_impl(FieldOffset field_offset, int64_t chunk_id) const override;
+
     // Calculate: output[i] = Vec[seg_offset[i]],
     // where Vec is determined from field_offset
     void
@@ -88,6 +99,9 @@ class SegmentSealedImpl : public SegmentSealed {
     int64_t
     get_active_count(Timestamp ts) const override;
 
+    Timestamp
+    get_snapshot_timestamp(Timestamp ts) const override;
+
  private:
     template <typename T>
     static void
@@ -97,6 +111,14 @@ class SegmentSealedImpl : public SegmentSealed {
     bulk_subscript_impl(
         int64_t element_sizeof, const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw);
 
+    static void
+    bulk_subscript_impl(VectorPrecision precision,
+                        int64_t dim,
+                        const void* src_raw,
+                        const int64_t* seg_offsets,
+                        int64_t count,
+                        void* dst_raw);
+
     void
     update_row_count(int64_t row_count) {
         if (row_count_opt_.has_value()) {
@@ -106,8 +128,11 @@ class SegmentSealedImpl : public SegmentSealed {
         }
     }
 
+    bool
+    need_timestamp_mask(Timestamp timestamp) const override;
+
     void
-    mask_with_timestamps(std::deque<boost::dynamic_bitset<>>& bitset_chunks, Timestamp timestamp) const override;
+    mask_with_timestamps(Bitmap& bitmap, Timestamp timestamp) const override;
 
     void
     vector_search(int64_t vec_count,
@@ -134,6 +159,10 @@ class SegmentSealedImpl : public SegmentSealed {
     boost::dynamic_bitset<> field_data_ready_bitset_;
     boost::dynamic_bitset<> vecindex_ready_bitset_;
     std::atomic<int> system_ready_count_ = 0;
+    // async loads submitted but not finished
+    std::mutex pending_loads_mutex_;
+    std::condition_variable pending_loads_cv_;
+    int64_t pending_loads_ = 0;
     // segment datas
 
     // TODO: generate index for scalar
@@ -144,12 +173,15 @@ class SegmentSealedImpl : public SegmentSealed {
     std::vector<std::unique_ptr<knowhere::Index>> scalar_indexings_;
     std::unique_ptr<ScalarIndexBase> primary_key_index_;
 
-    std::vector<aligned_vector<char>> field_datas_;
+    std::vector<FieldBuffer> field_datas_;
+    // one zone map per scalar field, the whole segment is a single chunk
+    std::vector<ZoneMapVariant> zone_maps_;
 
     SealedIndexingRecord vecindexs_;
     aligned_vector<idx_t> row_ids_;
     aligned_vector<Timestamp> timestamps_;
     TimestampIndex timestamp_index_;
+    mutable TimestampMaskCache timestamp_mask_cache_;
     SchemaPtr schema_;
 };
 }  // namespace milvus::segcore
@@ -59,21 +59,86 @@ TimestampIndex::get_active_range(Timestamp query_timestamp) const {
     Assert(0 <= block_id && block_id < lengths_.size());
     return {start_locs_[block_id], start_locs_[block_id + 1]};
 }
-boost::dynamic_bitset<>
-TimestampIndex::GenerateBitset(Timestamp query_timestamp,
-                               std::pair<int64_t, int64_t> active_range,
-                               const Timestamp* timestamps,
-                               int64_t size) {
+TimestampMask
+TimestampIndex::BuildMask(Timestamp query_timestamp,
+                          std::pair<int64_t, int64_t> active_range,
+                          const Timestamp* timestamps) {
     auto [beg, end] = active_range;
     Assert(beg < end);
-    boost::dynamic_bitset<> bitset;
-    bitset.reserve(size);
-    bitset.resize(beg, true);
-    bitset.resize(size, false);
+    TimestampMask mask;
+    mask.begin = beg;
+    mask.end = end;
+    // rows before beg are visible, so the compare may start on a word boundary
+    mask.aligned_begin = beg / 64 * 64;
+    mask.visible = Bitmap(end - mask.aligned_begin);
+
+    auto words = mask.visible.words();
+    auto src = timestamps + mask.aligned_begin;
+    auto size = end - mask.aligned_begin;
+    for (int64_t w = 0; w * 64 < size; ++w) {
+        auto count = std::min<int64_t>(64, size - w * 64);
+        uint64_t word = 0;
+        for (int64_t i = 0; i < count; ++i) {
+            word |= uint64_t(src[w * 64 + i] <= query_timestamp) << i;
+        }
+        words[w] = word;
+    }
+
+    Timestamp lower = 0;
+    Timestamp upper = MAX_TIMESTAMP;
     for (int64_t i = beg; i < end; ++i) {
-        bitset[i] = timestamps[i] <= query_timestamp;
+        auto ts = timestamps[i];
+        lower = std::max(lower, ts <= query_timestamp ? ts : Timestamp(0));
+        upper = std::min(upper, ts > query_timestamp ? ts : MAX_TIMESTAMP);
     }
-    return bitset;
+    mask.lower = lower;
+    mask.upper = upper;
+    return mask;
+}
+
+void
+TimestampIndex::ApplyMask(const TimestampMask& mask, Bitmap& bitmap) {
+    Assert(bitmap.size() >= mask.end);
+    auto dst = bitmap.words() + mask.aligned_begin / 64;
+    auto src = mask.visible.words();
+    auto num_words = mask.visible.num_words();
+    for (int64_t w = 0; w < num_words; ++w) {
+        dst[w] &= src[w];
+    }
+}
+
+std::shared_ptr<const TimestampMask>
+TimestampMaskCache::Get(Timestamp query_timestamp,
+                        std::pair<int64_t, int64_t> active_range,
+                        const Timestamp* timestamps) {
+    auto hit = [&](const std::shared_ptr<const TimestampMask>& mask) {
+        return mask->begin == active_range.first && mask->end == active_range.second &&
+               mask->lower <= query_timestamp && query_timestamp < mask->upper;
+    };
+    {
+        std::lock_guard lck(mutex_);
+        auto iter = std::find_if(masks_.begin(), masks_.end(), hit);
+        if (iter != masks_.end()) {
+            masks_.splice(masks_.begin(), masks_, iter);
+            return masks_.front();
+        }
+    }
+
+    // built unlocked, racing queries may build the same mask twice
+    auto mask = std::make_shared<const TimestampMask>(
+        TimestampIndex::BuildMask(query_timestamp, active_range, timestamps));
+    std::lock_guard lck(mutex_);
+    masks_.push_front(mask);
+    while (masks_.size() > capacity_) {
+        masks_.pop_back();
+    }
+    return mask;
+}
+
+void
+TimestampMaskCache::clear() {
+    std::lock_guard lck(mutex_);
+    masks_.clear();
 }
 
 std::vector<int64_t>
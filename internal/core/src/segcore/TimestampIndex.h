@@ -11,11 +11,25 @@
 
 #pragma once
 #include <common/Schema.h>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
-#include <boost/dynamic_bitset.hpp>
 #include <utility>
+#include "common/Bitmap.h"
 
 namespace milvus::segcore {
+// visibility of the undecided rows of one query, bit i covers row aligned_begin + i, set means visible.
+// every query timestamp in [lower, upper) sees the same rows of the slice
+struct TimestampMask {
+    int64_t begin = 0;
+    int64_t end = 0;
+    int64_t aligned_begin = 0;
+    Timestamp lower = 0;
+    Timestamp upper = 0;
+    Bitmap visible;
+};
+
 class TimestampIndex {
  public:
     void
@@ -31,11 +45,14 @@ class TimestampIndex {
     std::pair<int64_t, int64_t>
     get_active_range(Timestamp query_timestamp) const;
 
-    static boost::dynamic_bitset<>
-    GenerateBitset(Timestamp query_timestamp,
-                   std::pair<int64_t, int64_t> active_range,
-                   const Timestamp* timestamps,
-                   int64_t size);
+    // compare the undecided slice against query_timestamp, 64 rows per word
+    static TimestampMask
+    BuildMask(Timestamp query_timestamp, std::pair<int64_t, int64_t> active_range, const Timestamp* timestamps);
+
+    // clear the rows of bitmap in the mask's slice that are not visible, in place.
+    // rows past the slice are left alone, callers cut them off by the active count
+    static void
+    ApplyMask(const TimestampMask& mask, Bitmap& bitmap);
 
  private:
     // numSlice
@@ -49,6 +66,25 @@ class TimestampIndex {
     std::vector<Timestamp> timestamp_barriers_;
 };
 
+// the last few masks of one segment, time travel queries tend to repeat the same timestamps
+class TimestampMaskCache {
+ public:
+    explicit TimestampMaskCache(int64_t capacity = 8) : capacity_(capacity) {
+    }
+
+    std::shared_ptr<const TimestampMask>
+    Get(Timestamp query_timestamp, std::pair<int64_t, int64_t> active_range, const Timestamp* timestamps);
+
+    void
+    clear();
+
+ private:
+    int64_t capacity_;
+    std::mutex mutex_;
+    // most recently used first
+    std::list<std::shared_ptr<const TimestampMask>> masks_;
+};
+
 std::vector<int64_t>
 GenerateFakeSlices(const Timestamp* timestamps, int64_t size, int min_slice_length = 1);
 
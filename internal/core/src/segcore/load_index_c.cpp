@@ -12,6 +12,7 @@
 #include "index/knowhere/knowhere/common/BinarySet.h"
 #include "index/knowhere/knowhere/index/vector_index/VecIndexFactory.h"
 #include "segcore/load_index_c.h"
+#include "common/FieldBuffer.h"
 #include "common/LoadInfo.h"
 #include "exceptions/EasyAssert.h"
 
@@ -150,3 +151,30 @@ AppendBinaryIndex(CBinarySet c_binary_set, void* index_binary, int64_t index_siz
         return status;
     }
 }
+
+CStatus
+AppendBinaryIndexFile(
+    CBinarySet c_binary_set, const char* file_path, int64_t offset, int64_t index_size, const char* c_index_key) {
+    try {
+        auto binary_set = (milvus::knowhere::BinarySet*)c_binary_set;
+        std::string index_key(c_index_key);
+        auto mapped = std::make_shared<milvus::FieldBuffer>(
+            milvus::FieldBuffer::Map(file_path, offset, index_size, milvus::AccessPattern::RANDOM));
+        auto binary = std::make_shared<milvus::knowhere::Binary>();
+        // the binary shares ownership of the mapping, which lives as long as whatever index points into it
+        binary->data = std::shared_ptr<uint8_t[]>(mapped, (uint8_t*)mapped->data());
+        binary->size = index_size;
+        binary->owned = true;
+        binary_set->Append(index_key, binary);
+
+        auto status = CStatus();
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        auto status = CStatus();
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
@@ -47,6 +47,12 @@ DeleteBinarySet(CBinarySet c_binary_set);
 CStatus
 AppendBinaryIndex(CBinarySet c_binary_set, void* index_binary, int64_t index_size, const char* c_index_key);
 
+// maps [offset, offset + index_size) of the file instead of taking a buffer,
+// the loaded index points into the mapping rather than copying it
+CStatus
+AppendBinaryIndexFile(
+    CBinarySet c_binary_set, const char* file_path, int64_t offset, int64_t index_size, const char* c_index_key);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <vector>
+#include <algorithm>
+#include <numeric>
 #include <exceptions/EasyAssert.h>
 #include "segcore/reduce_c.h"
 
@@ -53,10 +55,11 @@ struct SearchResultPair {
     float distance_;
     SearchResult* search_result_;
     int64_t offset_;
+    int64_t offset_rb_;  // right bound of this query's hits in search_result_
     int64_t index_;
 
-    SearchResultPair(float distance, SearchResult* search_result, int64_t offset, int64_t index)
-        : distance_(distance), search_result_(search_result), offset_(offset), index_(index) {
+    SearchResultPair(float distance, SearchResult* search_result, int64_t offset, int64_t offset_rb, int64_t index)
+        : distance_(distance), search_result_(search_result), offset_(offset), offset_rb_(offset_rb), index_(index) {
     }
 
     bool
@@ -69,37 +72,119 @@ struct SearchResultPair {
         return (distance_ > pair.distance_);
     }
 
+    bool
+    has_next() const {
+        return offset_ + 1 < offset_rb_;
+    }
+
     void
-    reset_distance() {
+    advance() {
+        ++offset_;
         distance_ = search_result_->result_distances_[offset_];
     }
 };
 
+// heap order: the pair that must be popped first sits at the front,
+// ties are broken by segment index to keep the merge deterministic.
+// Search in segment_c.cpp negates every non-IP distance, so on this path larger is always better
+struct SearchResultPairWorse {
+    bool
+    operator()(const SearchResultPair& lhs, const SearchResultPair& rhs) const {
+        if (lhs.distance_ != rhs.distance_) {
+            return lhs < rhs;
+        }
+        return lhs.index_ > rhs.index_;
+    }
+};
+
+// k-way merge of one query's hits, every segment's hits are already sorted,
+// so only the head of each segment is kept in the heap and refilled after each pop.
+// returns the number of hits selected, at most topk
+int64_t
+GetResultData(std::vector<SearchResult*>& search_results,
+              int64_t query_index,
+              int64_t topk,
+              int32_t* selected_segments,
+              int64_t* selected_offsets) {
+    auto num_segments = search_results.size();
+    std::vector<SearchResultPair> heap;
+    heap.reserve(num_segments);
+    for (int j = 0; j < num_segments; ++j) {
+        auto search_result = search_results[j];
+        auto offset = search_result->get_query_offset(query_index);
+        auto offset_rb = search_result->get_query_offset(query_index + 1);
+        if (offset < offset_rb) {
+            auto distance = search_result->result_distances_[offset];
+            heap.emplace_back(distance, search_result, offset, offset_rb, j);
+        }
+    }
+
+    SearchResultPairWorse cmp;
+    std::make_heap(heap.begin(), heap.end(), cmp);
+    // knn results hold topk hits per query in every segment, only range results may drain the heap first
+    int64_t count = 0;
+    for (; count < topk && !heap.empty(); ++count) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        auto& result_pair = heap.back();
+        selected_segments[count] = result_pair.index_;
+        selected_offsets[count] = result_pair.offset_;
+        if (result_pair.has_next()) {
+            result_pair.advance();
+            std::push_heap(heap.begin(), heap.end(), cmp);
+        } else {
+            heap.pop_back();
+        }
+    }
+    return count;
+}
+
 void
 GetResultData(std::vector<std::vector<int64_t>>& search_records,
               std::vector<SearchResult*>& search_results,
-              int64_t query_offset,
+              int64_t num_queries,
               bool* is_selected,
               int64_t topk) {
-    auto num_segments = search_results.size();
-    AssertInfo(num_segments > 0, "num segment must greater than 0");
-    std::vector<SearchResultPair> result_pairs;
-    for (int j = 0; j < num_segments; ++j) {
-        auto distance = search_results[j]->result_distances_[query_offset];
-        auto search_result = search_results[j];
+    AssertInfo(topk > 0, "topK must greater than 0");
+    AssertInfo(!search_results.empty(), "num segment must greater than 0");
+    for (auto search_result : search_results) {
         AssertInfo(search_result != nullptr, "search result must not equal to nullptr");
-        result_pairs.push_back(SearchResultPair(distance, search_result, query_offset, j));
     }
-    int64_t loc_offset = query_offset;
-    AssertInfo(topk > 0, "topK must greater than 0");
-    for (int i = 0; i < topk; ++i) {
-        result_pairs[0].reset_distance();
-        std::sort(result_pairs.begin(), result_pairs.end(), std::greater<>());
-        auto& result_pair = result_pairs[0];
-        auto index = result_pair.index_;
-        is_selected[index] = true;
-        result_pair.search_result_->result_offsets_.push_back(loc_offset++);
-        search_records[index].push_back(result_pair.offset_++);
+    auto num_segments = search_results.size();
+    auto is_range = !search_results[0]->result_lims_.empty();
+    auto max_count = num_queries * topk;
+    std::vector<int32_t> selected_segments(max_count);
+    std::vector<int64_t> selected_offsets(max_count);
+    std::vector<int64_t> selected_counts(num_queries);
+
+#pragma omp parallel for
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query_offset = q * topk;
+        selected_counts[q] = GetResultData(search_results, q, topk, selected_segments.data() + query_offset,
+                                           selected_offsets.data() + query_offset);
+    }
+
+    // scatter in query order, so result_offsets_ and search_records stay aligned per segment.
+    // range results also get their lims rebuilt to describe the hits each segment keeps
+    std::vector<std::vector<int64_t>> reduced_lims(is_range ? num_segments : 0);
+    for (auto& lims : reduced_lims) {
+        lims.resize(num_queries + 1, 0);
+    }
+    int64_t loc = 0;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        for (int64_t i = 0; i < selected_counts[q]; ++i) {
+            auto index = selected_segments[q * topk + i];
+            is_selected[index] = true;
+            search_results[index]->result_offsets_.push_back(loc++);
+            search_records[index].push_back(selected_offsets[q * topk + i]);
+            if (is_range) {
+                ++reduced_lims[index][q + 1];
+            }
+        }
+    }
+    for (int i = 0; i < reduced_lims.size(); ++i) {
+        auto& lims = reduced_lims[i];
+        std::partial_sum(lims.begin(), lims.end(), lims.begin());
+        search_results[i]->result_lims_ = std::move(lims);
     }
 }
 
@@ -143,11 +228,7 @@ ReduceQueryResults(CQueryResult* c_search_results, int64_t num_segments, bool* i
         auto num_queries = search_results[0]->num_queries_;
         std::vector<std::vector<int64_t>> search_records(num_segments);
 
-        int64_t query_offset = 0;
-        for (int j = 0; j < num_queries; ++j) {
-            GetResultData(search_records, search_results, query_offset, is_selected, topk);
-            query_offset += topk;
-        }
+        GetResultData(search_records, search_results, num_queries, is_selected, topk);
         ResetSearchResult(search_records, search_results, is_selected);
         auto status = CStatus();
         status.error_code = Success;
@@ -180,10 +261,32 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
             total_num_queries += num_queries;
         }
 
-        std::vector<float> result_distances(total_num_queries * topk);
-        std::vector<int64_t> result_ids(total_num_queries * topk);
-        std::vector<std::vector<char>> row_datas(total_num_queries * topk);
-        std::vector<char> temp_ids;
+        // hits of query q sit at [query_lims[q], query_lims[q + 1]), topk of them unless it's a range search
+        std::vector<int64_t> query_lims(total_num_queries + 1);
+        auto first_result = (SearchResult*)c_search_results[0];
+        if (first_result->result_lims_.empty()) {
+            for (int64_t q = 0; q <= total_num_queries; ++q) {
+                query_lims[q] = q * topk;
+            }
+        } else {
+            for (int i = 0; i < num_segments; i++) {
+                if (is_selected[i] == false) {
+                    continue;
+                }
+                auto& lims = ((SearchResult*)c_search_results[i])->result_lims_;
+                for (int64_t q = 0; q < total_num_queries; ++q) {
+                    query_lims[q + 1] += lims[q + 1] - lims[q];
+                }
+            }
+            std::partial_sum(query_lims.begin(), query_lims.end(), query_lims.begin());
+        }
+        auto total_num_hits = query_lims.back();
+
+        std::vector<float> result_distances(total_num_hits);
+        std::vector<int64_t> result_ids(total_num_hits);
+        // rows stay in the segments' arenas, only pointers are reordered
+        std::vector<const char*> row_datas(total_num_hits);
+        int64_t row_data_sizeof = -1;
 
         std::vector<int64_t> counts(num_segments);
         for (int i = 0; i < num_segments; i++) {
@@ -193,12 +296,18 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
             auto search_result = (SearchResult*)c_search_results[i];
             AssertInfo(search_result != nullptr, "search result must not equal to nullptr");
             auto size = search_result->result_offsets_.size();
+            if (size == 0) {
+                continue;
+            }
+            AssertInfo(row_data_sizeof == -1 || row_data_sizeof == search_result->row_data_sizeof_,
+                       "segments filled different target entries");
+            row_data_sizeof = search_result->row_data_sizeof_;
 #pragma omp parallel for
             for (int j = 0; j < size; j++) {
                 auto loc = search_result->result_offsets_[j];
                 result_distances[loc] = search_result->result_distances_[j];
-                row_datas[loc] = search_result->row_data_[j];
-                memcpy(&result_ids[loc], search_result->row_data_[j].data(), sizeof(int64_t));
+                row_datas[loc] = search_result->get_row_data(j);
+                memcpy(&result_ids[loc], row_datas[loc], sizeof(int64_t));
             }
             counts[i] = size;
         }
@@ -207,10 +316,9 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
         for (int i = 0; i < num_segments; i++) {
             total_count += counts[i];
         }
-        AssertInfo(total_count == total_num_queries * topk,
-                   "the reduces result's size less than total_num_queries*topk");
+        AssertInfo(total_count == total_num_hits, "the reduces result's size less than the hits of all queries");
 
-        int64_t last_offset = 0;
+        int64_t last_query = 0;
         for (int i = 0; i < num_groups; i++) {
             MarshaledHitsPeerGroup& hits_peer_group = (*marshaledHits).marshaled_hits_[i];
             hits_peer_group.hits_.resize(num_queries_peer_group[i]);
@@ -218,15 +326,15 @@ ReorganizeQueryResults(CMarshaledHits* c_marshaled_hits,
             std::vector<milvus::proto::milvus::Hits> hits(num_queries_peer_group[i]);
 #pragma omp parallel for
             for (int m = 0; m < num_queries_peer_group[i]; m++) {
-                for (int n = 0; n < topk; n++) {
-                    int64_t result_offset = last_offset + m * topk + n;
+                auto query_index = last_query + m;
+                for (auto result_offset = query_lims[query_index]; result_offset < query_lims[query_index + 1];
+                     result_offset++) {
                     hits[m].add_ids(result_ids[result_offset]);
                     hits[m].add_scores(result_distances[result_offset]);
-                    auto& row_data = row_datas[result_offset];
-                    hits[m].add_row_data(row_data.data(), row_data.size());
+                    hits[m].add_row_data(row_datas[result_offset], row_data_sizeof);
                 }
             }
-            last_offset = last_offset + num_queries_peer_group[i] * topk;
+            last_query = last_query + num_queries_peer_group[i];
 
 #pragma omp parallel for
             for (int j = 0; j < num_queries_peer_group[i]; j++) {
@@ -260,7 +368,6 @@ ReorganizeSingleQueryResult(CMarshaledHits* c_marshaled_hits,
     try {
         auto marshaledHits = std::make_unique<MarshaledHits>(num_groups);
         auto search_result = (SearchResult*)c_search_result;
-        auto topk = GetTopK(c_plan);
         std::vector<int64_t> num_queries_peer_group;
         int64_t total_num_queries = 0;
         for (int i = 0; i < num_groups; i++) {
@@ -268,7 +375,7 @@ ReorganizeSingleQueryResult(CMarshaledHits* c_marshaled_hits,
             num_queries_peer_group.push_back(num_queries);
         }
 
-        int64_t last_offset = 0;
+        int64_t last_query = 0;
         for (int i = 0; i < num_groups; i++) {
             MarshaledHitsPeerGroup& hits_peer_group = (*marshaledHits).marshaled_hits_[i];
             hits_peer_group.hits_.resize(num_queries_peer_group[i]);
@@ -276,17 +383,18 @@ ReorganizeSingleQueryResult(CMarshaledHits* c_marshaled_hits,
             std::vector<milvus::proto::milvus::Hits> hits(num_queries_peer_group[i]);
 #pragma omp parallel for
             for (int m = 0; m < num_queries_peer_group[i]; m++) {
-                for (int n = 0; n < topk; n++) {
-                    int64_t result_offset = last_offset + m * topk + n;
+                auto begin = search_result->get_query_offset(last_query + m);
+                auto end = search_result->get_query_offset(last_query + m + 1);
+                for (auto result_offset = begin; result_offset < end; result_offset++) {
                     hits[m].add_scores(search_result->result_distances_[result_offset]);
-                    auto& row_data = search_result->row_data_[result_offset];
-                    hits[m].add_row_data(row_data.data(), row_data.size());
+                    auto row_data = search_result->get_row_data(result_offset);
+                    hits[m].add_row_data(row_data, search_result->row_data_sizeof_);
                     int64_t result_id;
-                    memcpy(&result_id, row_data.data(), sizeof(int64_t));
+                    memcpy(&result_id, row_data, sizeof(int64_t));
                     hits[m].add_ids(result_id);
                 }
             }
-            last_offset = last_offset + num_queries_peer_group[i] * topk;
+            last_query = last_query + num_queries_peer_group[i];
 
 #pragma omp parallel for
             for (int j = 0; j < num_queries_peer_group[i]; j++) {
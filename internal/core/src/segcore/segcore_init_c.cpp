@@ -12,6 +12,9 @@
 #include "index/thirdparty/faiss/FaissHook.h"
 #include "segcore/segcore_init_c.h"
 #include "knowhere/archive/KnowhereConfig.h"
+#include "segcore/IndexBuildScheduler.h"
+#include "segcore/LoadScheduler.h"
+#include "segcore/SearchCoalescer.h"
 #include <iostream>
 #include "utils/Log.h"
 
@@ -26,6 +29,11 @@ SegcoreInitImpl() {
     eg::KnowhereConfig::SetStatisticsLevel(0);
     el::Configurations el_conf;
     el_conf.setGlobally(el::ConfigurationType::Enabled, std::to_string(false));
+
+    // join concurrent searches only while one of their kind is already running, an idle segment adds no latency
+    constexpr int64_t search_coalesce_window_us = 0;
+    constexpr int64_t search_coalesce_max_queries = 1024;
+    SearchCoalescer::Instance().Configure(search_coalesce_window_us, search_coalesce_max_queries);
 }
 }  // namespace milvus::segcore
 
@@ -33,3 +41,13 @@ extern "C" void
 SegcoreInit() {
     milvus::segcore::SegcoreInitImpl();
 }
+
+extern "C" void
+SegcoreSetIndexBuildPool(int64_t concurrency, int64_t queue_capacity) {
+    milvus::segcore::IndexBuildScheduler::Instance().Configure(concurrency, queue_capacity);
+}
+
+extern "C" void
+SegcoreSetLoadPool(int64_t concurrency, int64_t queue_capacity) {
+    milvus::segcore::LoadScheduler::Instance().Configure(concurrency, queue_capacity);
+}
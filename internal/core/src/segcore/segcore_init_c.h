@@ -12,9 +12,21 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 void
 SegcoreInit();
 
+// builds small indexes of growing segments on concurrency threads, 0 builds them on the inserting thread.
+// inserts block once queue_capacity builds are pending
+void
+SegcoreSetIndexBuildPool(int64_t concurrency, int64_t queue_capacity);
+
+// loads fields of sealed segments on concurrency threads, 0 loads them on the calling thread.
+// loads block once queue_capacity of them are pending
+void
+SegcoreSetLoadPool(int64_t concurrency, int64_t queue_capacity);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,10 +10,14 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <cstring>
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <memory>
 
 #include "segcore/SegmentGrowing.h"
 #include "segcore/SegmentSealed.h"
+#include "segcore/SearchCoalescer.h"
 #include "segcore/Collection.h"
 #include "segcore/segment_c.h"
 #include "common/LoadInfo.h"
@@ -75,7 +79,13 @@ Search(CSegmentInterface c_segment,
         auto segment = (milvus::segcore::SegmentInterface*)c_segment;
         auto plan = (milvus::query::Plan*)c_plan;
         auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(c_placeholder_group);
-        *query_result = segment->Search(plan, *phg_ptr, timestamp);
+        auto internal_segment = dynamic_cast<const milvus::segcore::SegmentInternalInterface*>(segment);
+        if (internal_segment != nullptr) {
+            auto& coalescer = milvus::segcore::SearchCoalescer::Instance();
+            *query_result = coalescer.Search(*internal_segment, plan, *phg_ptr, timestamp);
+        } else {
+            *query_result = segment->Search(plan, *phg_ptr, timestamp);
+        }
         if (plan->plan_node_->query_info_.metric_type_ != milvus::MetricType::METRIC_INNER_PRODUCT) {
             for (auto& dis : query_result->result_distances_) {
                 dis *= -1;
@@ -124,6 +134,13 @@ GetDeletedCount(CSegmentInterface c_segment) {
     return deleted_count;
 }
 
+int64_t
+GetSmallIndexLag(CSegmentInterface c_segment) {
+    auto segment = (milvus::segcore::SegmentGrowing*)c_segment;
+    auto lag = segment->get_small_index_lag();
+    return lag;
+}
+
 //////////////////////////////    interfaces for growing segment    //////////////////////////////
 CStatus
 Insert(CSegmentInterface c_segment,
@@ -183,15 +200,56 @@ PreDelete(CSegmentInterface c_segment, int64_t size) {
 }
 
 //////////////////////////////    interfaces for sealed segment    //////////////////////////////
+static LoadFieldDataInfo
+ToLoadFieldDataInfo(const CLoadFieldDataInfo& load_field_data_info) {
+    auto load_info =
+        LoadFieldDataInfo{load_field_data_info.field_id, load_field_data_info.blob, load_field_data_info.row_count};
+    if (load_field_data_info.file_path != nullptr) {
+        load_info.file_path = load_field_data_info.file_path;
+        load_info.file_offset = load_field_data_info.file_offset;
+        load_info.access_pattern = static_cast<milvus::AccessPattern>(load_field_data_info.access_pattern);
+    }
+    return load_info;
+}
+
 CStatus
 LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_info) {
     try {
         auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
         auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
         AssertInfo(segment != nullptr, "segment conversion failed");
-        auto load_info =
-            LoadFieldDataInfo{load_field_data_info.field_id, load_field_data_info.blob, load_field_data_info.row_count};
-        segment->LoadFieldData(load_info);
+        segment->LoadFieldData(ToLoadFieldDataInfo(load_field_data_info));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+LoadFieldDataAsync(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_info, CLoadFuture* c_future) {
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto future = segment->LoadFieldDataAsync(ToLoadFieldDataInfo(load_field_data_info));
+        *c_future = new std::future<void>(std::move(future));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+bool
+IsLoadFieldDataReady(CLoadFuture c_future) {
+    auto future = static_cast<std::future<void>*>(c_future);
+    return future->wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+CStatus
+WaitLoadFieldData(CLoadFuture c_future) {
+    std::unique_ptr<std::future<void>> future(static_cast<std::future<void>*>(c_future));
+    try {
+        future->get();
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(UnexpectedError, e.what());
@@ -25,6 +25,7 @@ extern "C" {
 
 typedef void* CSegmentInterface;
 typedef void* CQueryResult;
+typedef void* CLoadFuture;
 
 //////////////////////////////    common interfaces    //////////////////////////////
 CSegmentInterface
@@ -58,6 +59,9 @@ GetRowCount(CSegmentInterface c_segment);
 int64_t
 GetDeletedCount(CSegmentInterface c_segment);
 
+int64_t
+GetSmallIndexLag(CSegmentInterface c_segment);
+
 //////////////////////////////    interfaces for growing segment    //////////////////////////////
 CStatus
 Insert(CSegmentInterface c_segment,
@@ -86,6 +90,17 @@ PreDelete(CSegmentInterface c_segment, int64_t size);
 CStatus
 LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_info);
 
+// starts loading on the segcore load pool, the blob must stay valid until WaitLoadFieldData returns
+CStatus
+LoadFieldDataAsync(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_info, CLoadFuture* c_future);
+
+bool
+IsLoadFieldDataReady(CLoadFuture c_future);
+
+// blocks until the load finished, reports its status and releases the future
+CStatus
+WaitLoadFieldData(CLoadFuture c_future);
+
 CStatus
 UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_index_info);
 
@@ -10,6 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <faiss/FaissHook.h>
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/distances_avx.h>
+#include <faiss/utils/distances_avx512.h>
 #include "test_utils/DataGen.h"
 
 using namespace milvus;
@@ -29,3 +35,42 @@ TEST(Binary, Insert) {
     segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
     int i = 1 + 1;
 }
+
+TEST(Binary, SimdKernels) {
+    std::default_random_engine e(42);
+    // sizes around every block boundary of the kernels, up to 4096 bits
+    for (size_t code_size = 1; code_size <= 512 + 40; ++code_size) {
+        std::vector<uint8_t> a(code_size), b(code_size);
+        for (size_t i = 0; i < code_size; ++i) {
+            a[i] = e();
+            b[i] = e();
+        }
+        // b is a superset of sub
+        std::vector<uint8_t> sub(code_size);
+        for (size_t i = 0; i < code_size; ++i) {
+            sub[i] = b[i] & e();
+        }
+
+        auto hamming = faiss::xor_popcnt(a.data(), b.data(), code_size);
+        auto jaccard = faiss::bvec_jaccard(a.data(), b.data(), code_size);
+        if (faiss::support_avx2()) {
+            ASSERT_EQ(faiss::xor_popcnt_AVX2_lookup(a.data(), b.data(), code_size), hamming) << code_size;
+            ASSERT_FLOAT_EQ(faiss::jaccard_AVX2_lookup(a.data(), b.data(), code_size), jaccard) << code_size;
+            ASSERT_TRUE(faiss::is_subset_AVX2(sub.data(), b.data(), code_size));
+            ASSERT_EQ(faiss::is_subset_AVX2(a.data(), b.data(), code_size),
+                      faiss::is_subset(a.data(), b.data(), code_size));
+        }
+        if (faiss::support_avx512()) {
+            ASSERT_TRUE(faiss::is_subset_AVX512(sub.data(), b.data(), code_size));
+            ASSERT_EQ(faiss::is_subset_AVX512(a.data(), b.data(), code_size),
+                      faiss::is_subset(a.data(), b.data(), code_size));
+        }
+        if (faiss::support_avx512_vpopcntdq()) {
+            ASSERT_EQ(faiss::xor_popcnt_AVX512VPOPCNTDQ(a.data(), b.data(), code_size), hamming) << code_size;
+            ASSERT_FLOAT_EQ(faiss::jaccard_AVX512VPOPCNTDQ(a.data(), b.data(), code_size), jaccard) << code_size;
+        }
+        ASSERT_EQ(faiss::bvec_hamming(a.data(), b.data(), code_size), hamming);
+        ASSERT_FLOAT_EQ(faiss::bvec_jaccard_dis(a.data(), b.data(), code_size), jaccard);
+        ASSERT_TRUE(faiss::bvec_is_subset(sub.data(), b.data(), code_size));
+    }
+}
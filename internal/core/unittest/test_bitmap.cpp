@@ -12,6 +12,10 @@
 #include <gtest/gtest.h>
 #include "test_utils/DataGen.h"
 #include "knowhere/index/structured_index_simple/StructuredIndexSort.h"
+#include "common/Bitmap.h"
+#include "utils/tools.h"
+#include <boost/dynamic_bitset.hpp>
+#include <random>
 
 TEST(Bitmap, Naive) {
     using namespace milvus;
@@ -34,4 +38,91 @@ TEST(Bitmap, Naive) {
         double count = res->count();
         ASSERT_NEAR(count / N, 0.682, 0.01);
     }
-}
\ No newline at end of file
+}
+TEST(Bitmap, WordOps) {
+    using namespace milvus;
+    int64_t N = 1000;
+    std::default_random_engine e(42);
+    Bitmap a(N);
+    Bitmap b(N);
+    boost::dynamic_bitset<> ref_a(N);
+    boost::dynamic_bitset<> ref_b(N);
+    for (int64_t i = 0; i < N; ++i) {
+        bool x = e() % 2;
+        bool y = e() % 3 == 0;
+        a.set(i, x);
+        b.set(i, y);
+        ref_a[i] = x;
+        ref_b[i] = y;
+    }
+    auto check = [&](const Bitmap& bitmap, const boost::dynamic_bitset<>& ref) {
+        ASSERT_EQ(bitmap.size(), ref.size());
+        ASSERT_EQ(bitmap.count(), ref.count());
+        for (int64_t i = 0; i < N; ++i) {
+            ASSERT_EQ(bitmap[i], ref[i]) << i;
+        }
+    };
+    check(a, ref_a);
+
+    auto c = a;
+    c &= b;
+    check(c, ref_a & ref_b);
+    c = a;
+    c |= b;
+    check(c, ref_a | ref_b);
+    c = a;
+    c ^= b;
+    check(c, ref_a ^ ref_b);
+    c = a;
+    c -= b;
+    check(c, ref_a - ref_b);
+    c = a;
+    c.flip();
+    check(c, ~ref_a);
+
+    // the view is what the vector search sees
+    auto view = c.view();
+    ASSERT_EQ(view.size(), N);
+    ASSERT_EQ(view.count_1(), (~ref_a).count());
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(view.test(i), !ref_a[i]);
+    }
+}
+
+TEST(Bitmap, FillAndCopy) {
+    using namespace milvus;
+    int64_t N = 517;
+    std::default_random_engine e(42);
+    std::vector<uint64_t> src(upper_div(N, 64));
+    for (auto& word : src) {
+        word = (uint64_t(e()) << 32) | e();
+    }
+    auto src_bit = [&](int64_t i) -> bool { return (src[i / 64] >> (i % 64)) & 1; };
+
+    for (int64_t offset : {0, 1, 63, 64, 100}) {
+        for (int64_t size : {0, 1, 64, 65, 400}) {
+            Bitmap bitmap(N, true);
+            bitmap.copy_from(offset, src.data(), size);
+            for (int64_t i = 0; i < N; ++i) {
+                bool expected = (offset <= i && i < offset + size) ? src_bit(i - offset) : true;
+                ASSERT_EQ(bitmap[i], expected) << offset << " " << size << " " << i;
+            }
+        }
+    }
+
+    for (auto [begin, end] : std::vector<std::pair<int64_t, int64_t>>{{0, N}, {3, 5}, {10, 200}, {64, 128}, {N, N}}) {
+        Bitmap bitmap(N);
+        bitmap.fill(begin, end, true);
+        ASSERT_EQ(bitmap.count(), end - begin);
+        ASSERT_EQ(bitmap.any(0, N), begin != end);
+        ASSERT_TRUE(bitmap.all(begin, end));
+        ASSERT_FALSE(bitmap.any(0, begin));
+        ASSERT_FALSE(bitmap.any(end, N));
+        ASSERT_EQ(bitmap.all(0, N), begin == 0 && end == N);
+        for (int64_t i = 0; i < N; ++i) {
+            ASSERT_EQ(bitmap[i], begin <= i && i < end) << i;
+        }
+        bitmap.fill(0, N, false);
+        ASSERT_EQ(bitmap.count(), 0);
+    }
+}
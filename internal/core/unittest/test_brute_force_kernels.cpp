@@ -0,0 +1,169 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <faiss/FaissHook.h>
+#include <faiss/utils/ConcurrentBitset.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "query/BruteForceKernels.h"
+#include "query/BruteForceKernelsImpl.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+namespace {
+std::vector<float>
+GenVectors(int64_t n, int64_t dim, int seed) {
+    std::default_random_engine e(seed);
+    std::normal_distribution<float> dist(0, 1);
+    std::vector<float> data(n * dim);
+    for (auto& x : data) {
+        x = dist(e);
+    }
+    return data;
+}
+
+float
+Distance(const float* x, const float* y, int64_t dim, bool is_ip) {
+    float result = 0;
+    for (int64_t d = 0; d < dim; ++d) {
+        result += is_ip ? x[d] * y[d] : (x[d] - y[d]) * (x[d] - y[d]);
+    }
+    return result;
+}
+
+// compares against a full sort, distances may differ in the last bits so labels are checked through them
+void
+CheckKnn(const std::vector<float>& queries,
+         int64_t num_queries,
+         const std::vector<float>& base,
+         int64_t num_rows,
+         int64_t dim,
+         int64_t topk,
+         const faiss::BitsetView& bitset,
+         bool is_ip) {
+    std::vector<float> values(num_queries * topk);
+    std::vector<int64_t> labels(num_queries * topk);
+    if (is_ip) {
+        KnnIPBlocked(queries.data(), num_queries, base.data(), num_rows, dim, topk, bitset, values.data(),
+                     labels.data());
+    } else {
+        KnnL2Blocked(queries.data(), num_queries, base.data(), num_rows, dim, topk, bitset, values.data(),
+                     labels.data());
+    }
+
+    for (int64_t q = 0; q < num_queries; ++q) {
+        std::vector<float> expected;
+        for (int64_t i = 0; i < num_rows; ++i) {
+            if (!bitset.empty() && bitset.test(i)) {
+                continue;
+            }
+            expected.push_back(Distance(queries.data() + q * dim, base.data() + i * dim, dim, is_ip));
+        }
+        if (is_ip) {
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+        } else {
+            std::sort(expected.begin(), expected.end());
+        }
+        for (int64_t k = 0; k < topk; ++k) {
+            auto offset = q * topk + k;
+            if (k >= expected.size()) {
+                ASSERT_EQ(labels[offset], -1);
+                continue;
+            }
+            auto label = labels[offset];
+            ASSERT_GE(label, 0);
+            ASSERT_LT(label, num_rows);
+            ASSERT_TRUE(bitset.empty() || !bitset.test(label));
+            auto dis = Distance(queries.data() + q * dim, base.data() + label * dim, dim, is_ip);
+            ASSERT_NEAR(values[offset], dis, 1e-3);
+            ASSERT_NEAR(values[offset], expected[k], 1e-3);
+        }
+    }
+}
+}  // namespace
+
+TEST(BruteForceKernels, Tiles) {
+    constexpr int64_t dim = 19;
+    auto rows = GenVectors(simd::TileRows, dim, 1);
+    auto queries = GenVectors(simd::TileQueries, dim, 2);
+    std::vector<float> rows_t(dim * simd::TileRows);
+    for (int64_t j = 0; j < simd::TileRows; ++j) {
+        for (int64_t d = 0; d < dim; ++d) {
+            rows_t[d * simd::TileRows + j] = rows[j * dim + d];
+        }
+    }
+
+    std::vector<float> out(simd::TileQueries * simd::TileRows);
+    auto check = [&](bool is_ip) {
+        for (int64_t q = 0; q < simd::TileQueries; ++q) {
+            for (int64_t j = 0; j < simd::TileRows; ++j) {
+                auto expected = Distance(queries.data() + q * dim, rows.data() + j * dim, dim, is_ip);
+                ASSERT_NEAR(out[q * simd::TileRows + j], expected, 1e-4);
+            }
+        }
+    };
+    if (faiss::support_avx2()) {
+        simd::l2_tile_avx2(rows_t.data(), queries.data(), dim, out.data());
+        check(false);
+        simd::ip_tile_avx2(rows_t.data(), queries.data(), dim, out.data());
+        check(true);
+    }
+    if (faiss::support_avx512()) {
+        simd::l2_tile_avx512(rows_t.data(), queries.data(), dim, out.data());
+        check(false);
+        simd::ip_tile_avx512(rows_t.data(), queries.data(), dim, out.data());
+        check(true);
+    }
+}
+
+TEST(BruteForceKernels, Knn) {
+    constexpr int64_t dim = 16;
+    constexpr int64_t num_queries = 5;  // one full and one partial tile of queries
+    constexpr int64_t N = 1000;         // ragged last block
+    auto base = GenVectors(N, dim, 3);
+    auto queries = GenVectors(num_queries, dim, 4);
+
+    faiss::ConcurrentBitset bitset(N);
+    std::default_random_engine e(5);
+    for (int64_t i = 0; i < N; ++i) {
+        // words 2 and 3 are filtered out entirely, the rest at random
+        if ((i >= 128 && i < 256) || e() % 3 == 0) {
+            bitset.set(i);
+        }
+    }
+
+    for (bool is_ip : {false, true}) {
+        CheckKnn(queries, num_queries, base, N, dim, 10, faiss::BitsetView(), is_ip);
+        CheckKnn(queries, num_queries, base, N, dim, 10, faiss::BitsetView(bitset), is_ip);
+        // fewer rows than topk, the missing entries are labeled -1
+        CheckKnn(queries, num_queries, base, 7, dim, 10, faiss::BitsetView(bitset), is_ip);
+    }
+}
+
+TEST(BruteForceKernels, KnnParallel) {
+    constexpr int64_t dim = 8;
+    constexpr int64_t num_queries = 3;
+    constexpr int64_t N = 100000;
+    auto base = GenVectors(N, dim, 6);
+    auto queries = GenVectors(num_queries, dim, 7);
+
+    faiss::ConcurrentBitset bitset(N);
+    for (int64_t i = 0; i < N / 2; ++i) {
+        bitset.set(i);
+    }
+    for (bool is_ip : {false, true}) {
+        CheckKnn(queries, num_queries, base, N, dim, 20, faiss::BitsetView(bitset), is_ip);
+    }
+}
@@ -9,11 +9,13 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <random>
 #include <gtest/gtest.h>
 #include <chrono>
+#include <thread>
 #include <google/protobuf/text_format.h>
 
 #include "pb/milvus.pb.h"
@@ -663,6 +665,143 @@ TEST(CApiTest, Reduce) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, RangeSearchReduce) {
+    auto collection = NewCollection(get_default_schema_config());
+    int num_segments = 2;
+    int N = 2000;
+    int dim = 16;
+    auto line_sizeof = (sizeof(int) + sizeof(float) * dim);
+    std::default_random_engine e(67);
+    std::vector<CSegmentInterface> segments;
+    std::vector<std::vector<float>> segment_vecs;
+    for (int s = 0; s < num_segments; ++s) {
+        std::vector<char> raw_data;
+        std::vector<uint64_t> timestamps(N, 0);
+        std::vector<int64_t> uids;
+        std::vector<float> vecs;
+        for (int i = 0; i < N; ++i) {
+            uids.push_back(100000 + s * N + i);
+            float vec[16];
+            for (auto& x : vec) {
+                x = e() % 2000 * 0.001 - 1.0;
+            }
+            vecs.insert(vecs.end(), std::begin(vec), std::end(vec));
+            raw_data.insert(raw_data.end(), (const char*)std::begin(vec), (const char*)std::end(vec));
+            int age = e() % 100;
+            raw_data.insert(raw_data.end(), (const char*)&age, ((const char*)&age) + sizeof(age));
+        }
+        auto segment = NewSegment(collection, s, Growing);
+        int64_t offset;
+        PreInsert(segment, N, &offset);
+        auto ins_res = Insert(segment, offset, N, uids.data(), timestamps.data(), raw_data.data(), (int)line_sizeof, N);
+        ASSERT_EQ(ins_res.error_code, Success);
+        segments.push_back(segment);
+        segment_vecs.push_back(std::move(vecs));
+    }
+
+    const char* dsl_string = R"(
+    {
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {
+                        "nprobe": 10,
+                        "range_search_radius": 2.5
+                    },
+                    "query": "$0",
+                    "topk": 10
+                }
+            }
+        }
+    })";
+    float radius = 2.5;
+    int topk = 10;
+
+    // queries are rows of both segments, so every query has close hits on one side only
+    namespace ser = milvus::proto::milvus;
+    int num_queries = 10;
+    std::vector<float> queries;
+    for (int q = 0; q < num_queries; ++q) {
+        auto& vecs = segment_vecs[q % num_segments];
+        queries.insert(queries.end(), vecs.begin() + q * dim, vecs.begin() + (q + 1) * dim);
+    }
+    ser::PlaceholderGroup raw_group;
+    auto value = raw_group.add_placeholders();
+    value->set_tag("$0");
+    value->set_type(ser::PlaceholderType::FloatVector);
+    for (int q = 0; q < num_queries; ++q) {
+        value->add_values(queries.data() + q * dim, dim * sizeof(float));
+    }
+    auto blob = raw_group.SerializeAsString();
+
+    void* plan = nullptr;
+    auto status = CreatePlan(collection, dsl_string, &plan);
+    ASSERT_EQ(status.error_code, Success);
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    std::vector<CQueryResult> results;
+    for (auto segment : segments) {
+        CQueryResult res;
+        status = Search(segment, plan, placeholderGroup, 1, &res);
+        ASSERT_EQ(status.error_code, Success);
+        results.push_back(res);
+    }
+    bool is_selected[2] = {false, false};
+    status = ReduceQueryResults(results.data(), num_segments, is_selected);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto l2 = [&](const float* x, const float* y) {
+        float dis = 0;
+        for (int d = 0; d < dim; ++d) {
+            dis += (x[d] - y[d]) * (x[d] - y[d]);
+        }
+        return dis;
+    };
+    for (int q = 0; q < num_queries; ++q) {
+        auto query = queries.data() + q * dim;
+        // the topk nearest rows within radius over both segments
+        std::vector<float> ref;
+        for (int s = 0; s < num_segments; ++s) {
+            for (int i = 0; i < N; ++i) {
+                auto dis = l2(query, segment_vecs[s].data() + i * dim);
+                if (dis < radius * radius) {
+                    ref.push_back(dis);
+                }
+            }
+        }
+        std::sort(ref.begin(), ref.end());
+        ref.resize(std::min<size_t>(ref.size(), topk));
+        ASSERT_GT(ref.size(), 1);
+
+        // hits kept by the reduce carry negated distances
+        std::vector<float> kept;
+        for (int s = 0; s < num_segments; ++s) {
+            auto result = (QueryResult*)results[s];
+            for (auto i = result->result_lims_[q]; i < result->result_lims_[q + 1]; ++i) {
+                auto row = segment_vecs[s].data() + result->internal_seg_offsets_[i] * dim;
+                ASSERT_NEAR(-result->result_distances_[i], l2(query, row), 1e-4);
+                kept.push_back(-result->result_distances_[i]);
+            }
+        }
+        std::sort(kept.begin(), kept.end());
+        ASSERT_EQ(kept.size(), ref.size());
+        for (int k = 0; k < ref.size(); ++k) {
+            ASSERT_NEAR(kept[k], ref[k], 1e-4);
+        }
+    }
+
+    DeletePlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    for (int s = 0; s < num_segments; ++s) {
+        DeleteQueryResult(results[s]);
+        DeleteSegment(segments[s]);
+    }
+    DeleteCollection(collection);
+}
+
 TEST(CApiTest, ReduceSearchWithExpr) {
     auto collection = NewCollection(get_default_schema_config());
     auto segment = NewSegment(collection, 0, Growing);
@@ -2434,6 +2573,73 @@ TEST(CApiTest, SealedSegmentTest) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SealedSegmentLoadAsyncTest) {
+    auto schema_tmp_conf = R"(name: "test"
+                                autoID: true
+                                fields: <
+                                  fieldID: 100
+                                  name: "vec"
+                                  data_type: FloatVector
+                                  type_params: <
+                                    key: "dim"
+                                    value: "16"
+                                  >
+                                  index_params: <
+                                    key: "metric_type"
+                                    value: "L2"
+                                  >
+                                >
+                                fields: <
+                                  fieldID: 101
+                                  name: "age"
+                                  data_type: Int32
+                                  type_params: <
+                                    key: "dim"
+                                    value: "1"
+                                  >
+                                >)";
+    auto collection = NewCollection(schema_tmp_conf);
+    auto segment = NewSegment(collection, 0, Sealed);
+
+    int N = 10000;
+    std::default_random_engine e(67);
+    auto ages = std::vector<int32_t>(N);
+    for (auto& age : ages) {
+        age = e() % 2000;
+    }
+    auto vecs = std::vector<float>(N * 16);
+    for (auto& v : vecs) {
+        v = e() % 2000 * 0.001;
+    }
+
+    CLoadFuture age_future;
+    auto res = LoadFieldDataAsync(segment, CLoadFieldDataInfo{101, ages.data(), N}, &age_future);
+    ASSERT_EQ(res.error_code, Success);
+    CLoadFuture vec_future;
+    res = LoadFieldDataAsync(segment, CLoadFieldDataInfo{100, vecs.data(), N}, &vec_future);
+    ASSERT_EQ(res.error_code, Success);
+
+    res = WaitLoadFieldData(age_future);
+    ASSERT_EQ(res.error_code, Success);
+    res = WaitLoadFieldData(vec_future);
+    ASSERT_EQ(res.error_code, Success);
+    ASSERT_EQ(GetRowCount(segment), N);
+
+    // the failure of a load is reported by its wait
+    CLoadFuture duplicated_future;
+    res = LoadFieldDataAsync(segment, CLoadFieldDataInfo{101, ages.data(), N}, &duplicated_future);
+    ASSERT_EQ(res.error_code, Success);
+    while (!IsLoadFieldDataReady(duplicated_future)) {
+        std::this_thread::yield();
+    }
+    res = WaitLoadFieldData(duplicated_future);
+    ASSERT_NE(res.error_code, Success);
+    free((char*)res.error_msg);
+
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, SealedSegment_search_float_Predicate_Range) {
     constexpr auto DIM = 16;
     constexpr auto K = 5;
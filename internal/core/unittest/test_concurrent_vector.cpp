@@ -11,7 +11,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <string>
 #include <thread>
@@ -127,3 +129,79 @@ TEST(ConcurrentVector, TestAckSingle) {
     }
     EXPECT_EQ(ack.GetAck(), N);
 }
+
+TEST(ConcurrentVector, TestFromRows) {
+    auto dim = 4;
+    int64_t N = 1000;
+    ConcurrentVectorImpl<int64_t, false> c_vec(dim, 32);
+    // each row holds a leading tag followed by the vector
+    int64_t sizeof_per_row = sizeof(int64_t) * (dim + 1);
+    std::vector<int64_t> rows(N * (dim + 1));
+    std::vector<int64_t> row_order(N);
+    for (int64_t i = 0; i < N; ++i) {
+        row_order[i] = N - 1 - i;
+        for (int d = 0; d < dim; ++d) {
+            rows[i * (dim + 1) + 1 + d] = i * dim + d;
+        }
+    }
+    c_vec.set_data_raw_from_rows(0, rows.data() + 1, sizeof_per_row, nullptr, N);
+    c_vec.set_data_raw_from_rows(N, rows.data() + 1, sizeof_per_row, row_order.data(), N);
+    ASSERT_EQ(c_vec.num_chunk(), (2 * N + 31) / 32);
+    for (int64_t i = 0; i < N; ++i) {
+        for (int d = 0; d < dim; ++d) {
+            ASSERT_EQ(c_vec.get_element(i)[d], i * dim + d);
+            ASSERT_EQ(c_vec.get_element(N + i)[d], (N - 1 - i) * dim + d);
+        }
+    }
+}
+
+TEST(ConcurrentVector, TestZoneMap) {
+    int64_t size_per_chunk = 32;
+    int64_t N = 1000;
+    ConcurrentVector<int32_t> c_vec(size_per_chunk);
+    std::vector<int32_t> data(N);
+    std::default_random_engine e(42);
+    for (auto& x : data) {
+        x = e() % 10000 - 5000;
+    }
+    int num_threads = 4;
+    std::vector<std::thread> threads;
+    for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back([&, thread_id] {
+            for (int64_t offset = thread_id * 7; offset < N; offset += num_threads * 7) {
+                auto count = std::min<int64_t>(7, N - offset);
+                c_vec.set_data(offset, data.data() + offset, count);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(c_vec.num_chunk(), (N + size_per_chunk - 1) / size_per_chunk);
+    for (int64_t chunk_id = 0; chunk_id < c_vec.num_chunk(); ++chunk_id) {
+        auto begin = data.begin() + chunk_id * size_per_chunk;
+        auto end = data.begin() + std::min(N, (chunk_id + 1) * size_per_chunk);
+        auto zone_map = std::get<milvus::ZoneMap<int32_t>>(c_vec.get_zone_map(chunk_id));
+        ASSERT_TRUE(zone_map.usable());
+        ASSERT_EQ(zone_map.min, *std::min_element(begin, end));
+        ASSERT_EQ(zone_map.max, *std::max_element(begin, end));
+    }
+
+    // NaN makes the chunk undecidable, rows gathered from row-based data are tracked as well
+    ConcurrentVector<float> f_vec(size_per_chunk);
+    std::vector<float> rows = {1.5, -2, std::numeric_limits<float>::quiet_NaN(), 4};
+    f_vec.set_data_raw_from_rows(0, rows.data(), sizeof(float), nullptr, 2);
+    f_vec.set_data_raw_from_rows(size_per_chunk, rows.data(), sizeof(float), nullptr, 4);
+    auto zone_map = std::get<milvus::ZoneMap<float>>(f_vec.get_zone_map(0));
+    ASSERT_TRUE(zone_map.usable());
+    ASSERT_EQ(zone_map.min, -2);
+    ASSERT_EQ(zone_map.max, 1.5);
+    zone_map = std::get<milvus::ZoneMap<float>>(f_vec.get_zone_map(1));
+    ASSERT_FALSE(zone_map.usable());
+    ASSERT_EQ(zone_map.null_count, 1);
+    ASSERT_EQ(zone_map.max, 4);
+
+    ConcurrentVector<milvus::Timestamp> ts_vec(size_per_chunk);
+    ts_vec.grow_to_at_least(1);
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(ts_vec.get_zone_map(0)));
+}
@@ -314,12 +314,10 @@ TEST(Expr, TestRange) {
         dsl_string.replace(loc, 4, clause);
         auto plan = CreatePlan(*schema, dsl_string);
         auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
-        EXPECT_EQ(final.size(), upper_div(N * num_iters, TestChunkSize));
+        EXPECT_EQ(final.size(), upper_align(N * num_iters, TestChunkSize));
 
         for (int i = 0; i < N * num_iters; ++i) {
-            auto vec_id = i / TestChunkSize;
-            auto offset = i % TestChunkSize;
-            auto ans = final[vec_id][offset];
+            auto ans = final[i];
 
             auto val = age_col[i];
             auto ref = ref_func(val);
@@ -398,12 +396,10 @@ TEST(Expr, TestTerm) {
         dsl_string.replace(loc, 4, clause);
         auto plan = CreatePlan(*schema, dsl_string);
         auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
-        EXPECT_EQ(final.size(), upper_div(N * num_iters, TestChunkSize));
+        EXPECT_EQ(final.size(), upper_align(N * num_iters, TestChunkSize));
 
         for (int i = 0; i < N * num_iters; ++i) {
-            auto vec_id = i / TestChunkSize;
-            auto offset = i % TestChunkSize;
-            auto ans = final[vec_id][offset];
+            auto ans = final[i];
 
             auto val = age_col[i];
             auto ref = ref_func(val);
@@ -500,15 +496,222 @@ TEST(Expr, TestSimpleDsl) {
         // std::cout << dsl.dump(2);
         auto plan = CreatePlan(*schema, dsl.dump());
         auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
-        EXPECT_EQ(final.size(), upper_div(N * num_iters, TestChunkSize));
+        EXPECT_EQ(final.size(), upper_align(N * num_iters, TestChunkSize));
 
         for (int i = 0; i < N * num_iters; ++i) {
-            auto vec_id = i / TestChunkSize;
-            auto offset = i % TestChunkSize;
-            bool ans = final[vec_id][offset];
+            bool ans = final[i];
             auto val = age_col[i];
             auto ref = ref_func(val);
             ASSERT_EQ(ans, ref) << clause << "@" << i << "!!" << val;
         }
     }
 }
+
+TEST(Expr, TestShortCircuit) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto vec_dsl = Json::parse(R"(
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 10
+                    }
+                }
+            }
+)");
+
+    int N = 10000;
+    // note: random gen range is [0, 2N)
+    auto get_range = [&](int lower, int upper) {
+        Json s;
+        s["range"]["age"]["GE"] = lower;
+        s["range"]["age"]["LT"] = upper;
+        return s;
+    };
+    auto get_term = [&](std::vector<int> terms) {
+        Json s;
+        s["term"]["age"]["values"] = terms;
+        return s;
+    };
+    std::vector<std::tuple<Json, std::function<bool(int)>>> testcases;
+    {
+        // selective clause last, so it gets reordered to the front
+        Json sub_dsl;
+        sub_dsl["must"] = Json::array({get_range(0, 2 * N), get_range(100, 2 * N), get_range(5000, 5010)});
+        testcases.emplace_back(sub_dsl, [](int x) { return 5000 <= x && x < 5010; });
+    }
+    {
+        // the first clause already empties every chunk
+        Json sub_dsl;
+        sub_dsl["must"] = Json::array({get_range(3 * N, 4 * N), get_range(0, 2 * N)});
+        testcases.emplace_back(sub_dsl, [](int x) { return false; });
+    }
+    {
+        // the first clause already fills every chunk
+        Json sub_dsl;
+        sub_dsl["should"] = Json::array({get_range(5, 10), get_range(0, 2 * N)});
+        testcases.emplace_back(sub_dsl, [](int x) { return true; });
+    }
+    {
+        Json inner;
+        inner["should"] = Json::array({get_term({1, 2, 3}), get_range(100, 200), get_range(19000, 2 * N)});
+        Json not_dsl;
+        not_dsl["must_not"] = Json::array({get_range(150, 160)});
+        Json sub_dsl;
+        sub_dsl["must"] = Json::array({inner, not_dsl, get_range(0, 19500)});
+        testcases.emplace_back(sub_dsl, [](int x) {
+            bool inner = (1 <= x && x <= 3) || (100 <= x && x < 200) || (19000 <= x);
+            return inner && !(150 <= x && x < 160) && x < 19500;
+        });
+    }
+
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+
+    auto seg = CreateGrowingSegment(schema);
+    std::vector<int> age_col;
+    int num_iters = 10;
+    for (int iter = 0; iter < num_iters; ++iter) {
+        auto raw_data = DataGen(schema, N, iter);
+        auto new_age_col = raw_data.get_col<int>(1);
+        age_col.insert(age_col.end(), new_age_col.begin(), new_age_col.end());
+        seg->PreInsert(N);
+        seg->Insert(iter * N, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+    }
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+    for (auto [clause, ref_func] : testcases) {
+        Json dsl;
+        dsl["bool"]["must"] = Json::array({clause, vec_dsl});
+        auto plan = CreatePlan(*schema, dsl.dump());
+        ExecExprVisitor visitor(*seg_promote, seg_promote->get_row_count(), MAX_TIMESTAMP);
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        EXPECT_EQ(final.size(), upper_align(N * num_iters, TestChunkSize));
+
+        for (int i = 0; i < N * num_iters; ++i) {
+            bool ans = final[i];
+            auto val = age_col[i];
+            auto ref = ref_func(val);
+            ASSERT_EQ(ans, ref) << clause << "@" << i << "!!" << val;
+        }
+    }
+}
+
+TEST(Expr, TestZoneMap) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto vec_dsl = Json::parse(R"(
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 10
+                    }
+                }
+            }
+)");
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+
+    // ages grow with the row offset, so most chunks are decided by their bounds alone
+    int N = 10000;
+    int num_iters = 10;
+    auto seg = CreateGrowingSegment(schema);
+    std::vector<int> age_col;
+    for (int iter = 0; iter < num_iters; ++iter) {
+        auto raw_data = DataGen(schema, N, iter);
+        auto age_offset = sizeof(float) * 16;
+        for (int i = 0; i < N; ++i) {
+            int age = (iter * N + i) / 10;
+            memcpy(raw_data.rows_.data() + i * raw_data.raw_.sizeof_per_row + age_offset, &age, sizeof(age));
+            age_col.push_back(age);
+        }
+        seg->PreInsert(N);
+        seg->Insert(iter * N, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+    }
+
+    std::vector<std::tuple<std::string, std::function<bool(int)>>> testcases = {
+        {R"({"range": {"age": {"GE": 4000}}})", [](int x) { return x >= 4000; }},
+        {R"({"range": {"age": {"LT": 4000}}})", [](int x) { return x < 4000; }},
+        {R"({"range": {"age": {"NE": 5000}}})", [](int x) { return x != 5000; }},
+        {R"({"range": {"age": {"EQ": 9999}}})", [](int x) { return x == 9999; }},
+        {R"({"range": {"age": {"GT": 3276, "LE": 6553}}})", [](int x) { return 3276 < x && x <= 6553; }},
+        {R"({"term": {"age": {"values": [0, 3277, 9998, 20000]}}})",
+         [](int x) { return x == 0 || x == 3277 || x == 9998; }},
+    };
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+    for (auto [clause, ref_func] : testcases) {
+        Json dsl;
+        dsl["bool"]["must"] = Json::array({Json::parse(clause), vec_dsl});
+        auto plan = CreatePlan(*schema, dsl.dump());
+        ExecExprVisitor visitor(*seg_promote, seg_promote->get_row_count(), MAX_TIMESTAMP);
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        EXPECT_EQ(final.size(), upper_align(N * num_iters, TestChunkSize));
+
+        for (int i = 0; i < N * num_iters; ++i) {
+            bool ans = final[i];
+            auto val = age_col[i];
+            auto ref = ref_func(val);
+            ASSERT_EQ(ans, ref) << clause << "@" << i << "!!" << val;
+        }
+    }
+}
+
+TEST(Expr, TestSealedEvaluatesLeafOnce) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto vec_dsl = Json::parse(R"(
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 10
+                    }
+                }
+            }
+)");
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+
+    int N = 10000;
+    auto raw_data = DataGen(schema, N);
+    auto age_col = raw_data.get_col<int>(1);
+    auto seg = CreateSealedSegment(schema);
+    SealedLoader(raw_data, *seg);
+
+    // note: random gen range is [0, 2N), every leaf of the tree goes through selectivity estimation
+    auto clause = Json::parse(R"({"must": [
+        {"range": {"age": {"GE": 0}}},
+        {"range": {"age": {"LT": 3000}}},
+        {"term": {"age": {"values": [1, 2, 3, 2500, 2501, 19000]}}}
+    ]})");
+    Json dsl;
+    dsl["bool"]["must"] = Json::array({clause, vec_dsl});
+    auto plan = CreatePlan(*schema, dsl.dump());
+    ExecExprVisitor visitor(*seg, seg->get_row_count(), MAX_TIMESTAMP);
+    auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+    EXPECT_EQ(visitor.leaf_evaluations(), 3);
+
+    for (int i = 0; i < N; ++i) {
+        auto val = age_col[i];
+        auto ref = (1 <= val && val <= 3) || val == 2500 || val == 2501;
+        ASSERT_EQ(final[i], ref) << "@" << i << "!!" << val;
+    }
+}
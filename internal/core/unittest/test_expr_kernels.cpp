@@ -0,0 +1,196 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <faiss/FaissHook.h>
+#include <boost/container/vector.hpp>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "query/ExprKernels.h"
+#include "query/ExprKernelsImpl.h"
+#include "utils/tools.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+namespace {
+constexpr int64_t N = 1000;  // not a multiple of 64, exercises the tail
+
+// boost vector keeps bool as plain bytes, like the segment chunks
+template <typename T>
+using Values = boost::container::vector<T>;
+
+template <typename T>
+Values<T>
+GenValues(int64_t n, int seed) {
+    std::default_random_engine e(seed);
+    Values<T> values(n);
+    for (auto& v : values) {
+        if constexpr (std::is_same_v<T, bool>) {
+            v = e() % 2;
+        } else {
+            // a narrow domain so that equal compares hit
+            v = static_cast<T>(static_cast<int>(e() % 21) - 10);
+        }
+    }
+    return values;
+}
+
+template <typename T, typename Pred>
+void
+CheckWords(const Values<T>& data, const std::vector<uint64_t>& words, Pred pred) {
+    ASSERT_EQ(words.size(), upper_div(data.size(), 64));
+    for (int64_t i = 0; i < words.size() * 64; ++i) {
+        bool expected = i < data.size() && pred(data[i]);
+        bool bit = (words[i / 64] >> (i % 64)) & 1;
+        ASSERT_EQ(bit, expected) << i;
+    }
+}
+
+template <typename T>
+void
+CheckKernels() {
+    using OpType = RangeExpr::OpType;
+    auto data = GenValues<T>(N, 42);
+    std::vector<uint64_t> words(upper_div(N, 64), ~uint64_t(0));
+    for (int64_t size : {int64_t(0), int64_t(1), int64_t(63), int64_t(64), int64_t(65), N}) {
+        Values<T> part(data.begin(), data.begin() + size);
+        words.assign(upper_div(size, 64), ~uint64_t(0));
+        for (int v : {-3, 0, 1}) {
+            auto val = static_cast<T>(v);
+            RangeKernel(part.data(), size, OpType::Equal, val, words.data());
+            CheckWords(part, words, [&](T x) { return x == val; });
+            RangeKernel(part.data(), size, OpType::NotEqual, val, words.data());
+            CheckWords(part, words, [&](T x) { return x != val; });
+            RangeKernel(part.data(), size, OpType::GreaterThan, val, words.data());
+            CheckWords(part, words, [&](T x) { return x > val; });
+            RangeKernel(part.data(), size, OpType::GreaterEqual, val, words.data());
+            CheckWords(part, words, [&](T x) { return x >= val; });
+            RangeKernel(part.data(), size, OpType::LessThan, val, words.data());
+            CheckWords(part, words, [&](T x) { return x < val; });
+            RangeKernel(part.data(), size, OpType::LessEqual, val, words.data());
+            CheckWords(part, words, [&](T x) { return x <= val; });
+        }
+        auto lower = static_cast<T>(-2);
+        auto upper = static_cast<T>(5);
+        for (bool lower_inclusive : {false, true}) {
+            for (bool upper_inclusive : {false, true}) {
+                BetweenKernel(part.data(), size, lower_inclusive, lower, upper_inclusive, upper, words.data());
+                CheckWords(part, words, [&](T x) {
+                    return (lower_inclusive ? lower <= x : lower < x) && (upper_inclusive ? x <= upper : x < upper);
+                });
+            }
+        }
+        // both the broadcast and the hash set path
+        for (int num_terms : {1, 3, 8, 9, 17}) {
+            auto terms = GenValues<T>(num_terms, num_terms);
+            TermKernel<T> kernel(terms.data(), terms.size());
+            kernel(part.data(), size, words.data());
+            CheckWords(part, words, [&](T x) { return std::find(terms.begin(), terms.end(), x) != terms.end(); });
+        }
+    }
+}
+
+// the dispatcher only takes the best instruction set, so check the others directly against the scalar one
+template <typename T>
+void
+CheckSimdKernels() {
+    using Scalar = simd::ScalarSimd<T>;
+    auto data = GenValues<T>(N, 7);
+    auto terms = GenValues<T>(simd::MaxBroadcastTerms, 3);
+    auto num_words = upper_div(N, 64);
+    std::vector<uint64_t> expected(num_words);
+    std::vector<uint64_t> words(num_words);
+    auto val = static_cast<T>(2);
+    for (auto op : {simd::CmpOp::Equal, simd::CmpOp::NotEqual, simd::CmpOp::GreaterThan, simd::CmpOp::GreaterEqual,
+                    simd::CmpOp::LessThan, simd::CmpOp::LessEqual}) {
+        simd::compare_range<Scalar>(data.data(), N, op, val, expected.data(), nullptr);
+        if (faiss::support_avx2()) {
+            simd::compare_range_avx2(data.data(), N, op, val, words.data(), nullptr);
+            ASSERT_EQ(words, expected);
+        }
+        if (faiss::support_avx512()) {
+            simd::compare_range_avx512(data.data(), N, op, val, words.data(), nullptr);
+            ASSERT_EQ(words, expected);
+        }
+    }
+    simd::compare_between<Scalar>(data.data(), N, true, T(-4), false, T(6), expected.data(), nullptr);
+    if (faiss::support_avx2()) {
+        simd::compare_between_avx2(data.data(), N, true, T(-4), false, T(6), words.data(), nullptr);
+        ASSERT_EQ(words, expected);
+    }
+    if (faiss::support_avx512()) {
+        simd::compare_between_avx512(data.data(), N, true, T(-4), false, T(6), words.data(), nullptr);
+        ASSERT_EQ(words, expected);
+    }
+    simd::compare_terms<Scalar>(data.data(), N, terms.data(), terms.size(), expected.data(), nullptr);
+    if (faiss::support_avx2()) {
+        simd::compare_terms_avx2(data.data(), N, terms.data(), terms.size(), words.data(), nullptr);
+        ASSERT_EQ(words, expected);
+    }
+    if (faiss::support_avx512()) {
+        simd::compare_terms_avx512(data.data(), N, terms.data(), terms.size(), words.data(), nullptr);
+        ASSERT_EQ(words, expected);
+    }
+}
+}  // namespace
+
+TEST(ExprKernels, Dispatch) {
+    CheckKernels<bool>();
+    CheckKernels<int8_t>();
+    CheckKernels<int16_t>();
+    CheckKernels<int32_t>();
+    CheckKernels<int64_t>();
+    CheckKernels<float>();
+    CheckKernels<double>();
+}
+
+TEST(ExprKernels, Simd) {
+    CheckSimdKernels<int8_t>();
+    CheckSimdKernels<int16_t>();
+    CheckSimdKernels<int32_t>();
+    CheckSimdKernels<int64_t>();
+    CheckSimdKernels<float>();
+    CheckSimdKernels<double>();
+}
+
+TEST(ExprKernels, LiveMask) {
+    auto data = GenValues<int32_t>(N, 11);
+    auto num_words = upper_div(N, 64);
+    std::vector<uint64_t> live(num_words);
+    for (int64_t w = 0; w < num_words; w += 3) {
+        live[w] = 1;
+    }
+    std::vector<uint64_t> expected(num_words);
+    std::vector<uint64_t> words(num_words, ~uint64_t(0));
+    RangeKernel(data.data(), N, RangeExpr::OpType::GreaterEqual, 0, expected.data());
+    RangeKernel(data.data(), N, RangeExpr::OpType::GreaterEqual, 0, words.data(), live.data());
+    for (int64_t w = 0; w < num_words; ++w) {
+        ASSERT_EQ(words[w], live[w] ? expected[w] : 0) << w;
+    }
+    std::vector<int32_t> terms{1, 2, 3};
+    TermKernel<int32_t> kernel(terms.data(), terms.size());
+    kernel(data.data(), N, expected.data());
+    kernel(data.data(), N, words.data(), live.data());
+    for (int64_t w = 0; w < num_words; ++w) {
+        ASSERT_EQ(words[w], live[w] ? expected[w] : 0) << w;
+    }
+}
+
+TEST(ExprKernels, FloatNaN) {
+    std::vector<float> data{1.0f, std::numeric_limits<float>::quiet_NaN(), 2.0f};
+    std::vector<uint64_t> words(1);
+    RangeKernel(data.data(), data.size(), RangeExpr::OpType::NotEqual, 1.0f, words.data());
+    ASSERT_EQ(words[0], 0b110);
+    RangeKernel(data.data(), data.size(), RangeExpr::OpType::LessEqual, 2.0f, words.data());
+    ASSERT_EQ(words[0], 0b101);
+}
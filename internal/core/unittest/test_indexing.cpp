@@ -32,6 +32,9 @@
 #include <chrono>
 #include "test_utils/Timer.h"
 #include "segcore/Reduce.h"
+#include "segcore/IndexBuildScheduler.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "query/Plan.h"
 #include "test_utils/DataGen.h"
 #include "query/SearchBruteForce.h"
 
@@ -344,3 +347,109 @@ TEST(Indexing, BinaryBruteForce) {
     auto ref_str = ref.dump(2);
     ASSERT_EQ(json_str, ref_str);
 }
+
+TEST(Indexing, AsyncSmallIndex) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+    auto seg_conf = SegcoreConfig::default_config();
+    int64_t size_per_chunk = 1024;
+    seg_conf.set_size_per_chunk(size_per_chunk);
+
+    auto& scheduler = IndexBuildScheduler::Instance();
+    scheduler.Configure(2, 2);
+    auto finished = scheduler.GetMetrics().finished;
+
+    int64_t num_chunk = 10;
+    auto N = num_chunk * size_per_chunk + 100;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema, seg_conf);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto& indexing_record = dynamic_cast<SegmentGrowingImpl*>(segment.get())->get_indexing_record();
+    indexing_record.WaitForBuilds();
+    ASSERT_EQ(indexing_record.get_finished_ack(), num_chunk);
+    ASSERT_EQ(segment->get_small_index_lag(), 0);
+
+    // back to inline builds for the other tests, this also joins the pool
+    scheduler.Configure(0, 1);
+    auto metrics = scheduler.GetMetrics();
+    ASSERT_EQ(metrics.finished - finished, num_chunk);
+    ASSERT_EQ(metrics.failed, 0);
+    ASSERT_EQ(metrics.running, 0);
+    ASSERT_EQ(metrics.queued, 0);
+}
+
+TEST(Indexing, FailedSmallIndex) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::INT32);
+    auto seg_conf = SegcoreConfig::default_config();
+    int64_t size_per_chunk = 1024;
+    seg_conf.set_size_per_chunk(size_per_chunk);
+    // more lists than rows in a chunk, so training fails for every chunk
+    auto small_index_conf = seg_conf.at(MetricType::METRIC_L2);
+    small_index_conf.build_params["nlist"] = 2 * size_per_chunk;
+    seg_conf.set_small_index_config(MetricType::METRIC_L2, small_index_conf);
+
+    auto& scheduler = IndexBuildScheduler::Instance();
+    auto failed = scheduler.GetMetrics().failed;
+
+    int64_t num_chunk = 4;
+    auto N = num_chunk * size_per_chunk + 100;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema, seg_conf);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // failed chunks are skipped instead of holding back the ack
+    auto& indexing_record = dynamic_cast<SegmentGrowingImpl*>(segment.get())->get_indexing_record();
+    indexing_record.WaitForBuilds();
+    ASSERT_EQ(indexing_record.get_finished_ack(), num_chunk);
+    ASSERT_EQ(segment->get_small_index_lag(), 0);
+    ASSERT_EQ(scheduler.GetMetrics().failed - failed, num_chunk);
+
+    // and searched by brute force
+    auto ref_segment = CreateGrowingSegment(schema, seg_conf);
+    ref_segment->debug_disable_small_index();
+    ref_segment->PreInsert(N);
+    ref_segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "age": {
+                        "GE": 0,
+                        "LT": 2000
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(5, 16, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    auto qr = segment->Search(plan.get(), *ph_group, MAX_TIMESTAMP);
+    auto ref = ref_segment->Search(plan.get(), *ph_group, MAX_TIMESTAMP);
+    ASSERT_EQ(qr.internal_seg_offsets_, ref.internal_seg_offsets_);
+    ASSERT_EQ(qr.result_distances_, ref.result_distances_);
+}
@@ -15,9 +15,18 @@
 #include "test_utils/DataGen.h"
 #include <gtest/gtest.h>
 #include "segcore/segcore_init_c.h"
+#include "segcore/IndexBuildScheduler.h"
+#include "segcore/LoadScheduler.h"
 
 TEST(Init, Naive) {
     using namespace milvus;
     using namespace milvus::segcore;
     SegcoreInit();
+    SegcoreSetIndexBuildPool(2, 64);
+    SegcoreSetLoadPool(3, 1024);
+    ASSERT_EQ(IndexBuildScheduler::Instance().get_concurrency(), 2);
+    ASSERT_EQ(LoadScheduler::Instance().get_concurrency(), 3);
+    // later tests expect small indexes to be ready right after insert
+    SegcoreSetIndexBuildPool(0, 1);
+    SegcoreSetLoadPool(0, 1);
 }
\ No newline at end of file
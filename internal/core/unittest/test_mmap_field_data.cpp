@@ -0,0 +1,171 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/FieldBuffer.h"
+#include "segcore/SegmentSealedImpl.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+// appends every column at a page aligned offset, returns the offsets
+std::vector<int64_t>
+WriteColumns(const std::string& path, const std::vector<std::pair<const void*, int64_t>>& columns) {
+    int64_t page_size = sysconf(_SC_PAGESIZE);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    std::vector<int64_t> offsets;
+    int64_t pos = 0;
+    for (auto [data, size] : columns) {
+        std::vector<char> padding((page_size - pos % page_size) % page_size, 0);
+        out.write(padding.data(), padding.size());
+        pos += padding.size();
+        offsets.push_back(pos);
+        out.write(reinterpret_cast<const char*>(data), size);
+        pos += size;
+    }
+    return offsets;
+}
+
+std::string
+TempPath(const std::string& name) {
+    return "/tmp/milvus_test_" + name + "_" + std::to_string(getpid());
+}
+}  // namespace
+
+TEST(MmapFieldData, FieldBuffer) {
+    std::vector<int64_t> values(5000);
+    for (int64_t i = 0; i < values.size(); ++i) {
+        values[i] = i * 3 - 7;
+    }
+    auto path = TempPath("field_buffer");
+    std::string head = "header";
+    auto offsets = WriteColumns(path, {{head.data(), head.size()}, {values.data(), values.size() * sizeof(int64_t)}});
+
+    auto length = values.size() * sizeof(int64_t);
+    auto buffer = FieldBuffer::Map(path, offsets[1], length, AccessPattern::SEQUENTIAL);
+    ASSERT_TRUE(buffer.is_mapped());
+    ASSERT_EQ(buffer.size(), length);
+    ASSERT_EQ(memcmp(buffer.data(), values.data(), length), 0);
+
+    // a misaligned region still maps
+    auto shifted = FieldBuffer::Map(path, offsets[1] + sizeof(int64_t), length - sizeof(int64_t), AccessPattern::RANDOM);
+    ASSERT_EQ(reinterpret_cast<const int64_t*>(shifted.data())[0], values[1]);
+
+    auto moved = std::move(buffer);
+    ASSERT_TRUE(moved.is_mapped());
+    ASSERT_FALSE(buffer.is_mapped());
+    ASSERT_TRUE(buffer.empty());
+    moved.clear();
+    ASSERT_TRUE(moved.empty());
+
+    ASSERT_ANY_THROW(FieldBuffer::Map(path, offsets[1], length + 1, AccessPattern::NORMAL));
+    ASSERT_ANY_THROW(FieldBuffer::Map(path + "_missing", 0, length, AccessPattern::NORMAL));
+
+    aligned_vector<char> heap(100, 'x');
+    FieldBuffer owned(std::move(heap));
+    ASSERT_FALSE(owned.is_mapped());
+    ASSERT_EQ(owned.size(), 100);
+    ASSERT_EQ(owned.data()[99], 'x');
+    std::remove(path.c_str());
+}
+
+TEST(MmapFieldData, SealedSegment) {
+    auto dim = 16;
+    int64_t N = 10000;
+    auto schema = std::make_shared<Schema>();
+    auto vec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    schema->AddDebugField("double", DataType::DOUBLE);
+    auto dataset = DataGen(schema, N);
+
+    std::vector<std::pair<const void*, int64_t>> columns;
+    columns.emplace_back(dataset.row_ids_.data(), N * sizeof(idx_t));
+    columns.emplace_back(dataset.timestamps_.data(), N * sizeof(Timestamp));
+    for (auto& col : dataset.cols_) {
+        columns.emplace_back(col.data(), col.size());
+    }
+    auto path = TempPath("sealed_segment");
+    auto offsets = WriteColumns(path, columns);
+
+    auto heap_segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *heap_segment);
+
+    auto mapped_segment = CreateSealedSegment(schema);
+    std::vector<int64_t> field_ids = {0, 1};
+    for (auto& meta : schema->get_fields()) {
+        field_ids.push_back(meta.get_id().get());
+    }
+    for (int i = 0; i < field_ids.size(); ++i) {
+        LoadFieldDataInfo info;
+        info.field_id = field_ids[i];
+        info.row_count = N;
+        info.file_path = path;
+        info.file_offset = offsets[i];
+        info.access_pattern = AccessPattern::SEQUENTIAL;
+        mapped_segment->LoadFieldData(info);
+    }
+    // the file is unlinked, the mappings keep it alive
+    std::remove(path.c_str());
+
+    // the mapped vector and scalar columns are not counted as heap
+    ASSERT_LT(mapped_segment->GetMemoryUsageInBytes(), heap_segment->GetMemoryUsageInBytes());
+
+    auto counter = mapped_segment->chunk_data<int64_t>(FieldOffset(1), 0);
+    auto ref = dataset.get_col<int64_t>(1);
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(counter[i], ref[i]);
+    }
+
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "double": {
+                        "GE": -1,
+                        "LT": 1
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(5, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 1000000;
+    auto heap_result = heap_segment->Search(plan.get(), *ph_group, time);
+    auto mapped_result = mapped_segment->Search(plan.get(), *ph_group, time);
+    ASSERT_EQ(QueryResultToJson(heap_result).dump(2), QueryResultToJson(mapped_result).dump(2));
+
+    mapped_segment->DropFieldData(vec_id);
+    ASSERT_ANY_THROW(mapped_segment->Search(plan.get(), *ph_group, time));
+}
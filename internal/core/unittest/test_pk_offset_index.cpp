@@ -0,0 +1,73 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <random>
+#include <map>
+#include <numeric>
+#include <vector>
+#include "segcore/PkOffsetIndex.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+TEST(PkOffsetIndex, Naive) {
+    PkOffsetIndex index;
+    std::vector<int64_t> pks{1, 2, 3, 2, 1, 2};
+    std::vector<Timestamp> timestamps{10, 11, 12, 13, 14, 15};
+    index.insert(0, pks.size(), pks.data(), timestamps.data());
+    ASSERT_EQ(index.size(), pks.size());
+
+    ASSERT_EQ(index.find_latest(1, 100, 100), 4);
+    ASSERT_EQ(index.find_latest(1, 14, 100), 0);
+    ASSERT_EQ(index.find_latest(1, 10, 100), -1);
+    ASSERT_EQ(index.find_latest(2, 100, 100), 5);
+    ASSERT_EQ(index.find_latest(2, 100, 5), 3);
+    ASSERT_EQ(index.find_latest(4, 100, 100), -1);
+}
+
+TEST(PkOffsetIndex, Batch) {
+    int64_t N = 100000;
+    int64_t batch_size = 1000;
+    int64_t num_keys = 30000;
+    std::default_random_engine e(42);
+    PkOffsetIndex index;
+    std::multimap<int64_t, int64_t> ref;
+    std::vector<int64_t> pks(N);
+    std::vector<Timestamp> timestamps(N);
+    for (int64_t i = 0; i < N; ++i) {
+        pks[i] = e() % num_keys;
+        timestamps[i] = i;
+        ref.emplace(pks[i], i);
+    }
+    for (int64_t beg = 0; beg < N; beg += batch_size) {
+        index.insert(beg, batch_size, pks.data() + beg, timestamps.data() + beg);
+    }
+    ASSERT_EQ(index.size(), N);
+
+    Timestamp query_timestamp = N / 2;
+    int64_t offset_barrier = N * 3 / 4;
+    std::vector<int64_t> queries(num_keys + 100);
+    std::iota(queries.begin(), queries.end(), 0);
+    std::vector<int64_t> offsets(queries.size());
+    index.find_latest(queries.size(), queries.data(), query_timestamp, offset_barrier, offsets.data());
+    for (int64_t i = 0; i < queries.size(); ++i) {
+        int64_t the_offset = -1;
+        auto [iter_b, iter_e] = ref.equal_range(queries[i]);
+        for (auto iter = iter_b; iter != iter_e; ++iter) {
+            if (timestamps[iter->second] < query_timestamp && iter->second < offset_barrier) {
+                the_offset = std::max(the_offset, iter->second);
+            }
+        }
+        ASSERT_EQ(offsets[i], the_offset);
+        ASSERT_EQ(index.find_latest(queries[i], query_timestamp, offset_barrier), the_offset);
+    }
+}
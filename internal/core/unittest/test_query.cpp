@@ -506,6 +506,58 @@ TEST(Query, ExecWithoutPredicateFlat) {
     std::cout << json.dump(2);
 }
 
+TEST(Query, ExecParallelChunks) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, MetricType::METRIC_L2);
+    schema->AddDebugField("age", DataType::FLOAT);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 20
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    int64_t N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, 16, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 1000000;
+
+    // 10 chunks with a ragged tail, every degree of parallelism must give the sequential answer
+    std::optional<Json> ref;
+    for (int64_t parallelism : {1, 0, 3, 16}) {
+        auto seg_conf = SegcoreConfig::default_config();
+        seg_conf.set_size_per_chunk(1000 + 24);
+        seg_conf.set_search_parallelism(parallelism);
+        auto segment = CreateGrowingSegment(schema, seg_conf);
+        segment->debug_disable_small_index();
+        segment->PreInsert(N);
+        segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+        auto qr = segment->Search(plan.get(), *ph_group, time);
+        auto json = QueryResultToJson(qr);
+        if (!ref.has_value()) {
+            ref = json;
+        }
+        ASSERT_EQ(json.dump(), ref->dump()) << parallelism;
+    }
+}
+
 TEST(Query, ExecWithoutPredicate) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -740,14 +792,14 @@ TEST(Query, FillSegment) {
         result.result_offsets_.resize(topk * num_queries);
         segment->FillTargetEntry(plan.get(), result);
 
-        auto ans = result.row_data_;
-        ASSERT_EQ(ans.size(), topk * num_queries);
-        int64_t std_index = 0;
+        auto row_sizeof = sizeof(int64_t) + sizeof(float) * dim + sizeof(int32_t);
+        ASSERT_EQ(result.row_data_sizeof_, row_sizeof);
+        ASSERT_EQ(result.row_data_.size(), topk * num_queries * row_sizeof);
 
-        for (auto& vec : ans) {
-            ASSERT_EQ(vec.size(), sizeof(int64_t) + sizeof(float) * dim + sizeof(int32_t));
+        for (int64_t std_index = 0; std_index < topk * num_queries; ++std_index) {
+            auto row = result.get_row_data(std_index);
             int64_t val;
-            memcpy(&val, vec.data(), sizeof(int64_t));
+            memcpy(&val, row, sizeof(int64_t));
 
             auto internal_offset = result.internal_seg_offsets_[std_index];
             auto std_val = std_vec[internal_offset];
@@ -759,12 +811,11 @@ TEST(Query, FillSegment) {
             if (val != -1) {
                 std::vector<float> vfloat(dim);
                 int i32;
-                memcpy(vfloat.data(), vec.data() + sizeof(int64_t), dim * sizeof(float));
-                memcpy(&i32, vec.data() + sizeof(int64_t) + dim * sizeof(float), sizeof(int32_t));
+                memcpy(vfloat.data(), row + sizeof(int64_t), dim * sizeof(float));
+                memcpy(&i32, row + sizeof(int64_t) + dim * sizeof(float), sizeof(int32_t));
                 ASSERT_EQ(vfloat, std_vfloat) << std_index;
                 ASSERT_EQ(i32, std_i32) << std_index;
             }
-            ++std_index;
         }
     }
 }
@@ -0,0 +1,233 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "common/VectorPrecision.h"
+#include "query/SearchBruteForce.h"
+#include "query/SubQueryResult.h"
+#include "segcore/reduce_c.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+// squared l2 distances of every query against every row within radius, nearest first, at most topk per query
+std::vector<std::vector<std::pair<float, int64_t>>>
+RangeReference(const float* queries, int64_t num_queries, const float* base, int64_t N, int64_t dim, float radius,
+               int64_t topk) {
+    std::vector<std::vector<std::pair<float, int64_t>>> ref(num_queries);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        for (int64_t i = 0; i < N; ++i) {
+            float dis = 0;
+            for (int64_t d = 0; d < dim; ++d) {
+                auto diff = queries[q * dim + d] - base[i * dim + d];
+                dis += diff * diff;
+            }
+            if (dis < radius * radius) {
+                ref[q].emplace_back(dis, i);
+            }
+        }
+        std::sort(ref[q].begin(), ref[q].end());
+        if (ref[q].size() > topk) {
+            ref[q].resize(topk);
+        }
+    }
+    return ref;
+}
+
+void
+CheckRangeResult(const QueryResult& qr, const std::vector<std::vector<std::pair<float, int64_t>>>& ref) {
+    ASSERT_EQ(qr.result_lims_.size(), ref.size() + 1);
+    ASSERT_EQ(qr.get_row_count(), qr.internal_seg_offsets_.size());
+    for (int64_t q = 0; q < ref.size(); ++q) {
+        auto begin = qr.get_query_offset(q);
+        auto end = qr.get_query_offset(q + 1);
+        ASSERT_EQ(end - begin, ref[q].size());
+        for (auto i = begin; i < end; ++i) {
+            ASSERT_EQ(qr.internal_seg_offsets_[i], ref[q][i - begin].second);
+            ASSERT_NEAR(qr.result_distances_[i], ref[q][i - begin].first, 1e-3);
+        }
+    }
+}
+}  // namespace
+
+TEST(RangeSearch, SubQueryResult) {
+    auto metric_type = MetricType::METRIC_L2;
+    int64_t topk = 3;
+    // query 0 has 4 unsorted hits, query 1 none, query 2 one
+    std::vector<size_t> lims{0, 4, 4, 5};
+    std::vector<int64_t> labels{10, 11, 12, 13, 20};
+    std::vector<float> values{4, 1, 3, 2, 7};
+    auto left = SubQueryResult::from_range_hits(3, topk, metric_type, lims.data(), labels.data(), values.data());
+    ASSERT_TRUE(left.is_range());
+    ASSERT_EQ(left.get_lims(), (std::vector<int64_t>{0, 3, 3, 4}));
+    ASSERT_EQ(left.mutable_labels(), (std::vector<int64_t>{11, 13, 12, 20}));
+
+    std::vector<size_t> right_lims{0, 1, 3, 3};
+    std::vector<int64_t> right_labels{30, 31, 32};
+    std::vector<float> right_values{1.5, 6, 5};
+    auto right = SubQueryResult::from_range_hits(3, topk, metric_type, right_lims.data(), right_labels.data(),
+                                                 right_values.data());
+    left.merge(right);
+    ASSERT_EQ(left.get_lims(), (std::vector<int64_t>{0, 3, 5, 6}));
+    ASSERT_EQ(left.mutable_labels(), (std::vector<int64_t>{11, 30, 13, 32, 31, 20}));
+    ASSERT_EQ(left.mutable_values(), (std::vector<float>{1, 1.5, 2, 5, 6, 7}));
+
+    auto empty = SubQueryResult::empty_range(3, topk, metric_type);
+    empty.merge(left);
+    ASSERT_EQ(empty.get_lims(), left.get_lims());
+    ASSERT_EQ(empty.mutable_labels(), left.mutable_labels());
+
+    SubQueryResult knn(3, topk, metric_type);
+    ASSERT_ANY_THROW(knn.merge(left));
+}
+
+TEST(RangeSearch, BruteForce) {
+    int64_t dim = 16;
+    int64_t N = 5000;
+    int64_t num_queries = 7;
+    int64_t topk = 50;
+    float radius = 3.5;
+    std::default_random_engine e(42);
+    std::normal_distribution<float> dist(0, 1);
+    std::vector<float> base(N * dim);
+    for (auto& x : base) {
+        x = dist(e);
+    }
+    // the queries are rows of the base, so every query hits at least itself
+    std::vector<float> queries(base.begin(), base.begin() + num_queries * dim);
+
+    dataset::QueryDataset query_dataset{MetricType::METRIC_L2, num_queries, topk, dim, queries.data(), radius};
+    auto sub_qr = FloatSearchBruteForce(query_dataset, base.data(), N, nullptr);
+    QueryResult qr;
+    qr.num_queries_ = num_queries;
+    qr.topK_ = topk;
+    qr.internal_seg_offsets_ = sub_qr.mutable_labels();
+    qr.result_distances_ = sub_qr.mutable_values();
+    qr.result_lims_ = sub_qr.mutable_lims();
+    auto ref = RangeReference(queries.data(), num_queries, base.data(), N, dim, radius, topk);
+    CheckRangeResult(qr, ref);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        ASSERT_EQ(qr.internal_seg_offsets_[qr.get_query_offset(q)], q);
+    }
+
+    // compact rows are searched against their decoded values
+    auto precision = VectorPrecision::FP16;
+    std::vector<uint8_t> codes(N * vector_code_sizeof(precision, dim));
+    EncodeVectors(precision, base.data(), N, dim, codes.data());
+    std::vector<float> decoded(N * dim);
+    DecodeVectors(precision, codes.data(), N, dim, decoded.data());
+    auto compact_qr = CompactSearchBruteForce(query_dataset, codes.data(), precision, N, nullptr);
+    auto compact_ref = RangeReference(queries.data(), num_queries, decoded.data(), N, dim, radius, topk);
+    ASSERT_EQ(compact_qr.get_lims().back(), compact_qr.mutable_labels().size());
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto begin = compact_qr.get_lims()[q];
+        ASSERT_EQ(compact_qr.get_lims()[q + 1] - begin, compact_ref[q].size());
+        for (int64_t i = 0; i < compact_ref[q].size(); ++i) {
+            ASSERT_EQ(compact_qr.mutable_labels()[begin + i], compact_ref[q][i].second);
+        }
+    }
+}
+
+TEST(RangeSearch, Segment) {
+    int64_t dim = 16;
+    int64_t N = 10000;
+    int64_t num_queries = 5;
+    int64_t topk = 200;
+    float radius = 3.5;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 100,
+                            "range_search_radius": 3.5
+                        },
+                        "query": "$0",
+                        "topk": 200
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    ASSERT_TRUE(plan->plan_node_->query_info_.radius_.has_value());
+
+    auto dataset = DataGen(schema, N);
+    auto fakevec = dataset.get_col<float>(0);
+    auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, fakevec.data());
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    auto ref = RangeReference(fakevec.data(), num_queries, fakevec.data(), N, dim, radius, topk);
+    Timestamp time = 1000000;
+
+    auto growing = CreateGrowingSegment(schema);
+    growing->PreInsert(N);
+    growing->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    CheckRangeResult(growing->Search(plan.get(), *ph_group, time), ref);
+
+    // raw data first, then an ivf index probing every list, which is exhaustive as well
+    auto sealed = CreateSealedSegment(schema);
+    SealedLoader(dataset, *sealed);
+    CheckRangeResult(sealed->Search(plan.get(), *ph_group, time), ref);
+
+    LoadIndexInfo vec_info;
+    vec_info.field_id = fakevec_id.get();
+    vec_info.index = GenIndexing(N, dim, fakevec.data());
+    vec_info.index_params["metric_type"] = milvus::knowhere::Metric::L2;
+    sealed->LoadIndex(vec_info);
+    CheckRangeResult(sealed->Search(plan.get(), *ph_group, time), ref);
+}
+
+TEST(RangeSearch, Reduce) {
+    auto make_result = [](std::vector<int64_t> lims, std::vector<float> distances) {
+        auto result = new QueryResult();
+        result->num_queries_ = lims.size() - 1;
+        result->topK_ = 3;
+        result->internal_seg_offsets_.resize(distances.size());
+        std::iota(result->internal_seg_offsets_.begin(), result->internal_seg_offsets_.end(), 0);
+        result->result_distances_ = std::move(distances);
+        result->result_lims_ = std::move(lims);
+        return result;
+    };
+    // L2 distances come negated, as Search in the C API hands them over.
+    // query 0 takes 2 hits from each segment, capped at 3, query 1 has none, query 2 a single one
+    auto left = make_result({0, 2, 2, 2}, {-1, -3});
+    auto right = make_result({0, 2, 2, 3}, {-2, -4, -5});
+    std::vector<CQueryResult> results{left, right};
+    bool is_selected[2] = {false, false};
+    auto status = ReduceQueryResults(results.data(), 2, is_selected);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_TRUE(is_selected[0]);
+    ASSERT_TRUE(is_selected[1]);
+
+    ASSERT_EQ(left->result_distances_, (std::vector<float>{-1, -3}));
+    ASSERT_EQ(left->result_offsets_, (std::vector<int64_t>{0, 2}));
+    ASSERT_EQ(left->result_lims_, (std::vector<int64_t>{0, 2, 2, 2}));
+    ASSERT_EQ(right->result_distances_, (std::vector<float>{-2, -5}));
+    ASSERT_EQ(right->internal_seg_offsets_, (std::vector<int64_t>{0, 2}));
+    ASSERT_EQ(right->result_offsets_, (std::vector<int64_t>{1, 3}));
+    ASSERT_EQ(right->result_lims_, (std::vector<int64_t>{0, 1, 1, 2}));
+    delete left;
+    delete right;
+}
@@ -11,6 +11,9 @@
 
 #include <gtest/gtest.h>
 #include "query/SubQueryResult.h"
+#include "segcore/reduce_c.h"
+#include <algorithm>
+#include <functional>
 #include <vector>
 #include <queue>
 #include <random>
@@ -117,4 +120,80 @@ TEST(Reduce, SubQueryResultDesc) {
             ASSERT_EQ(value, ref_x);
         }
     }
-}
\ No newline at end of file
+}
+// hits as the C API hands them to the reduce: Search in segment_c.cpp negates every non-IP distance,
+// so each segment's hits come sorted larger first and the nearest L2 hits have the largest scores
+void
+CheckReduceQueryResults(MetricType metric_type) {
+    int64_t num_queries = 16;
+    int64_t topk = 32;
+    int64_t num_segments = 8;
+    auto is_ip = metric_type == MetricType::METRIC_INNER_PRODUCT;
+    std::default_random_engine e(42);
+
+    std::vector<QueryResult> query_results;
+    std::vector<std::vector<float>> raw_distances(num_queries);
+    for (int64_t seg = 0; seg < num_segments; ++seg) {
+        QueryResult query_result(num_queries, topk);
+        for (int64_t n = 0; n < num_queries; ++n) {
+            auto begin = query_result.result_distances_.begin() + n * topk;
+            for (int64_t k = 0; k < topk; ++k) {
+                begin[k] = e() % 100000;
+                query_result.internal_seg_offsets_[n * topk + k] = seg * num_queries * topk + n * topk + k;
+            }
+            if (is_ip) {
+                std::sort(begin, begin + topk, std::greater<float>());
+            } else {
+                std::sort(begin, begin + topk);
+            }
+            raw_distances[n].insert(raw_distances[n].end(), begin, begin + topk);
+            if (!is_ip) {
+                std::transform(begin, begin + topk, begin, std::negate<float>());
+            }
+        }
+        query_results.emplace_back(std::move(query_result));
+    }
+
+    std::vector<CQueryResult> c_query_results;
+    for (auto& query_result : query_results) {
+        c_query_results.push_back(&query_result);
+    }
+    std::vector<char> is_selected(num_segments, false);
+    auto status = ReduceQueryResults(c_query_results.data(), num_segments, (bool*)is_selected.data());
+    ASSERT_EQ(status.error_code, Success);
+
+    std::vector<float> reduced_distances(num_queries * topk);
+    int64_t total_count = 0;
+    for (auto& query_result : query_results) {
+        auto size = query_result.result_offsets_.size();
+        ASSERT_EQ(query_result.result_distances_.size(), size);
+        ASSERT_EQ(query_result.internal_seg_offsets_.size(), size);
+        for (int64_t i = 0; i < size; ++i) {
+            reduced_distances[query_result.result_offsets_[i]] = query_result.result_distances_[i];
+        }
+        total_count += size;
+    }
+    ASSERT_EQ(total_count, num_queries * topk);
+
+    // the smallest L2 distances or the largest inner products over all segments survive, best first
+    for (int64_t n = 0; n < num_queries; ++n) {
+        auto& ref = raw_distances[n];
+        if (is_ip) {
+            std::sort(ref.begin(), ref.end(), std::greater<float>());
+        } else {
+            std::sort(ref.begin(), ref.end());
+        }
+        for (int64_t k = 0; k < topk; ++k) {
+            auto reduced = reduced_distances[n * topk + k];
+            ASSERT_EQ(is_ip ? reduced : -reduced, ref[k]);
+        }
+    }
+}
+
+TEST(Reduce, ReduceQueryResults) {
+    CheckReduceQueryResults(MetricType::METRIC_L2);
+}
+
+TEST(Reduce, ReduceQueryResultsDesc) {
+    CheckReduceQueryResults(MetricType::METRIC_INNER_PRODUCT);
+}
@@ -18,6 +18,7 @@
 #include <knowhere/index/vector_index/adapter/VectorAdapter.h>
 #include <knowhere/index/vector_index/VecIndexFactory.h>
 #include <knowhere/index/vector_index/IndexIVF.h>
+#include "segcore/LoadScheduler.h"
 #include "segcore/SegmentSealedImpl.h"
 
 using namespace milvus;
@@ -345,3 +346,90 @@ TEST(Sealed, LoadFieldData) {
     )");
     ASSERT_EQ(std_json.dump(-2), json.dump(-2));
 }
+
+TEST(Sealed, LoadFieldDataAsync) {
+    auto dim = 16;
+    int64_t N = 100 * 1000;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    schema->AddDebugField("double", DataType::DOUBLE);
+    schema->AddDebugField("age", DataType::INT32);
+    auto dataset = DataGen(schema, N);
+
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "double": {
+                        "GE": -1,
+                        "LT": 1
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(5, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 1000000;
+
+    auto ref_segment = CreateSealedSegment(schema);
+    SealedLoader(dataset, *ref_segment);
+    auto ref_result = QueryResultToJson(ref_segment->Search(plan.get(), *ph_group, time));
+
+    LoadScheduler::Instance().Configure(4, 16);
+    std::vector<SegmentSealedPtr> segments;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 8; ++i) {
+        auto& segment = segments.emplace_back(CreateSealedSegment(schema));
+        futures.push_back(segment->LoadFieldDataAsync(LoadFieldDataInfo{0, dataset.row_ids_.data(), N}));
+        futures.push_back(segment->LoadFieldDataAsync(LoadFieldDataInfo{1, dataset.timestamps_.data(), N}));
+        for (int offset = 0; offset < schema->size(); ++offset) {
+            auto field_id = (*schema)[FieldOffset(offset)].get_id().get();
+            futures.push_back(
+                segment->LoadFieldDataAsync(LoadFieldDataInfo{field_id, dataset.cols_[offset].data(), N}));
+        }
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    // loading a field twice fails through its future
+    auto duplicated = segments[0]->LoadFieldDataAsync(LoadFieldDataInfo{counter_id.get(), dataset.cols_[1].data(), N});
+    ASSERT_ANY_THROW(duplicated.get());
+
+    for (auto& segment : segments) {
+        ASSERT_EQ(segment->get_row_count(), N);
+        auto result = QueryResultToJson(segment->Search(plan.get(), *ph_group, time));
+        ASSERT_EQ(result.dump(2), ref_result.dump(2));
+    }
+
+    // a segment destroyed while its loads are queued waits for them
+    auto dropped = CreateSealedSegment(schema);
+    for (int offset = 0; offset < schema->size(); ++offset) {
+        auto field_id = (*schema)[FieldOffset(offset)].get_id().get();
+        dropped->LoadFieldDataAsync(LoadFieldDataInfo{field_id, dataset.cols_[offset].data(), N});
+    }
+    dropped.reset();
+
+    // a load the stopped pool refuses is not left pending, so the segment can still be destroyed
+    LoadScheduler::Instance().Stop();
+    auto refused = CreateSealedSegment(schema);
+    ASSERT_ANY_THROW(refused->LoadFieldDataAsync(LoadFieldDataInfo{0, dataset.row_ids_.data(), N}));
+    refused.reset();
+    LoadScheduler::Instance().Configure(0, 1);
+}
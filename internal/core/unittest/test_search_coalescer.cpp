@@ -0,0 +1,199 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pb/plan.pb.h"
+#include "segcore/SearchCoalescer.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+std::string
+MakeDsl(int topk) {
+    return R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "counter": {
+                        "GE": 0
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": )" +
+           std::to_string(topk) + R"(
+                    }
+                }
+            }
+            ]
+        }
+    })";
+}
+
+// counter >= each of lower_bounds, the plan only runs with a single bound
+std::unique_ptr<Plan>
+MakeRangePlan(const Schema& schema, FieldId vec_id, FieldId counter_id, std::vector<int64_t> lower_bounds) {
+    proto::plan::PlanNode plan_node;
+    auto anns = plan_node.mutable_vector_anns();
+    anns->set_field_id(vec_id.get());
+    anns->set_placeholder_tag("$0");
+    auto query_info = anns->mutable_query_info();
+    query_info->set_topk(5);
+    query_info->set_metric_type("L2");
+    query_info->set_search_params(R"({"nprobe": 10})");
+    auto range = anns->mutable_predicates()->mutable_range_expr();
+    range->mutable_column_info()->set_field_id(counter_id.get());
+    range->mutable_column_info()->set_data_type(proto::schema::DataType::Int64);
+    for (auto bound : lower_bounds) {
+        range->add_ops(proto::plan::RangeExpr::GreaterEqual);
+        range->add_values()->set_int64_val(bound);
+    }
+    auto blob = plan_node.SerializeAsString();
+    return CreatePlanByExpr(schema, blob.data(), blob.size());
+}
+}  // namespace
+
+TEST(SearchCoalescer, Concurrent) {
+    constexpr int64_t dim = 16;
+    constexpr int64_t N = 10000;
+    constexpr int num_requests = 8;
+    constexpr int64_t num_queries = 2;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    auto raw = dataset.get_col<float>(0);
+    Timestamp time = 1000000;
+
+    // every request has a plan of its own, half of them ask for a different topk and can't join the others
+    std::vector<std::unique_ptr<Plan>> plans;
+    std::vector<std::unique_ptr<PlaceholderGroup>> ph_groups;
+    std::vector<QueryResult> expected;
+    for (int i = 0; i < num_requests; ++i) {
+        plans.push_back(CreatePlan(*schema, MakeDsl(i % 2 == 0 ? 5 : 10)));
+        auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, raw.data() + i * num_queries * dim);
+        ph_groups.push_back(ParsePlaceholderGroup(plans[i].get(), ph_group_raw.SerializeAsString()));
+        expected.push_back(segment->Search(plans[i].get(), *ph_groups[i], time));
+    }
+
+    auto& coalescer = SearchCoalescer::Instance();
+    // a long window so that the requests of each kind surely meet
+    coalescer.Configure(20 * 1000, 1024);
+    auto before = coalescer.GetMetrics();
+    std::vector<QueryResult> results(num_requests);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_requests; ++i) {
+        threads.emplace_back([&, i] {
+            // the timestamps differ but see the same rows
+            results[i] = coalescer.Search(*segment, plans[i].get(), *ph_groups[i], time + i);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto after = coalescer.GetMetrics();
+    coalescer.Configure(0, 0);
+
+    ASSERT_EQ(after.requests - before.requests, num_requests);
+    ASSERT_GE(after.batches - before.batches, 2);
+    ASSERT_LT(after.batches - before.batches, num_requests);
+    for (int i = 0; i < num_requests; ++i) {
+        ASSERT_EQ(results[i].num_queries_, num_queries);
+        ASSERT_EQ(results[i].topK_, expected[i].topK_);
+        ASSERT_EQ(results[i].internal_seg_offsets_, expected[i].internal_seg_offsets_);
+        ASSERT_EQ(results[i].result_distances_, expected[i].result_distances_);
+        ASSERT_EQ(results[i].internal_seg_offsets_[0], i * num_queries);
+    }
+}
+
+TEST(SearchCoalescer, Disabled) {
+    constexpr int64_t dim = 16;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, 100);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(100);
+    segment->Insert(0, 100, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto plan = CreatePlan(*schema, MakeDsl(5));
+    auto ph_group_raw = CreatePlaceholderGroup(3, dim);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    auto& coalescer = SearchCoalescer::Instance();
+    coalescer.Configure(0, 0);
+    auto before = coalescer.GetMetrics();
+    auto result = coalescer.Search(*segment, plan.get(), *ph_group, 1000000);
+    auto expected = segment->Search(plan.get(), *ph_group, 1000000);
+    ASSERT_EQ(result.internal_seg_offsets_, expected.internal_seg_offsets_);
+    ASSERT_EQ(coalescer.GetMetrics().batches - before.batches, 1);
+}
+
+TEST(SearchCoalescer, DistinctPlans) {
+    constexpr int64_t dim = 16;
+    constexpr int64_t N = 1000;
+    auto schema = std::make_shared<Schema>();
+    auto vec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    Timestamp time = 1000000;
+
+    // both plans print alike, the printed conditions only keep the last bound of each op
+    auto good_plan = MakeRangePlan(*schema, vec_id, counter_id, {5000});
+    auto bad_plan = MakeRangePlan(*schema, vec_id, counter_id, {0, 5000});
+    auto ph_group_raw = CreatePlaceholderGroup(2, dim);
+    auto good_ph_group = ParsePlaceholderGroup(good_plan.get(), ph_group_raw.SerializeAsString());
+    auto bad_ph_group = ParsePlaceholderGroup(bad_plan.get(), ph_group_raw.SerializeAsString());
+    auto expected = segment->Search(good_plan.get(), *good_ph_group, time);
+    ASSERT_ANY_THROW(segment->Search(bad_plan.get(), *bad_ph_group, time));
+
+    auto& coalescer = SearchCoalescer::Instance();
+    coalescer.Configure(20 * 1000, 1024);
+    auto before = coalescer.GetMetrics();
+    QueryResult good_result;
+    bool bad_failed = false;
+    std::thread good([&] { good_result = coalescer.Search(*segment, good_plan.get(), *good_ph_group, time); });
+    std::thread bad([&] {
+        try {
+            coalescer.Search(*segment, bad_plan.get(), *bad_ph_group, time);
+        } catch (std::exception&) {
+            bad_failed = true;
+        }
+    });
+    good.join();
+    bad.join();
+    auto after = coalescer.GetMetrics();
+    coalescer.Configure(0, 0);
+
+    ASSERT_EQ(after.batches - before.batches, 2);
+    ASSERT_TRUE(bad_failed);
+    ASSERT_EQ(good_result.internal_seg_offsets_, expected.internal_seg_offsets_);
+    ASSERT_EQ(good_result.result_distances_, expected.result_distances_);
+}
@@ -34,3 +34,43 @@ TEST(TimestampIndex, Naive) {
         ASSERT_EQ(guessed_slice[i], lengths[i]);
     }
 }
+
+TEST(TimestampIndex, Mask) {
+    // one undecided slice, rows are out of order inside it
+    int64_t N = 1000;
+    std::vector<Timestamp> timestamps(N);
+    for (int64_t i = 0; i < N; ++i) {
+        timestamps[i] = i < 100 ? i : 100 + (i * 7919) % 900;
+    }
+    TimestampIndex index;
+    index.set_length_meta(GenerateFakeSlices(timestamps.data(), N, 64));
+    index.build_with(timestamps.data(), N);
+
+    TimestampMaskCache cache;
+    for (Timestamp query_ts : {Timestamp(0), Timestamp(150), Timestamp(500), Timestamp(998)}) {
+        auto range = index.get_active_range(query_ts);
+        ASSERT_LT(range.first, range.second);
+        for (int64_t i = 0; i < range.first; ++i) {
+            ASSERT_LE(timestamps[i], query_ts);
+        }
+        for (int64_t i = range.second; i < N; ++i) {
+            ASSERT_GT(timestamps[i], query_ts);
+        }
+
+        Bitmap bitmap(N, true);
+        TimestampIndex::ApplyMask(*cache.Get(query_ts, range, timestamps.data()), bitmap);
+        for (int64_t i = 0; i < range.second; ++i) {
+            ASSERT_EQ(bitmap[i], timestamps[i] <= query_ts) << i;
+        }
+    }
+
+    // a timestamp between the same two rows reuses the mask
+    auto range = index.get_active_range(500);
+    auto mask = cache.Get(500, range, timestamps.data());
+    ASSERT_EQ(mask->lower, 500);
+    ASSERT_EQ(mask->upper, 501);
+    ASSERT_EQ(cache.Get(500, range, timestamps.data()), mask);
+    ASSERT_NE(cache.Get(501, index.get_active_range(501), timestamps.data()), mask);
+    cache.clear();
+    ASSERT_NE(cache.Get(500, range, timestamps.data()), mask);
+}
@@ -0,0 +1,246 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "common/VectorPrecision.h"
+#include "query/BruteForceKernels.h"
+#include "segcore/ConcurrentVector.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "segcore/SegmentSealedImpl.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+std::vector<float>
+GenVectors(int64_t n, int64_t dim, int seed) {
+    std::default_random_engine e(seed);
+    std::normal_distribution<float> dist(0, 1);
+    std::vector<float> data(n * dim);
+    for (auto& x : data) {
+        x = dist(e);
+    }
+    return data;
+}
+
+std::vector<float>
+RoundTrip(VectorPrecision precision, const std::vector<float>& data, int64_t dim) {
+    auto count = data.size() / dim;
+    std::vector<uint8_t> codes(vector_code_sizeof(precision, dim) * count);
+    EncodeVectors(precision, data.data(), count, dim, codes.data());
+    std::vector<float> decoded(data.size());
+    DecodeVectors(precision, codes.data(), count, dim, decoded.data());
+    return decoded;
+}
+
+const std::vector<VectorPrecision> CompactPrecisions = {
+    VectorPrecision::FP16,
+    VectorPrecision::BF16,
+    VectorPrecision::INT8,
+};
+}  // namespace
+
+TEST(VectorPrecision, Codec) {
+    ASSERT_EQ(GetVectorPrecision("FP16"), VectorPrecision::FP16);
+    ASSERT_EQ(VectorPrecisionToName(VectorPrecision::INT8), "int8");
+    ASSERT_ANY_THROW(GetVectorPrecision("fp64"));
+    ASSERT_EQ(vector_code_sizeof(VectorPrecision::FP32, 16), 64);
+    ASSERT_EQ(vector_code_sizeof(VectorPrecision::BF16, 16), 32);
+    ASSERT_EQ(vector_code_sizeof(VectorPrecision::INT8, 16), 20);
+
+    // values exactly representable in fp16, including a denormal and the extremes
+    std::vector<float> exact = {0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, std::ldexp(1.0f, -24), INFINITY, -INFINITY};
+    auto decoded = RoundTrip(VectorPrecision::FP16, exact, exact.size());
+    for (int i = 0; i < exact.size(); ++i) {
+        ASSERT_EQ(decoded[i], exact[i]);
+        ASSERT_EQ(std::signbit(decoded[i]), std::signbit(exact[i]));
+    }
+    // overflow saturates, NaN survives
+    std::vector<float> special = {1e6f, NAN};
+    decoded = RoundTrip(VectorPrecision::FP16, special, special.size());
+    ASSERT_EQ(decoded[0], INFINITY);
+    ASSERT_TRUE(std::isnan(decoded[1]));
+    decoded = RoundTrip(VectorPrecision::BF16, special, special.size());
+    ASSERT_NEAR(decoded[0], 1e6f, 1e6f / 256);
+    ASSERT_TRUE(std::isnan(decoded[1]));
+
+    constexpr int64_t dim = 37;
+    auto data = GenVectors(100, dim, 1);
+    for (auto precision : CompactPrecisions) {
+        decoded = RoundTrip(precision, data, dim);
+        for (int64_t i = 0; i < data.size(); ++i) {
+            auto x = data[i];
+            switch (precision) {
+                case VectorPrecision::FP16:
+                    ASSERT_NEAR(decoded[i], x, std::abs(x) / 2048 + 1e-7);
+                    break;
+                case VectorPrecision::BF16:
+                    ASSERT_NEAR(decoded[i], x, std::abs(x) / 256);
+                    break;
+                default: {
+                    // half a quantization step of the row
+                    auto row = data.begin() + i / dim * dim;
+                    auto max_abs = std::abs(*std::max_element(row, row + dim, [](float a, float b) {
+                        return std::abs(a) < std::abs(b);
+                    }));
+                    ASSERT_NEAR(decoded[i], x, max_abs / 127 / 2 + 1e-6);
+                }
+            }
+        }
+    }
+
+    // an all-zero row has scale 0
+    std::vector<float> zeros(dim, 0);
+    decoded = RoundTrip(VectorPrecision::INT8, zeros, dim);
+    ASSERT_EQ(decoded, zeros);
+}
+
+TEST(VectorPrecision, ConcurrentVector) {
+    constexpr int64_t dim = 6;
+    constexpr int64_t size_per_chunk = 32;
+    constexpr int64_t N = 100;
+    auto data = GenVectors(N, dim, 2);
+    // row-based source with a leading int32 column, so the floats are not aligned to their size
+    constexpr int64_t sizeof_row = sizeof(int32_t) + 1 + sizeof(float) * dim;
+    std::vector<char> rows(sizeof_row * N);
+    std::vector<int64_t> order(N);
+    for (int64_t i = 0; i < N; ++i) {
+        order[i] = N - 1 - i;
+        memcpy(rows.data() + i * sizeof_row + sizeof(int32_t) + 1, data.data() + i * dim, sizeof(float) * dim);
+    }
+
+    for (auto precision : CompactPrecisions) {
+        ConcurrentVector<FloatVector> vec(dim, size_per_chunk, precision);
+        ASSERT_TRUE(vec.is_compact());
+        vec.set_data_raw(0, data.data(), N);
+        vec.set_data_raw_from_rows(N, rows.data() + sizeof(int32_t) + 1, sizeof_row, order.data(), N);
+        ASSERT_EQ(vec.num_chunk(), upper_div(2 * N, size_per_chunk));
+        ASSERT_ANY_THROW(vec.get_span_base(0));
+
+        auto expected = RoundTrip(precision, data, dim);
+        std::vector<float> element(dim);
+        for (int64_t i = 0; i < N; ++i) {
+            vec.copy_element(i, element.data());
+            ASSERT_TRUE(std::equal(element.begin(), element.end(), expected.begin() + i * dim));
+            vec.copy_element(N + i, element.data());
+            ASSERT_TRUE(std::equal(element.begin(), element.end(), expected.begin() + (N - 1 - i) * dim));
+        }
+    }
+}
+
+TEST(VectorPrecision, Knn) {
+    constexpr int64_t dim = 24;
+    constexpr int64_t num_queries = 5;
+    constexpr int64_t N = 1000;
+    constexpr int64_t topk = 10;
+    auto base = GenVectors(N, dim, 3);
+    auto queries = GenVectors(num_queries, dim, 4);
+    faiss::ConcurrentBitset bitset(N);
+    for (int64_t i = 0; i < N; i += 3) {
+        bitset.set(i);
+    }
+    faiss::BitsetView view(bitset);
+
+    // the compact kernels score exactly the decoded rows
+    for (auto precision : CompactPrecisions) {
+        std::vector<uint8_t> codes(vector_code_sizeof(precision, dim) * N);
+        EncodeVectors(precision, base.data(), N, dim, codes.data());
+        auto decoded = RoundTrip(precision, base, dim);
+        for (bool is_ip : {false, true}) {
+            std::vector<float> values(num_queries * topk), ref_values(num_queries * topk);
+            std::vector<int64_t> labels(num_queries * topk), ref_labels(num_queries * topk);
+            if (is_ip) {
+                KnnIPCompact(queries.data(), num_queries, codes.data(), precision, N, dim, topk, view, values.data(),
+                             labels.data());
+                KnnIPBlocked(queries.data(), num_queries, decoded.data(), N, dim, topk, view, ref_values.data(),
+                             ref_labels.data());
+            } else {
+                KnnL2Compact(queries.data(), num_queries, codes.data(), precision, N, dim, topk, view, values.data(),
+                             labels.data());
+                KnnL2Blocked(queries.data(), num_queries, decoded.data(), N, dim, topk, view, ref_values.data(),
+                             ref_labels.data());
+            }
+            ASSERT_EQ(labels, ref_labels);
+            ASSERT_EQ(values, ref_values);
+        }
+    }
+}
+
+TEST(VectorPrecision, Segment) {
+    constexpr int64_t dim = 16;
+    constexpr int64_t N = 2000;
+    constexpr int64_t num_queries = 5;
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5
+                    }
+                }
+            }
+            ]
+        }
+    })";
+
+    for (auto precision : CompactPrecisions) {
+        auto schema = std::make_shared<Schema>();
+        schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, MetricType::METRIC_L2, precision);
+        schema->AddDebugField("counter", DataType::INT64);
+        ASSERT_EQ(schema->get_total_sizeof(), sizeof(float) * dim + sizeof(int64_t));
+        ASSERT_EQ(schema->get_total_storage_sizeof(), vector_code_sizeof(precision, dim) + sizeof(int64_t));
+
+        auto dataset = DataGen(schema, N);
+        auto raw = dataset.get_col<float>(0);
+        auto expected = RoundTrip(precision, raw, dim);
+        auto plan = CreatePlan(*schema, dsl);
+        auto ph_group_raw = CreatePlaceholderGroupFromBlob(num_queries, dim, raw.data());
+        auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        Timestamp time = 1000000;
+
+        auto growing = CreateGrowingSegment(schema);
+        growing->PreInsert(N);
+        growing->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+        auto sealed = CreateSealedSegment(schema);
+        SealedLoader(dataset, *sealed);
+
+        std::vector<SegmentInternalInterface*> segments = {growing.get(), sealed.get()};
+        for (auto segment : segments) {
+            auto qr = segment->Search(plan.get(), *ph_group, time);
+            for (int64_t q = 0; q < num_queries; ++q) {
+                ASSERT_EQ(qr.internal_seg_offsets_[q * 5], q);
+            }
+
+            // rows are read back decoded
+            auto req_ids = std::make_unique<IdArray>();
+            req_ids->mutable_int_id()->add_data(dataset.row_ids_[3]);
+            req_ids->mutable_int_id()->add_data(dataset.row_ids_[N - 1]);
+            auto retrieve_results = segment->GetEntityById({FieldOffset(0)}, *req_ids, MAX_TIMESTAMP);
+            auto& vectors = retrieve_results->fields_data(0).vectors().float_vector();
+            ASSERT_EQ(vectors.data_size(), 2 * dim);
+            for (int64_t d = 0; d < dim; ++d) {
+                ASSERT_EQ(vectors.data(d), expected[3 * dim + d]);
+                ASSERT_EQ(vectors.data(dim + d), expected[(N - 1) * dim + d]);
+            }
+        }
+    }
+}
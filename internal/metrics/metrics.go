@@ -16,6 +16,7 @@ const (
 	subSystemDataCoord = "dataCoord"
 	subSystemDataNode  = "dataNode"
 	subSystemProxy     = "proxy"
+	subSystemQueryNode = "queryNode"
 )
 
 /*
@@ -577,9 +578,20 @@ func RegisterQueryCoord() {
 
 }
 
+var (
+	// QueryNodeSmallIndexLag records the num of filled chunks of a growing segment still waiting for their small index
+	QueryNodeSmallIndexLag = prometheus.NewGaugeVec(
+		prometheus.GaugeOpts{
+			Namespace: milvusNamespace,
+			Subsystem: subSystemQueryNode,
+			Name:      "small_index_lag",
+			Help:      "Chunks of growing segment waiting for small index",
+		}, []string{"segment_id"})
+)
+
 //RegisterQueryNode register QueryNode metrics
 func RegisterQueryNode() {
-
+	prometheus.MustRegister(QueryNodeSmallIndexLag)
 }
 
 var (
@@ -33,6 +33,7 @@ import (
 	"go.uber.org/zap"
 
 	"github.com/milvus-io/milvus/internal/log"
+	"github.com/milvus-io/milvus/internal/metrics"
 	"github.com/milvus-io/milvus/internal/proto/internalpb"
 	"github.com/milvus-io/milvus/internal/proto/schemapb"
 )
@@ -473,6 +474,11 @@ func (colReplica *collectionReplica) getSegmentStatistics() []*internalpb.Segmen
 
 		statisticData = append(statisticData, &stat)
 		segment.setRecentlyModified(false)
+
+		// small indexes finish on segcore's build threads, so the lag drains here even when inserts stop
+		if segment.getType() == segmentTypeGrowing {
+			metrics.QueryNodeSmallIndexLag.WithLabelValues(strconv.FormatInt(segmentID, 10)).Set(float64(segment.getSmallIndexLag()))
+		}
 	}
 
 	return statisticData
@@ -13,12 +13,14 @@ package querynode
 
 import (
 	"context"
+	"strconv"
 	"sync"
 
 	"github.com/opentracing/opentracing-go"
 	"go.uber.org/zap"
 
 	"github.com/milvus-io/milvus/internal/log"
+	"github.com/milvus-io/milvus/internal/metrics"
 	"github.com/milvus-io/milvus/internal/proto/commonpb"
 	"github.com/milvus-io/milvus/internal/util/flowgraph"
 	"github.com/milvus-io/milvus/internal/util/trace"
@@ -168,6 +170,8 @@ func (iNode *insertNode) insert(insertData *InsertData, segmentID int64, wg *syn
 		return
 	}
 
+	metrics.QueryNodeSmallIndexLag.WithLabelValues(strconv.FormatInt(segmentID, 10)).Set(float64(targetSegment.getSmallIndexLag()))
+
 	log.Debug("Do insert done", zap.Int("len", len(insertData.insertIDs[segmentID])),
 		zap.Int64("segmentID", segmentID))
 	wg.Done()
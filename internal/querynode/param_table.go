@@ -14,6 +14,7 @@ package querynode
 import (
 	"fmt"
 	"path"
+	"runtime"
 	"strconv"
 	"strings"
 	"sync"
@@ -60,6 +61,12 @@ type ParamTable struct {
 	retrievePulsarBufSize        int64
 	RetrieveResultReceiveBufSize int64
 
+	// segcore
+	IndexBuildConcurrency   int64
+	IndexBuildQueueCapacity int64
+	LoadConcurrency         int64
+	LoadQueueCapacity       int64
+
 	// stats
 	StatsPublishInterval int
 	StatsChannelName     string
@@ -108,6 +115,11 @@ func (p *ParamTable) Init() {
 		p.initSearchPulsarBufSize()
 		p.initSearchResultReceiveBufSize()
 
+		p.initIndexBuildConcurrency()
+		p.initIndexBuildQueueCapacity()
+		p.initLoadConcurrency()
+		p.initLoadQueueCapacity()
+
 		p.initStatsPublishInterval()
 		p.initStatsChannelName()
 
@@ -213,6 +225,33 @@ func (p *ParamTable) initSearchResultReceiveBufSize() {
 	p.SearchResultReceiveBufSize = p.ParseInt64("queryNode.msgStream.searchResult.recvBufSize")
 }
 
+// segcore
+func (p *ParamTable) initIndexBuildConcurrency() {
+	p.IndexBuildConcurrency = p.ParseInt64("queryNode.segcore.indexBuild.concurrency")
+	if p.IndexBuildConcurrency == 0 {
+		// a quarter of the cores keeps search latency intact
+		p.IndexBuildConcurrency = int64(runtime.NumCPU() / 4)
+		if p.IndexBuildConcurrency < 1 {
+			p.IndexBuildConcurrency = 1
+		}
+	}
+}
+
+func (p *ParamTable) initIndexBuildQueueCapacity() {
+	p.IndexBuildQueueCapacity = p.ParseInt64("queryNode.segcore.indexBuild.queueCapacity")
+}
+
+func (p *ParamTable) initLoadConcurrency() {
+	p.LoadConcurrency = p.ParseInt64("queryNode.segcore.load.concurrency")
+	if p.LoadConcurrency == 0 {
+		p.LoadConcurrency = int64(runtime.NumCPU())
+	}
+}
+
+func (p *ParamTable) initLoadQueueCapacity() {
+	p.LoadQueueCapacity = p.ParseInt64("queryNode.segcore.load.queueCapacity")
+}
+
 func (p *ParamTable) initEtcdEndpoints() {
 	endpoints, err := p.Load("_EtcdEndpoints")
 	if err != nil {
@@ -13,6 +13,7 @@ package querynode
 
 import (
 	"fmt"
+	"runtime"
 	"strings"
 	"testing"
 
@@ -76,6 +77,13 @@ func TestParamTable_searchPulsarBufSize(t *testing.T) {
 	assert.Equal(t, int64(512), bufSize)
 }
 
+func TestParamTable_segcorePools(t *testing.T) {
+	assert.GreaterOrEqual(t, Params.IndexBuildConcurrency, int64(1))
+	assert.Equal(t, int64(64), Params.IndexBuildQueueCapacity)
+	assert.Equal(t, int64(runtime.NumCPU()), Params.LoadConcurrency)
+	assert.Equal(t, int64(1024), Params.LoadQueueCapacity)
+}
+
 func TestParamTable_flowGraphMaxQueueLength(t *testing.T) {
 	length := Params.FlowGraphMaxQueueLength
 	assert.Equal(t, int32(1024), length)
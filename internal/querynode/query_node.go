@@ -146,6 +146,8 @@ func (node *QueryNode) Init() error {
 	node.streaming = newStreaming(node.queryNodeLoopCtx, node.msFactory, node.etcdKV)
 
 	C.SegcoreInit()
+	C.SegcoreSetIndexBuildPool(C.int64_t(Params.IndexBuildConcurrency), C.int64_t(Params.IndexBuildQueueCapacity))
+	C.SegcoreSetLoadPool(C.int64_t(Params.LoadConcurrency), C.int64_t(Params.LoadQueueCapacity))
 
 	if node.rootCoord == nil {
 		log.Error("null root coordinator detected")
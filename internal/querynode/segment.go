@@ -33,6 +33,7 @@ import (
 	"go.uber.org/zap"
 
 	"github.com/milvus-io/milvus/internal/log"
+	"github.com/milvus-io/milvus/internal/metrics"
 	"github.com/milvus-io/milvus/internal/proto/commonpb"
 	"github.com/milvus-io/milvus/internal/proto/segcorepb"
 )
@@ -166,6 +167,10 @@ func deleteSegment(segment *Segment) {
 	C.DeleteSegment(cPtr)
 	segment.segmentPtr = nil
 
+	if segment.segmentType == segmentTypeGrowing {
+		metrics.QueryNodeSmallIndexLag.DeleteLabelValues(strconv.FormatInt(segment.ID(), 10))
+	}
+
 	log.Debug("delete segment", zap.Int64("segmentID", segment.ID()))
 
 	segment = nil
@@ -198,6 +203,19 @@ func (s *Segment) getDeletedCount() int64 {
 	return int64(deletedCount)
 }
 
+// getSmallIndexLag returns the number of filled chunks still waiting for their small index
+func (s *Segment) getSmallIndexLag() int64 {
+	/*
+		long int
+		GetSmallIndexLag(CSegmentInterface c_segment);
+	*/
+	if s.segmentPtr == nil || s.segmentType != segmentTypeGrowing {
+		return -1
+	}
+	var lag = C.GetSmallIndexLag(s.segmentPtr)
+	return int64(lag)
+}
+
 func (s *Segment) getMemSize() int64 {
 	/*
 		long int
@@ -617,6 +635,9 @@ func (s *Segment) segmentLoadFieldData(fieldID int64, rowCount int, data interfa
 		    int64_t field_id;
 		    void* blob;
 		    int64_t row_count;
+		    const char* file_path;
+		    int64_t file_offset;
+		    int32_t access_pattern;
 		} CLoadFieldDataInfo;
 	*/
 	loadInfo := C.CLoadFieldDataInfo{